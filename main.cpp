@@ -1,9 +1,30 @@
 #include "SDL.h"
+#include "src/Audio/AudioBenchmark.h"
 #include "src/Core/Engine.h"
+#include "src/Core/FramePacer.h"
+#include "src/Core/JobBenchmark.h"
+#include "src/Graphics/RasterBenchmark.h"
 
 int main(int argc, char** argv) {
   SDL_Log("Starting Game...");
 
+  EngineConfig config;
+  if (!ParseCommandLine(argc, argv, config)) {
+    SDL_Log("Invalid command line!");
+    return -1;
+  }
+  if (config.benchmark == "raster") {
+    return RunRasterBenchmark(config.benchmarkFrames);
+  } else if (config.benchmark == "jobs") {
+    return RunJobBenchmark(config.benchmarkFrames);
+  } else if (config.benchmark == "audio") {
+    return RunAudioBenchmark(config.audioRenderPath, config.audioFrequency, config.audioBuffer);
+  } else if (!config.benchmark.empty()) {
+    SDL_Log("Unknown benchmark '%s'!", config.benchmark.c_str());
+    return -1;
+  }
+  Engine::GetInstance()->SetConfig(config);
+
   bool initSuccess = Engine::GetInstance()->Init();
   SDL_Log("Init returned: %d", initSuccess);
 
@@ -14,10 +35,12 @@ int main(int argc, char** argv) {
 
   SDL_Log("Entering Main Loop...");
   while (Engine::GetInstance()->IsRunning()) {
-    SDL_Log("Loop iteration...");
     Engine::GetInstance()->Events();
-    Engine::GetInstance()->Update();
+    if (!Engine::GetInstance()->IsSimulationThreaded()) {
+      Engine::GetInstance()->Update();
+    }
     Engine::GetInstance()->Render();
+    FramePacer::GetInstance()->Pace();
   }
   SDL_Log("Exited Main Loop.");
 
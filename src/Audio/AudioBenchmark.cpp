@@ -0,0 +1,209 @@
+#include "AudioBenchmark.h"
+#include <atomic>
+#include "SDL.h"
+#include "AudioManager.h"
+#include "../Core/Engine.h"
+#include "../Core/JobSystem.h"
+
+namespace {
+
+#ifdef _WIN32
+const char* const NULL_DEVICE = "NUL";
+#else
+const char* const NULL_DEVICE = "/dev/null";
+#endif
+
+const double SESSION_SECONDS = 13.0;
+const Uint32 TIMEOUT_MS = 120000; // Pilote "disk" ignorant SDL_DISKAUDIODELAY : au pire le temps réel
+
+// Mêmes appels que les scènes (MenuScene, PlayingScene, EndScene) et les touches de volume
+struct ScriptStep
+{
+    double seconds;
+    const char* name;
+    void (*run)();
+};
+
+const ScriptStep SCRIPT[] = {
+    { 0.0, "menu : musique du menu, volume +", [] {
+        AudioManager::GetInstance()->PlayMusic("menu_music", -1);
+        Engine::GetInstance()->IncreaseVolume();
+    } },
+    { 0.8, "menu : clic", [] { AudioManager::GetInstance()->PlaySound("click"); } },
+    { 0.82, "menu : clic (cooldown)", [] { AudioManager::GetInstance()->PlaySound("click"); } },
+    { 2.0, "course : musique de jeu, moteur", [] {
+        AudioManager::GetInstance()->StopMusic();
+        AudioManager::GetInstance()->PlayMusic("game_music", -1);
+        AudioManager::GetInstance()->StartEngineSound();
+    } },
+    { 3.0, "course : crash", [] { AudioManager::GetInstance()->PlaySound("crash"); } },
+    { 3.05, "course : crash (cooldown)", [] { AudioManager::GetInstance()->PlaySound("crash"); } },
+    { 4.0, "course : crash", [] { AudioManager::GetInstance()->PlaySound("crash"); } },
+    { 4.5, "sourdine", [] { Engine::GetInstance()->ToggleMute(); } },
+    { 5.0, "fin de sourdine", [] { Engine::GetInstance()->ToggleMute(); } },
+    { 5.5, "volume -", [] { Engine::GetInstance()->DecreaseVolume(); } },
+    { 6.0, "compte a rebours : 3", [] { AudioManager::GetInstance()->PlaySound("countdown"); } },
+    { 7.0, "compte a rebours : 2", [] { AudioManager::GetInstance()->PlaySound("countdown"); } },
+    { 8.0, "compte a rebours : 1", [] { AudioManager::GetInstance()->PlaySound("countdown"); } },
+    { 8.5, "victoire : moteur coupe, stinger", [] {
+        AudioManager::GetInstance()->StopEngineSound();
+        AudioManager::GetInstance()->StopMusic();
+        AudioManager::GetInstance()->PlaySound("win");
+    } },
+    { 12.0, "retour au menu", [] {
+        AudioManager::GetInstance()->StopMusic();
+        AudioManager::GetInstance()->PlayMusic("menu_music", -1);
+    } },
+};
+const size_t SCRIPT_STEPS = sizeof(SCRIPT) / sizeof(SCRIPT[0]);
+
+struct Session
+{
+    SDL_RWops* file = nullptr;
+    int frequency = 0;
+    int frameBytes = 0;
+    Uint64 frames = 0;
+    Uint32 hash = 2166136261u; // FNV-1a du mixage
+    size_t nextStep = 0;
+    bool writeFailed = false;
+    Uint64 hookTicks = 0;
+    Uint32 hookCalls = 0;
+    std::atomic<bool> done;
+    SDL_sem* finished = nullptr;
+};
+
+// Course de 2 s à 8,5 s : accélération continue, freinage entre 5,5 et 6,2 s (comme Engine::UpdateRun)
+void UpdateEngineSound(double seconds) {
+    if (seconds < 2.0 || seconds >= 8.5) return;
+    bool braking = seconds >= 5.5 && seconds < 6.2;
+    float rpm = static_cast<float>(0.2 + 0.8 * (seconds - 2.0) / 6.5);
+    if (braking) rpm *= 0.6f;
+    AudioManager::GetInstance()->SetEngineSound(rpm, braking ? 0.0f : 1.0f);
+}
+
+// Thread audio, entre deux tampons : le mixage qui vient d'être produit est écrit, puis le script
+// avance jusqu'à son instant ; ses appels s'entendent dès le tampon suivant.
+void OnBuffer(void* userdata, const Uint8* stream, int length) {
+    Session* session = static_cast<Session*>(userdata);
+    if (session->done.load(std::memory_order_relaxed)) return;
+    Uint64 start = SDL_GetPerformanceCounter();
+
+    if (SDL_RWwrite(session->file, stream, 1, length) != static_cast<size_t>(length)) session->writeFailed = true;
+    for (int i = 0; i < length; ++i) {
+        session->hash = (session->hash ^ stream[i]) * 16777619u;
+    }
+    session->frames += static_cast<Uint64>(length / session->frameBytes);
+    double seconds = static_cast<double>(session->frames) / session->frequency;
+
+    AudioManager* audio = AudioManager::GetInstance();
+    audio->SetOfflineTime(static_cast<Uint32>(seconds * 1000.0));
+    while (session->nextStep < SCRIPT_STEPS && SCRIPT[session->nextStep].seconds <= seconds) {
+        const ScriptStep& step = SCRIPT[session->nextStep++];
+        SDL_Log("AudioBenchmark - %6.2f s : %s", seconds, step.name);
+        step.run();
+    }
+    UpdateEngineSound(seconds);
+    audio->Update(); // Flux des stingers et des musiques (décodés ici, sans worker), sons paresseux
+
+    session->hookTicks += SDL_GetPerformanceCounter() - start;
+    ++session->hookCalls;
+    if (seconds >= SESSION_SECONDS || session->writeFailed) {
+        session->done.store(true, std::memory_order_relaxed);
+        SDL_SemPost(session->finished);
+    }
+}
+
+void WriteWavHeader(SDL_RWops* file, int frequency, Uint16 format, int channels, Uint32 dataBytes) {
+    Uint16 bits = static_cast<Uint16>(SDL_AUDIO_BITSIZE(format));
+    Uint16 blockAlign = static_cast<Uint16>(bits / 8 * channels);
+    SDL_RWseek(file, 0, RW_SEEK_SET);
+    SDL_RWwrite(file, "RIFF", 1, 4);
+    SDL_WriteLE32(file, 36 + dataBytes);
+    SDL_RWwrite(file, "WAVEfmt ", 1, 8);
+    SDL_WriteLE32(file, 16);
+    SDL_WriteLE16(file, SDL_AUDIO_ISFLOAT(format) ? 3 : 1); // IEEE float ou PCM
+    SDL_WriteLE16(file, static_cast<Uint16>(channels));
+    SDL_WriteLE32(file, static_cast<Uint32>(frequency));
+    SDL_WriteLE32(file, static_cast<Uint32>(frequency) * blockAlign);
+    SDL_WriteLE16(file, blockAlign);
+    SDL_WriteLE16(file, bits);
+    SDL_RWwrite(file, "data", 1, 4);
+    SDL_WriteLE32(file, dataBytes);
+}
+
+} // namespace
+
+int RunAudioBenchmark(const std::string& wavPath, int frequency, int bufferSamples) {
+    // Pilote "disk" sans délai entre les tampons ; sa sortie brute est jetée, le WAV est écrit ici.
+    SDL_setenv("SDL_AUDIODRIVER", "disk", 1);
+    SDL_setenv("SDL_DISKAUDIODELAY", "0", 1);
+    SDL_setenv("SDL_DISKAUDIOFILE", NULL_DEVICE, 1);
+    if (SDL_Init(SDL_INIT_AUDIO) != 0) {
+        SDL_Log("RunAudioBenchmark - ECHEC: initialisation SDL: %s", SDL_GetError());
+        return 1;
+    }
+    JobSystem::GetInstance()->Init(0); // Décodage des flux sur le thread audio : rendu reproductible
+    AudioManager* audio = AudioManager::GetInstance();
+    if (!audio->Init(frequency, bufferSamples, false)) {
+        JobSystem::GetInstance()->Clean();
+        SDL_Quit();
+        return 1;
+    }
+    audio->SetOfflineTime(0);
+    Engine::GetInstance()->LoadAudio();
+
+    Session session;
+    session.done = false;
+    session.frequency = audio->GetFrequency();
+    session.frameBytes = (SDL_AUDIO_BITSIZE(audio->GetFormat()) / 8) * audio->GetChannels();
+    session.file = SDL_RWFromFile(wavPath.c_str(), "wb");
+    session.finished = SDL_CreateSemaphore(0);
+    bool success = session.file != nullptr && session.finished != nullptr;
+    if (!success) {
+        SDL_Log("RunAudioBenchmark - ECHEC: '%s' : %s", wavPath.c_str(), SDL_GetError());
+    } else {
+        WriteWavHeader(session.file, session.frequency, audio->GetFormat(), audio->GetChannels(), 0);
+        SDL_Log("RunAudioBenchmark - Session de %.0f s, %d Hz, tampons de %d images, pilote %s.",
+                SESSION_SECONDS, session.frequency, audio->GetBufferSamples(), SDL_GetCurrentAudioDriver());
+
+        Uint64 start = SDL_GetPerformanceCounter();
+        audio->GetMonitor().SetBufferHook(OnBuffer, &session);
+        bool finished = SDL_SemWaitTimeout(session.finished, TIMEOUT_MS) == 0;
+        audio->GetMonitor().Stop(); // Mix_SetPostMix prend le verrou du mixer : attend la fin du tampon en cours
+        audio->GetMonitor().SetBufferHook(nullptr, nullptr);
+        double wallSeconds = (SDL_GetPerformanceCounter() - start) / static_cast<double>(SDL_GetPerformanceFrequency());
+        success = finished && !session.writeFailed;
+
+        Uint32 dataBytes = static_cast<Uint32>(session.frames * session.frameBytes);
+        WriteWavHeader(session.file, session.frequency, audio->GetFormat(), audio->GetChannels(), dataBytes);
+
+        double audioSeconds = static_cast<double>(session.frames) / session.frequency;
+        if (!success) {
+            SDL_Log("RunAudioBenchmark - ECHEC: session interrompue a %.2f s (%s).", audioSeconds,
+                    session.writeFailed ? "ecriture du WAV" : "delai depasse");
+        } else {
+            AudioStats stats = audio->GetMonitor().GetStats();
+            double hookUs = session.hookCalls > 0 ? session.hookTicks * 1e6 / SDL_GetPerformanceFrequency() / session.hookCalls : 0.0;
+            SDL_Log("RunAudioBenchmark - %.2f s d'audio en %.2f s (x%.0f temps reel) -> '%s', empreinte %08X.",
+                    audioSeconds, wallSeconds, wallSeconds > 0.0 ? audioSeconds / wallSeconds : 0.0, wavPath.c_str(), session.hash);
+            // Coût du mixage seul : durée du rappel jusqu'au post-mix, où tournent ensuite le script et l'écriture
+            if (stats.callbackMeanUs >= 0.0 && stats.bufferMs > 0.0) {
+                double mixUs = stats.callbackMeanUs;
+                SDL_Log("RunAudioBenchmark - Mixage : %.2f ms par seconde d'audio (%.1f us par tampon de %d images) ; script et ecriture : %.1f us par tampon.",
+                        mixUs / stats.bufferMs, mixUs, stats.bufferFrames, hookUs);
+            } else {
+                double hookSeconds = session.hookTicks / static_cast<double>(SDL_GetPerformanceFrequency());
+                SDL_Log("RunAudioBenchmark - Mixage : %.2f ms par seconde d'audio (temps ecoule, script et ecriture deduits).",
+                        (wallSeconds - hookSeconds) * 1000.0 / audioSeconds);
+            }
+            audio->LogVoiceReport();
+        }
+    }
+
+    if (session.file != nullptr) SDL_RWclose(session.file);
+    if (session.finished != nullptr) SDL_DestroySemaphore(session.finished);
+    audio->Clean();
+    JobSystem::GetInstance()->Clean();
+    SDL_Quit();
+    return success ? 0 : 1;
+}
@@ -0,0 +1,15 @@
+#ifndef AUDIOBENCHMARK_H
+#define AUDIOBENCHMARK_H
+
+#include <string>
+
+// Rendu audio hors ligne (--bench audio) : une session scriptée (musique du menu, musique de
+// jeu et son moteur, crashs, volume et sourdine, compte à rebours, stinger de victoire, retour
+// au menu) est mixée par SDL_mixer sur le pilote "disk" de SDL, sans attente entre les tampons,
+// donc plus vite que le temps réel et sans carte son. Le script s'exécute entre deux tampons sur
+// le thread audio (crochet d'AudioMonitor) : le résultat ne dépend pas de la vitesse de la machine.
+// Le mixage est écrit en WAV dans wavPath ; le log donne son empreinte (FNV-1a, à comparer entre
+// deux versions) et le coût du mixage par seconde d'audio. Renvoie le code de sortie du programme.
+int RunAudioBenchmark(const std::string& wavPath, int frequency, int bufferSamples);
+
+#endif // AUDIOBENCHMARK_H
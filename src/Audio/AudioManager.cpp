@@ -1,40 +1,125 @@
 #include "AudioManager.h"
+#include <algorithm>
 #include <SDL.h>
+#include "../Core/AssetPack.h"
 
 AudioManager* AudioManager::s_Instance = nullptr;
+const int AudioManager::VOICE_COUNT;
+const int AudioManager::ENGINE_CHANNEL;
+const int AudioManager::MUSIC_CHANNEL;
+const int AudioManager::ENGINE_VOLUME;
+const int AudioManager::ADAPTIVE_MIN_SAMPLES;
+const int AudioManager::ADAPTIVE_MAX_SAMPLES;
+const Uint32 AudioManager::ADAPTIVE_UNDERRUNS;
+const size_t AudioManager::COMMAND_CAPACITY;
+const size_t AudioManager::EVENT_CAPACITY;
+const int AudioManager::MUSIC_STREAMS;
 
-bool AudioManager::Init() {
+bool AudioManager::Init(int frequency, int bufferSamples, bool adaptive) {
     if (Mix_Init(MIX_INIT_OGG | MIX_INIT_MP3) == 0) {
          SDL_Log("Failed to init SDL_mixer: %s", Mix_GetError());
          return false;
     }
 
-    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
-        SDL_Log("Failed to open audio device: %s", Mix_GetError());
+    m_requestedFrequency = frequency;
+    m_adaptive = adaptive;
+    if (!OpenDevice(adaptive ? ADAPTIVE_MIN_SAMPLES : bufferSamples)) {
         Mix_Quit();
         return false;
     }
-    SDL_Log("SDL_mixer initialized successfully!");
+    m_Voices.assign(VOICE_COUNT, Voice());
+    m_events.reserve(EVENT_CAPACITY);
+    SDL_Log("SDL_mixer initialized successfully! (%s, %d Hz, %d samples%s)", SDL_GetCurrentAudioDriver(),
+            m_frequency, m_bufferSamples, adaptive ? ", adaptive" : "");
+    return true;
+}
+
+bool AudioManager::OpenDevice(int bufferSamples) {
+    if (Mix_OpenAudio(m_requestedFrequency, MIX_DEFAULT_FORMAT, 2, bufferSamples) < 0) {
+        SDL_Log("Failed to open audio device: %s", Mix_GetError());
+        return false;
+    }
+    int frequency = 0, channels = 0;
+    Uint16 format = 0;
+    Mix_QuerySpec(&frequency, &format, &channels);
+    // Sons décodés, flux et son moteur sont au format de la première ouverture
+    if (m_frequency != 0 && (frequency != m_frequency || format != m_format || channels != m_channels)) {
+        SDL_Log("Audio device reopened with another format (%d Hz, 0x%04X, %d channels).", frequency, format, channels);
+        Mix_CloseAudio();
+        return false;
+    }
+    m_frequency = frequency;
+    m_format = format;
+    m_channels = channels;
+    m_bufferSamples = bufferSamples;
+    Mix_AllocateChannels(VOICE_COUNT + 2); // + ENGINE_CHANNEL, MUSIC_CHANNEL
+    Mix_Volume(-1, m_allSoundsVolume);
+    Mix_Volume(MUSIC_CHANNEL, m_musicVolume);
+    m_mixerMusicVolume = m_musicVolume;
+    // Sans lecteur (format du mixer non géré), PlayMusic ne fait que loguer
+    if (m_music.IsOpen() || m_music.Open(m_frequency, m_format, m_channels)) {
+        m_music.SetFade(m_musicFadeMs);
+        m_music.Attach(MUSIC_CHANNEL);
+    }
+    m_monitor.Start(m_frequency, m_format, m_channels);
+    if (Mix_RegisterEffect(MIX_CHANNEL_POST, MixerTick, nullptr, this) == 0) {
+        SDL_Log("Failed to hook the audio command queue: %s", Mix_GetError());
+        m_monitor.Stop();
+        Mix_CloseAudio();
+        return false;
+    }
     return true;
 }
 
+bool AudioManager::Reopen(int bufferSamples) {
+    // Au repos (voir ApplyPendingBuffer) : ni voix ni son moteur. Les platines de musique gardent
+    // leur flux et reprennent où elles en étaient, sur le canal rattaché par OpenDevice.
+    Mix_UnregisterEffect(MIX_CHANNEL_POST, MixerTick); // Attend la fin du tampon en cours
+    Mix_HaltChannel(MUSIC_CHANNEL); // Retire l'effet sans toucher aux platines
+    SettleMixer();
+    m_monitor.LogReport();
+    m_monitor.Stop();
+    Mix_CloseAudio();
+
+    int previous = m_bufferSamples;
+    bool changed = OpenDevice(bufferSamples);
+    if (!changed && !OpenDevice(previous)) {
+        SDL_Log("Failed to reopen audio device: %s", Mix_GetError());
+        return false;
+    }
+    // Canaux rouverts en lecture : pauses en cours réappliquées
+    if (m_pausedAll) Mix_Pause(-1);
+    else if (m_musicPaused) Mix_Pause(MUSIC_CHANNEL);
+    if (changed) SDL_Log("Audio buffer changed from %d to %d samples.", previous, bufferSamples);
+    return changed;
+}
+
 void AudioManager::Clean() {
     SDL_Log("Cleaning AudioManager...");
-    
-for (auto const& pair : m_SoundMap) {
-    // pair.first  => id
-    // pair.second => Mix_Chunk*
-    Mix_FreeChunk(pair.second);
+    StopMixer();
+    m_monitor.LogReport();
+    m_monitor.Stop();
+
+for (Sound& sound : m_Sounds) {
+    sound.stream.reset(); // Canal déjà arrêté par StopMixer
+    if (sound.chunk != nullptr) Mix_FreeChunk(sound.chunk);
 }
+m_Sounds.clear();
+m_SoundIds.clear();
+m_Voices.clear();
 
-// Boucle sur les musiques de fond
-for (auto const& pair : m_MusicMap) {
-    // pair.first  => id
-    // pair.second => Mix_Music*
-    Mix_FreeMusic(pair.second);
+// Boucle sur les flux de musique
+for (MusicStream& slot : m_musicStreams) {
+    slot.stream.reset(); // Platines déjà arrêtées par StopMixer
+    slot.track = -1;
+    slot.serial = 0;
 }
 
-    m_MusicMap.clear();
+    m_Musics.clear();
+    m_MusicIds.clear();
+    m_musicTrack = -1;
+    m_musicWaiting = false;
+    m_musicPlaying = false;
     SDL_Log("Music freed.");
 
     Mix_CloseAudio();
@@ -47,96 +132,831 @@ bool AudioManager::LoadMusic(const std::string& id, const std::string& source) {
         SDL_Log("Music '%s' already loaded.", id.c_str());
         return true;
     }
-    Mix_Music* music = Mix_LoadMUS(source.c_str());
-    if (music == nullptr) {
-        SDL_Log("Failed to load music '%s': %s", source.c_str(), Mix_GetError());
+    if (!AssetPack::GetInstance()->Exists(source)) {
+        SDL_Log("Failed to open music '%s': %s", source.c_str(), SDL_GetError());
         return false;
     }
-    m_MusicMap[id] = music;
+    MusicTrack track;
+    track.id = id;
+    track.source = source;
+    m_MusicIds[id] = static_cast<int>(m_Musics.size());
+    m_Musics.push_back(track);
     SDL_Log("Loaded Music: %s as ID: %s", source.c_str(), id.c_str());
     return true;
 }
 
-bool AudioManager::LoadSound(const std::string& id, const std::string& source) {
+bool AudioManager::LoadSound(const std::string& id, const std::string& source, SoundPolicy policy) {
     if (IsSoundLoaded(id)) {
         SDL_Log("Sound '%s' already loaded.", id.c_str());
         return true;
     }
-    Mix_Chunk* sound = Mix_LoadWAV(source.c_str());
-    if (sound == nullptr) {
-        SDL_Log("Failed to load sound '%s': %s", source.c_str(), Mix_GetError());
+    Uint64 start = SDL_GetPerformanceCounter();
+    Sound sound;
+    sound.id = id;
+    sound.source = source;
+    sound.policy = policy;
+    if (policy == SOUND_STREAMED) {
+        std::string error;
+        sound.stream.reset(new SoundStream(source, m_frequency, m_format, m_channels));
+        if (!sound.stream->Open(&error)) {
+            SDL_Log("Sound '%s' cannot be streamed (%s), loaded on first play instead.", source.c_str(), error.c_str());
+            sound.stream.reset();
+            sound.policy = SOUND_LAZY;
+        } else {
+            sound.decodedBytes = sound.stream->GetDecodedBytes();
+            sound.maxInstances = 1; // Un seul flux par son
+        }
+    }
+    if (sound.policy == SOUND_LAZY && !AssetPack::GetInstance()->Exists(source)) {
+        SDL_Log("Failed to open sound '%s': %s", source.c_str(), SDL_GetError());
         return false;
     }
-    m_SoundMap[id] = sound;
-    SDL_Log("Loaded Sound: %s as ID: %s", source.c_str(), id.c_str());
+    if (sound.policy == SOUND_RESIDENT) {
+        sound.chunk = DecodeChunk(source);
+        if (sound.chunk == nullptr) return false;
+        sound.decodedBytes = sound.chunk->alen;
+    }
+    sound.loadMs = (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+    static const char* const POLICY_NAMES[] = { "resident", "lazy", "streamed" };
+    SDL_Log("Loaded Sound: %s as ID: %s (%s)", source.c_str(), id.c_str(), POLICY_NAMES[sound.policy]);
+    m_SoundIds[id] = static_cast<SoundHandle>(m_Sounds.size());
+    m_Sounds.push_back(std::move(sound));
+    TrackPeak();
     return true;
 }
 
+Mix_Chunk* AudioManager::DecodeChunk(const std::string& source) {
+    SDL_RWops* rw = AssetPack::GetInstance()->Open(source);
+    if (rw == nullptr) {
+        SDL_Log("Failed to open sound '%s': %s", source.c_str(), SDL_GetError());
+        return nullptr;
+    }
+    Mix_Chunk* chunk = Mix_LoadWAV_RW(rw, 1);
+    if (chunk == nullptr) {
+        SDL_Log("Failed to load sound '%s': %s", source.c_str(), Mix_GetError());
+    }
+    return chunk;
+}
+
+void AudioManager::Update() {
+    m_events.clear();
+    AudioEvent event;
+    while (m_completions.Pop(event)) OnCompletion(event);
+    FlushBacklog();
+
+    if (m_adaptive && !m_growPending && m_bufferSamples < ADAPTIVE_MAX_SAMPLES &&
+        m_monitor.GetUnderruns() >= ADAPTIVE_UNDERRUNS) {
+        m_growPending = true;
+        SDL_Log("Audio underruns with %d samples: buffer doubled at the next idle point.", m_bufferSamples);
+    }
+    for (SoundHandle handle = 0; handle < static_cast<SoundHandle>(m_Sounds.size()); ++handle) {
+        Sound& sound = m_Sounds[handle];
+        if (!sound.stream) continue;
+        if (sound.streamSerial == 0) {
+            // Arrêté pendant un décodage : fermé une fois le worker libre
+            if (!sound.stream->IsBusy() && sound.stream->IsReady()) sound.stream->Release();
+            continue;
+        }
+        if (sound.streamStarting) {
+            PollStream(handle);
+            continue;
+        }
+        if (sound.streamStopping) continue;
+        if (sound.stream->IsFinished()) {
+            StopVoice(sound.streamChannel); // Fin du son : canal rendu, flux fermé à la notification
+        } else {
+            sound.stream->Update();
+        }
+    }
+    for (MusicStream& slot : m_musicStreams) {
+        if (!slot.stream) continue;
+        if (slot.track < 0) {
+            if (!slot.stream->IsBusy()) slot.stream.reset(); // Fini ou abandonné, sans attendre son worker
+            continue;
+        }
+        slot.stream->Update(); // Anneau à compléter
+    }
+    StartMusic(); // Flux prêt, ou libéré pour une lecture en attente
+}
+
 void AudioManager::PlayMusic(const std::string& id, int loops) {
     if (!IsMusicLoaded(id)) {
         SDL_Log("Cannot play music '%s': Not loaded.", id.c_str());
         return;
     }
-    if (Mix_PlayingMusic()) {
-        Mix_HaltMusic();
+    int index = m_MusicIds[id];
+    if (!m_Musics[index].error.empty()) {
+        SDL_Log("Cannot play music '%s': %s", id.c_str(), m_Musics[index].error.c_str());
+        return;
+    }
+    if (!m_music.IsOpen()) {
+        SDL_Log("Cannot play music '%s': No music channel.", id.c_str());
+        return;
+    }
+    m_musicSerial = NextSerial();
+    m_musicPlaying = true;
+    m_musicTrack = index;
+    m_musicLoops = loops;
+    m_musicWaiting = true;
+    for (MusicStream& slot : m_musicStreams) {
+        if (slot.serial == 0 && slot.track != index) slot.track = -1; // Prefetch devenu inutile
+    }
+    StartMusic(); // Sinon une fois le flux prêt, depuis Update
+}
+
+void AudioManager::PrefetchMusic(const std::string& id) {
+    if (!IsMusicLoaded(id)) {
+        SDL_Log("Cannot prefetch music '%s': Not loaded.", id.c_str());
+        return;
+    }
+    int index = m_MusicIds[id];
+    if (m_Musics[index].error.empty() && FindMusicStream(index) == nullptr) PrepareMusic(index);
+}
+
+void AudioManager::SetMusicFade(Uint32 ms) {
+    m_musicFadeMs = ms;
+    Command command(CMD_MUSIC_FADE);
+    command.value = static_cast<int>(ms);
+    PostCommand(command);
+}
+
+AudioManager::MusicStream* AudioManager::FindMusicStream(int track) {
+    for (MusicStream& slot : m_musicStreams) {
+        if (slot.track == track && slot.serial == 0) return &slot;
+    }
+    return nullptr;
+}
+
+AudioManager::MusicStream* AudioManager::PrepareMusic(int track) {
+    for (MusicStream& slot : m_musicStreams) {
+        if (slot.track >= 0 || slot.stream) continue;
+        // En-têtes et premier bloc décodés sur un worker ; sans fin jusqu'au SetLoops de StartMusic
+        slot.stream.reset(new SoundStream(m_Musics[track].source, m_frequency, m_format, m_channels));
+        slot.stream->PrepareAsync(-1);
+        slot.track = track;
+        slot.serial = 0;
+        return &slot;
     }
-    if (Mix_PlayMusic(m_MusicMap[id], loops) == -1) {
-        SDL_Log("Failed to play music '%s': %s", id.c_str(), Mix_GetError());
+    return nullptr; // Platines pas encore rendues : Update réessaie
+}
+
+void AudioManager::StartMusic() {
+    if (!m_musicWaiting) return;
+    MusicStream* slot = FindMusicStream(m_musicTrack);
+    if (slot == nullptr) slot = PrepareMusic(m_musicTrack);
+    if (slot == nullptr || slot->stream->IsPreparing()) return;
+    m_musicWaiting = false;
+    MusicTrack& track = m_Musics[m_musicTrack];
+    if (!slot->stream->IsReady()) {
+        track.error = slot->stream->GetError();
+        SDL_Log("Failed to stream music '%s': %s", track.source.c_str(), track.error.c_str());
+        slot->track = -1;
+        m_musicPlaying = false; // Illisible
+        AudioEvent event;
+        event.type = AUDIO_MUSIC_FINISHED;
+        event.sound = INVALID_SOUND;
+        event.channel = MUSIC_CHANNEL;
+        event.serial = m_musicSerial;
+        event.track = m_musicTrack;
+        m_events.push_back(event);
+        return;
     }
+    slot->stream->SetLoops(m_musicLoops < 0 ? -1 : std::max(m_musicLoops, 1) - 1);
+    slot->serial = m_musicSerial;
+    track.decodedBytes = slot->stream->GetDecodedBytes();
+    Command play(CMD_PLAY_MUSIC); // Fondu enchaîné depuis la musique en cours
+    play.track = m_musicTrack;
+    play.serial = m_musicSerial;
+    play.target = slot->stream.get();
+    PostCommand(play);
+}
+
+void AudioManager::ConfigureSound(const std::string& id, int priority, int maxInstances, Uint32 cooldownMs) {
+    SoundHandle handle = GetSoundHandle(id);
+    if (handle == INVALID_SOUND) {
+        SDL_Log("Cannot configure sound '%s': Not loaded.", id.c_str());
+        return;
+    }
+    Sound& sound = m_Sounds[handle];
+    sound.priority = priority;
+    sound.cooldownMs = cooldownMs;
+    if (!sound.stream) sound.maxInstances = maxInstances;
+}
+
+SoundHandle AudioManager::GetSoundHandle(const std::string& id) const {
+    auto it = m_SoundIds.find(id);
+    return it != m_SoundIds.end() ? it->second : INVALID_SOUND;
 }
 
 void AudioManager::PlaySound(const std::string& id, int loops) {
-    if (!IsSoundLoaded(id)) {
+    SoundHandle handle = GetSoundHandle(id);
+    if (handle == INVALID_SOUND) {
         SDL_Log("Cannot play sound '%s': Not loaded.", id.c_str());
         return;
     }
-    if (Mix_PlayChannel(-1, m_SoundMap[id], loops) == -1) {
-        SDL_Log("Failed to play sound '%s' on a channel: %s", id.c_str(), Mix_GetError());
+    PlaySound(handle, loops);
+}
+
+void AudioManager::PlaySound(SoundHandle handle, int loops) {
+    if (handle < 0 || handle >= static_cast<SoundHandle>(m_Sounds.size())) return;
+    Sound& sound = m_Sounds[handle];
+    Uint32 now = Now();
+    if (sound.played && now - sound.lastPlayed < sound.cooldownMs) {
+        ++sound.cooldowns;
+        return;
+    }
+    if (!sound.stream && sound.chunk == nullptr) {
+        // SOUND_LAZY : décodé maintenant, libéré par Update une fois joué
+        sound.chunk = DecodeChunk(sound.source);
+        if (sound.chunk == nullptr) return;
+        sound.decodedBytes = sound.chunk->alen;
+        Mix_VolumeChunk(sound.chunk, sound.volume);
+        TrackPeak();
+    }
+    int channel = AcquireVoice(handle);
+    if (channel < 0) {
+        ++sound.starved;
+        ReleaseLazyChunk(sound);
+        return;
+    }
+
+    Uint32 serial = NextSerial();
+    Voice& voice = m_Voices[channel];
+    voice.sound = handle;
+    voice.busy = true;
+    voice.serial = serial;
+    voice.priority = sound.priority;
+    voice.started = now;
+    ++voice.plays;
+    ++sound.active;
+    ++sound.plays;
+    sound.played = true;
+    sound.lastPlayed = now;
+    if (sound.stream) {
+        // Pas de boucle : stingers joués une fois. Flux précédent pas encore arrêté côté mixer :
+        // relancé à sa notification de fin (voir OnCompletion). Voix déjà tenue : un échec de
+        // préparation la rend (voir PollStream).
+        if (sound.streamSerial != 0) {
+            sound.pendingSerial = serial;
+            sound.pendingChannel = channel;
+        } else {
+            StartStream(handle, channel, serial);
+        }
+    } else {
+        Command play(CMD_PLAY_CHUNK);
+        play.channel = channel;
+        play.value = loops;
+        play.sound = handle;
+        play.serial = serial;
+        play.target = sound.chunk;
+        PostCommand(play);
     }
+
+    int busy = 0;
+    for (const Voice& other : m_Voices) busy += other.busy ? 1 : 0;
+    m_peakVoices = std::max(m_peakVoices, busy);
+}
+
+void AudioManager::StartStream(SoundHandle handle, int channel, Uint32 serial) {
+    Sound& sound = m_Sounds[handle];
+    sound.streamSerial = serial;
+    sound.streamChannel = channel;
+    sound.streamStarting = true;
+    sound.streamStopping = false;
+    // Ouverture et premier bloc sur un worker : ni lecture de fichier ni attente ici
+    sound.stream->PrepareAsync(0);
+    PollStream(handle); // Sans worker, déjà prêt
+}
+
+void AudioManager::PollStream(SoundHandle handle) {
+    Sound& sound = m_Sounds[handle];
+    if (!sound.streamStarting || sound.stream->IsPreparing()) return;
+    sound.streamStarting = false;
+    if (!sound.stream->IsReady()) {
+        SDL_Log("Failed to stream sound '%s': %s", sound.source.c_str(), sound.stream->GetError().c_str());
+        Voice& voice = m_Voices[sound.streamChannel];
+        if (voice.busy && voice.serial == sound.streamSerial) voice.busy = false;
+        --sound.active;
+        AudioEvent event;
+        event.type = AUDIO_SOUND_FINISHED;
+        event.sound = handle;
+        event.channel = sound.streamChannel;
+        event.serial = sound.streamSerial;
+        event.track = -1;
+        m_events.push_back(event);
+        sound.streamSerial = 0;
+        return;
+    }
+    Command play(CMD_PLAY_STREAM);
+    play.channel = sound.streamChannel;
+    play.value = sound.volume;
+    play.sound = handle;
+    play.serial = sound.streamSerial;
+    play.target = sound.stream.get();
+    PostCommand(play);
+}
+
+void AudioManager::ReleaseLazyChunk(Sound& sound) {
+    if (sound.policy != SOUND_LAZY || sound.active > 0 || sound.chunk == nullptr) return;
+    Command release(CMD_FREE_CHUNK);
+    release.target = sound.chunk;
+    PostCommand(release);
+    sound.chunk = nullptr; // Redécodé au prochain PlaySound
+}
+
+Uint32 AudioManager::NextSerial() {
+    if (++m_nextSerial == 0) ++m_nextSerial; // 0 : aucune lecture
+    return m_nextSerial;
+}
+
+int AudioManager::AcquireVoice(SoundHandle handle) {
+    const Sound& sound = m_Sounds[handle];
+    int freeVoice = -1, oldestInstance = -1, victim = -1, instances = 0;
+    for (int channel = 0; channel < static_cast<int>(m_Voices.size()); ++channel) {
+        const Voice& voice = m_Voices[channel];
+        if (!voice.busy) {
+            if (freeVoice < 0) freeVoice = channel;
+            continue;
+        }
+        if (voice.sound == handle) {
+            ++instances;
+            if (oldestInstance < 0 || voice.started < m_Voices[oldestInstance].started) oldestInstance = channel;
+        }
+        if (victim < 0 || voice.priority < m_Voices[victim].priority ||
+            (voice.priority == m_Voices[victim].priority && voice.started < m_Voices[victim].started)) {
+            victim = channel;
+        }
+    }
+
+    // Limite d'instances : le son ne s'empile pas, sa plus ancienne lecture repart du début.
+    if (sound.maxInstances > 0 && instances >= sound.maxInstances) {
+        ++m_Sounds[handle].restarts;
+        StopVoice(oldestInstance);
+        return oldestInstance;
+    }
+    if (freeVoice >= 0) return freeVoice;
+    if (victim >= 0 && m_Voices[victim].priority <= sound.priority) {
+        ++m_Voices[victim].steals;
+        StopVoice(victim);
+        return victim;
+    }
+    return -1;
+}
+
+void AudioManager::StopVoice(int channel) {
+    Voice& voice = m_Voices[channel];
+    if (!voice.busy) return;
+    voice.busy = false;
+    Sound& sound = m_Sounds[voice.sound];
+    if (sound.stream && sound.pendingSerial == voice.serial) {
+        // Relance pas encore envoyée au mixer : abandonnée
+        sound.pendingSerial = 0;
+        --sound.active;
+        return;
+    }
+    if (sound.stream && sound.streamStarting && sound.streamSerial == voice.serial) {
+        // Encore en préparation : rien à arrêter côté mixer, le flux est fermé par Update
+        sound.streamStarting = false;
+        sound.streamSerial = 0;
+        --sound.active;
+        return;
+    }
+    if (sound.stream) sound.streamStopping = true; // Fermé à sa notification de fin
+    Command halt(CMD_HALT_CHANNEL);
+    halt.channel = channel;
+    PostCommand(halt);
 }
 
 void AudioManager::StopMusic() {
-    if (Mix_PlayingMusic()) {
-        Mix_HaltMusic();
+    if (m_musicTrack >= 0) {
+        PostCommand(Command(CMD_HALT_MUSIC));
+        MusicStream* waiting = m_musicWaiting ? FindMusicStream(m_musicTrack) : nullptr;
+        if (waiting != nullptr) waiting->track = -1; // Pas encore jouée : flux abandonné
+        m_musicTrack = -1;
+        m_musicWaiting = false;
+        m_musicPlaying = false;
     }
 }
 
-void AudioManager::PauseMusic() {
-    if (Mix_PlayingMusic()) {
-        Mix_PauseMusic();
+bool AudioManager::ApplyPendingBuffer() {
+    if (!m_growPending || m_engineRunning) return false;
+    for (const Voice& voice : m_Voices) {
+        if (voice.busy) return false; // Bruitage ou stinger en cours
+    }
+    int decks = 0;
+    for (const MusicStream& slot : m_musicStreams) {
+        if (slot.serial != 0) ++decks;
     }
+    if (decks > 1) return false; // Fondu enchaîné en cours, ou fin de platine pas encore notifiée
+    m_growPending = false;
+    return Reopen(m_bufferSamples * 2);
+}
+
+void AudioManager::PauseMusic() {
+    m_musicPaused = true;
+    PostCommand(Command(CMD_PAUSE_MUSIC));
 }
 
 void AudioManager::ResumeMusic() {
-    if (Mix_PausedMusic()) {
-        Mix_ResumeMusic();
-    }
+    m_musicPaused = false;
+    PostCommand(Command(CMD_RESUME_MUSIC));
+}
+
+void AudioManager::PauseAll() {
+    m_pausedAll = true;
+    PostCommand(Command(CMD_PAUSE_ALL));
+}
+
+void AudioManager::ResumeAll() {
+    m_pausedAll = false;
+    m_musicPaused = false; // Mix_Resume(-1) reprend aussi la musique
+    PostCommand(Command(CMD_RESUME_ALL));
 }
 
 void AudioManager::SetMusicVolume(int volume) {
     volume = (volume < 0) ? 0 : (volume > MIX_MAX_VOLUME) ? MIX_MAX_VOLUME : volume;
-    Mix_VolumeMusic(volume);
+    m_musicVolume = volume;
+    Command command(CMD_MUSIC_VOLUME);
+    command.value = volume;
+    PostCommand(command);
 }
 
 void AudioManager::SetSoundVolume(const std::string& soundId, int volume) {
-     if (!IsSoundLoaded(soundId)) {
+    SoundHandle handle = GetSoundHandle(soundId);
+    if (handle == INVALID_SOUND) {
         SDL_Log("Cannot set volume for sound '%s': Not loaded.", soundId.c_str());
         return;
     }
     volume = (volume < 0) ? 0 : (volume > MIX_MAX_VOLUME) ? MIX_MAX_VOLUME : volume;
-    Mix_VolumeChunk(m_SoundMap[soundId], volume);
+    Sound& sound = m_Sounds[handle];
+    sound.volume = volume; // Appliqué aussi aux décodages et lectures en flux à venir
+    if (sound.chunk != nullptr) {
+        Command command(CMD_CHUNK_VOLUME);
+        command.value = volume;
+        command.target = sound.chunk;
+        PostCommand(command);
+    }
+    if (sound.stream) {
+        Command command(CMD_STREAM_VOLUME);
+        command.value = volume;
+        command.target = sound.stream.get();
+        PostCommand(command);
+    }
 }
 
 void AudioManager::SetAllSoundsVolume(int volume) {
      volume = (volume < 0) ? 0 : (volume > MIX_MAX_VOLUME) ? MIX_MAX_VOLUME : volume;
-     Mix_Volume(-1, volume);
+     m_allSoundsVolume = volume;
+     Command command(CMD_SOUNDS_VOLUME);
+     command.value = volume;
+     PostCommand(command);
+}
+
+void AudioManager::StartEngineSound() {
+    if (m_engineRunning) return;
+    if (!m_engineSynth.IsOpen() && !m_engineSynth.Open(m_frequency, m_format, m_channels)) return;
+    m_engineRunning = true;
+    PostCommand(Command(CMD_START_ENGINE));
+    SDL_Log("Engine sound started on channel %d (%s kernel).", ENGINE_CHANNEL, m_engineSynth.GetKernelName());
+}
+
+void AudioManager::StopEngineSound() {
+    if (!m_engineRunning) return;
+    m_engineRunning = false;
+    PostCommand(Command(CMD_STOP_ENGINE));
+}
+
+void AudioManager::SetEngineSound(float rpm, float load) {
+    m_engineSynth.SetTarget(rpm, load);
+}
+
+void AudioManager::PostCommand(const Command& command) {
+    ++m_commandsPosted;
+    if (!m_backlog.empty()) FlushBacklog();
+    if (m_backlog.empty() && m_commands.Push(command)) {
+        m_peakPending = std::max(m_peakPending, m_commands.Size());
+        return;
+    }
+    // File pleine (thread audio en retard ou arrêté) : jamais d'attente, l'ordre est conservé
+    ++m_commandsBacklogged;
+    m_backlog.push_back(command);
+}
+
+void AudioManager::FlushBacklog() {
+    size_t sent = 0;
+    while (sent < m_backlog.size() && m_commands.Push(m_backlog[sent])) ++sent;
+    m_backlog.erase(m_backlog.begin(), m_backlog.begin() + sent);
+}
+
+void AudioManager::OnCompletion(const AudioEvent& event) {
+    if (event.type == AUDIO_SOUND_FINISHED) {
+        Voice& voice = m_Voices[event.channel];
+        if (voice.busy && voice.serial == event.serial) voice.busy = false;
+        Sound& sound = m_Sounds[event.sound];
+        --sound.active;
+        if (sound.stream && event.serial == sound.streamSerial) {
+            // Effet retiré du canal : l'anneau peut resservir. Décodage en cours : fermé par Update,
+            // ou à la suite de ce décodage par la relance
+            if (!sound.stream->IsBusy()) sound.stream->Release();
+            sound.streamSerial = 0;
+            sound.streamStopping = false;
+            if (sound.pendingSerial != 0) {
+                Uint32 serial = sound.pendingSerial;
+                sound.pendingSerial = 0;
+                StartStream(event.sound, sound.pendingChannel, serial);
+            }
+        }
+        ReleaseLazyChunk(sound);
+    } else if (event.type != AUDIO_MUSIC_LOOPED) {
+        for (MusicStream& slot : m_musicStreams) {
+            if (slot.serial != event.serial) continue;
+            slot.track = -1; // Platine rendue : flux fermé par Update
+            slot.serial = 0;
+        }
+        if (event.type == AUDIO_MUSIC_FINISHED && event.serial == m_musicSerial) m_musicPlaying = false;
+    }
+    m_events.push_back(event);
+}
+
+void AudioManager::MixerTick(int /*channel*/, void* /*stream*/, int /*length*/, void* userdata) {
+    static_cast<AudioManager*>(userdata)->ApplyCommands();
+}
+
+void AudioManager::ApplyCommands() {
+    // Deux notifications au plus par commande (voir Apply) : sans place, la suite attend le tampon
+    // suivant. Fins de musique notifiées avant chaque commande : MusicPlayer::Play a une platine libre.
+    PollMusic();
+    Command command;
+    while (EVENT_CAPACITY - m_completions.Size() >= 2 && m_commands.Pop(command)) {
+        Apply(command);
+        PollMusic();
+    }
+    PollMixer();
+}
+
+void AudioManager::Apply(const Command& command) {
+    switch (command.type) {
+    case CMD_PLAY_CHUNK:
+    case CMD_PLAY_STREAM: {
+        FinishChannel(command.channel); // Lecture précédente remplacée
+        bool started;
+        if (command.type == CMD_PLAY_STREAM) {
+            started = static_cast<SoundStream*>(command.target)->Attach(command.channel, command.value);
+        } else {
+            started = Mix_PlayChannel(command.channel, static_cast<Mix_Chunk*>(command.target), command.value) != -1;
+            if (!started) SDL_Log("Failed to play sound %d on channel %d: %s", command.sound, command.channel, Mix_GetError());
+        }
+        m_mixerChannels[command.channel].serial = command.serial;
+        m_mixerChannels[command.channel].sound = command.sound;
+        if (!started) FinishChannel(command.channel);
+        break;
+    }
+    case CMD_HALT_CHANNEL:
+        Mix_HaltChannel(command.channel);
+        FinishChannel(command.channel);
+        break;
+    case CMD_CHUNK_VOLUME:
+        Mix_VolumeChunk(static_cast<Mix_Chunk*>(command.target), command.value);
+        break;
+    case CMD_STREAM_VOLUME:
+        static_cast<SoundStream*>(command.target)->SetVolume(command.value);
+        break;
+    case CMD_SOUNDS_VOLUME:
+        Mix_Volume(-1, command.value);
+        Mix_Volume(MUSIC_CHANNEL, m_mixerMusicVolume);
+        break;
+    case CMD_FREE_CHUNK:
+        Mix_FreeChunk(static_cast<Mix_Chunk*>(command.target)); // Arrête les canaux qui le jouent encore
+        break;
+    case CMD_PLAY_MUSIC:
+        m_music.Play(static_cast<SoundStream*>(command.target), command.track, command.serial);
+        break;
+    case CMD_HALT_MUSIC:
+        m_music.FadeOut();
+        break;
+    case CMD_PAUSE_MUSIC:
+        Mix_Pause(MUSIC_CHANNEL); // Canal en pause : effet suspendu, fondus compris
+        break;
+    case CMD_RESUME_MUSIC:
+        Mix_Resume(MUSIC_CHANNEL);
+        break;
+    case CMD_MUSIC_VOLUME:
+        m_mixerMusicVolume = command.value;
+        Mix_Volume(MUSIC_CHANNEL, command.value);
+        break;
+    case CMD_MUSIC_FADE:
+        m_music.SetFade(static_cast<Uint32>(command.value));
+        break;
+    case CMD_PAUSE_ALL:
+        Mix_Pause(-1);
+        break;
+    case CMD_RESUME_ALL:
+        Mix_Resume(-1);
+        break;
+    case CMD_START_ENGINE:
+        m_engineSynth.Start(ENGINE_CHANNEL, ENGINE_VOLUME);
+        break;
+    case CMD_STOP_ENGINE:
+        m_engineSynth.Stop();
+        break;
+    }
+}
+
+void AudioManager::PollMixer() {
+    for (int channel = 0; channel < VOICE_COUNT; ++channel) {
+        if (m_mixerChannels[channel].serial == 0 || Mix_Playing(channel)) continue;
+        if (m_completions.Size() >= EVENT_CAPACITY) return; // Notifiée au tampon suivant
+        FinishChannel(channel);
+    }
+}
+
+void AudioManager::PollMusic() {
+    int track = -1;
+    Uint32 serial = 0;
+    while (m_completions.Size() < EVENT_CAPACITY) {
+        MusicPlayer::Change change = m_music.TakeChange(&track, &serial);
+        if (change == MusicPlayer::CHANGE_NONE) return;
+        AudioEventType type = change == MusicPlayer::CHANGE_LOOPED ? AUDIO_MUSIC_LOOPED
+                            : change == MusicPlayer::CHANGE_FINISHED ? AUDIO_MUSIC_FINISHED : AUDIO_MUSIC_FADED;
+        PostEvent(type, INVALID_SOUND, MUSIC_CHANNEL, serial, track);
+    }
+}
+
+void AudioManager::FinishChannel(int channel) {
+    MixerChannel& state = m_mixerChannels[channel];
+    if (state.serial == 0) return;
+    PostEvent(AUDIO_SOUND_FINISHED, state.sound, channel, state.serial);
+    state.serial = 0;
 }
 
+void AudioManager::PostEvent(AudioEventType type, SoundHandle sound, int channel, Uint32 serial, int track) {
+    AudioEvent event;
+    event.type = type;
+    event.sound = sound;
+    event.channel = channel;
+    event.serial = serial;
+    event.track = track;
+    if (!m_completions.Push(event)) m_eventsLost.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AudioManager::StopMixer() {
+    Mix_UnregisterEffect(MIX_CHANNEL_POST, MixerTick); // Attend la fin du tampon en cours
+    Mix_HaltChannel(MUSIC_CHANNEL); // Retire l'effet : le lecteur de musique passe au thread de jeu
+    for (Sound& sound : m_Sounds) {
+        if (sound.pendingSerial != 0) StopVoice(sound.pendingChannel); // Relance abandonnée
+        if (sound.streamStarting) StopVoice(sound.streamChannel);  // Préparation abandonnée
+    }
+    SettleMixer();
+    m_engineSynth.Stop();
+    m_engineRunning = false;
+    Mix_HaltChannel(-1);
+    m_music.Stop();
+    SettleMixer(); // Fins de lecture notifiées : voix rendues, flux fermés, sons et musiques libérés
+}
+
+void AudioManager::SettleMixer() {
+    AudioEvent event;
+    do {
+        FlushBacklog();
+        ApplyCommands();
+        while (m_completions.Pop(event)) OnCompletion(event);
+    } while (m_commands.Size() > 0 || !m_backlog.empty());
+}
+
+std::vector<std::string> AudioManager::GetSoundIds(const std::string& source) const {
+    std::vector<std::string> ids;
+    for (const Sound& sound : m_Sounds) {
+        if (sound.policy == SOUND_RESIDENT && sound.source == source) ids.push_back(sound.id);
+    }
+    return ids;
+}
+
+bool AudioManager::DecodeSound(const std::string& source, Uint8** samples, Uint32* length, std::string* error) const {
+    // SDL_GetError est propre à chaque thread : le message est recopié pour l'appelant.
+    SDL_RWops* rw = AssetPack::GetInstance()->Open(source);
+    if (rw == nullptr) {
+        *error = SDL_GetError();
+        return false;
+    }
+    SDL_AudioSpec spec;
+    Uint8* wav = nullptr;
+    Uint32 wavLength = 0;
+    if (SDL_LoadWAV_RW(rw, 1, &spec, &wav, &wavLength) == nullptr) {
+        *error = SDL_GetError();
+        return false;
+    }
+    SDL_AudioCVT cvt;
+    int conversion = SDL_BuildAudioCVT(&cvt, spec.format, spec.channels, spec.freq, m_format, m_channels, m_frequency);
+    if (conversion < 0) {
+        *error = SDL_GetError();
+        SDL_FreeWAV(wav);
+        return false;
+    }
+    cvt.len = static_cast<int>(wavLength);
+    cvt.buf = static_cast<Uint8*>(SDL_malloc(wavLength * cvt.len_mult));
+    if (cvt.buf == nullptr) {
+        *error = "memoire insuffisante";
+        SDL_FreeWAV(wav);
+        return false;
+    }
+    SDL_memcpy(cvt.buf, wav, wavLength);
+    SDL_FreeWAV(wav);
+    if (conversion == 1 && SDL_ConvertAudio(&cvt) < 0) {
+        *error = SDL_GetError();
+        SDL_free(cvt.buf);
+        return false;
+    }
+    *samples = cvt.buf;
+    *length = conversion == 1 ? static_cast<Uint32>(cvt.len_cvt) : wavLength;
+    return true;
+}
+
+bool AudioManager::ReplaceSound(const std::string& id, Uint8* samples, Uint32 length) {
+    SoundHandle handle = GetSoundHandle(id);
+    if (handle == INVALID_SOUND) {
+        SDL_Log("Cannot replace sound '%s': Not loaded.", id.c_str());
+        SDL_free(samples);
+        return false;
+    }
+    Mix_Chunk* sound = Mix_QuickLoad_RAW(samples, length);
+    if (sound == nullptr) {
+        SDL_Log("Failed to replace sound '%s': %s", id.c_str(), Mix_GetError());
+        SDL_free(samples);
+        return false;
+    }
+    sound->allocated = 1; // Échantillons libérés par Mix_FreeChunk, comme avec Mix_LoadWAV_RW
+    Sound& entry = m_Sounds[handle];
+    Mix_VolumeChunk(sound, entry.volume);
+    if (entry.chunk != nullptr) {
+        Command release(CMD_FREE_CHUNK); // Arrête les canaux qui le jouent encore
+        release.target = entry.chunk;
+        PostCommand(release);
+    }
+    entry.chunk = sound;
+    entry.decodedBytes = length;
+    SDL_Log("Reloaded Sound: %s as ID: %s", entry.source.c_str(), id.c_str());
+    return true;
+}
+
+size_t AudioManager::GetSoundMemoryBytes() const {
+    size_t bytes = 0;
+    for (const Sound& sound : m_Sounds) {
+        if (sound.chunk != nullptr) bytes += sound.chunk->alen;
+        if (sound.stream) bytes += sound.stream->GetMemoryBytes();
+    }
+    return bytes;
+}
+
+void AudioManager::TrackPeak() {
+    m_peakSoundBytes = std::max(m_peakSoundBytes, GetSoundMemoryBytes());
+}
+
+void AudioManager::LogMemoryReport() const {
+    static const char* const POLICY_NAMES[] = { "resident", "lazy", "streamed" };
+    size_t decodedTotal = 0;
+    double loadTotal = 0.0;
+    SDL_Log("AudioManager - Memoire des sons :");
+    for (const Sound& sound : m_Sounds) {
+        size_t bytes = (sound.chunk != nullptr ? sound.chunk->alen : 0) + (sound.stream ? sound.stream->GetMemoryBytes() : 0);
+        SDL_Log("  %-10s %-8s %7.1f Ko en memoire, %7.1f Ko decode, charge en %.2f ms", sound.id.c_str(),
+                POLICY_NAMES[sound.policy], bytes / 1024.0, sound.decodedBytes / 1024.0, sound.loadMs);
+        decodedTotal += sound.decodedBytes;
+        loadTotal += sound.loadMs;
+    }
+    SDL_Log("  Total : %.1f Ko (pic %.1f Ko) au lieu de %.1f Ko tout resident, chargement %.2f ms.",
+            GetSoundMemoryBytes() / 1024.0, m_peakSoundBytes / 1024.0, decodedTotal / 1024.0, loadTotal);
+    for (int index = 0; index < static_cast<int>(m_Musics.size()); ++index) {
+        const MusicTrack& track = m_Musics[index];
+        if (track.decodedBytes == 0) continue; // Jamais jouée
+        size_t bytes = 0;
+        for (const MusicStream& slot : m_musicStreams) {
+            if (slot.track == index && slot.stream) bytes += slot.stream->GetMemoryBytes();
+        }
+        SDL_Log("  %-10s %-8s %7.1f Ko en memoire, %7.1f Ko decode (flux)", track.id.c_str(), "music",
+                bytes / 1024.0, track.decodedBytes / 1024.0);
+    }
+}
+
+void AudioManager::LogVoiceReport() const {
+    SDL_Log("AudioManager - Voix (%d, %d au plus en meme temps) :", static_cast<int>(m_Voices.size()), m_peakVoices);
+    for (size_t channel = 0; channel < m_Voices.size(); ++channel) {
+        const Voice& voice = m_Voices[channel];
+        if (voice.plays == 0) continue;
+        SDL_Log("  canal %2zu : %u lecture(s), %u volee(s)", channel, voice.plays, voice.steals);
+    }
+    for (const Sound& sound : m_Sounds) {
+        SDL_Log("  %-10s priorite %d : %u lecture(s), %u relance(s), %u refus (cooldown), %u sans voix",
+                sound.id.c_str(), sound.priority, sound.plays, sound.restarts, sound.cooldowns, sound.starved);
+    }
+    SDL_Log("  commandes : %u envoyee(s), %zu au plus en file, %u differee(s) (file pleine), %u notification(s) perdue(s)",
+            m_commandsPosted, m_peakPending, m_commandsBacklogged, m_eventsLost.load(std::memory_order_relaxed));
+    m_engineSynth.LogReport();
+}
 
 bool AudioManager::IsMusicLoaded(const std::string& id) {
-    return m_MusicMap.find(id) != m_MusicMap.end() && m_MusicMap[id] != nullptr;
+    return m_MusicIds.find(id) != m_MusicIds.end();
 }
 
 bool AudioManager::IsSoundLoaded(const std::string& id) {
-     return m_SoundMap.find(id) != m_SoundMap.end() && m_SoundMap[id] != nullptr;
+     return m_SoundIds.find(id) != m_SoundIds.end();
 }
@@ -1,42 +1,327 @@
 #ifndef AUDIOMANAGER_H
 #define AUDIOMANAGER_H
 
+#include <atomic>
 #include <string>
 #include <map>
+#include <memory>
+#include <vector>
 #include <SDL_mixer.h>
+#include "../Core/JobSystem.h"
+#include "../Core/SpscQueue.h"
+#include "AudioMonitor.h"
+#include "EngineSynth.h"
+#include "MusicPlayer.h"
+#include "SoundStream.h"
 
+// Politique mémoire d'un son (voir LoadSound et LogMemoryReport)
+enum SoundPolicy {
+    SOUND_RESIDENT, // Décodé au chargement et gardé : sons courts et fréquents
+    SOUND_LAZY,     // Décodé au premier PlaySound, libéré dès la fin de la lecture
+    SOUND_STREAMED  // Lu par tranches depuis le fichier pendant la lecture (voir SoundStream)
+};
+
+// Identifiant entier d'un son chargé (voir GetSoundHandle) : PlaySound sans recherche par nom
+typedef int SoundHandle;
+const SoundHandle INVALID_SOUND = -1;
+
+// Notifications du thread audio, reçues par AudioManager::Update (voir GetEvents)
+enum AudioEventType {
+    AUDIO_SOUND_FINISHED, // Lecture terminée, arrêtée, volée ou refusée par le mixer
+    AUDIO_MUSIC_FINISHED, // Musique au bout de ses boucles, ou illisible (pas après StopMusic)
+    AUDIO_MUSIC_LOOPED,   // Musique revenue au début pour une nouvelle boucle
+    AUDIO_MUSIC_FADED     // Musique éteinte après StopMusic ou un autre PlayMusic (fin du fondu)
+};
+
+struct AudioEvent
+{
+    AudioEventType type;
+    SoundHandle sound; // AUDIO_SOUND_FINISHED
+    int channel;
+    Uint32 serial;     // Lecture ou musique concernée
+    int track;         // Événements de musique : piste (ordre des LoadMusic)
+};
+
+// Le thread de jeu (celui qui appelle PlaySound, PlayMusic, les volumes...) n'appelle plus
+// SDL_mixer, qui verrouille le périphérique audio et peut attendre la fin d'un rappel : chaque
+// appel devient une commande dans une file SPSC sans verrou, appliquée par le thread audio entre
+// deux tampons (effet sur MIX_CHANNEL_POST). Fins de lecture, fin et boucle de musique reviennent
+// par une seconde file, traitée par Update. L'état des voix est tenu côté jeu, sans interroger le
+// mixer. Font exception les opérations sur le périphérique lui-même (Init, Clean, LoadSound,
+// ApplyPendingBuffer), qui l'arrêtent.
 class AudioManager {
 public:
     static AudioManager* GetInstance() {
         return s_Instance = (s_Instance != nullptr) ? s_Instance : new AudioManager();
     }
 
-    bool Init();
+    // bufferSamples : images par tampon du périphérique (puissance de deux). adaptive : démarre à
+    // ADAPTIVE_MIN_SAMPLES et double le tampon (jusqu'à ADAPTIVE_MAX_SAMPLES) après
+    // ADAPTIVE_UNDERRUNS sous-alimentations ; le périphérique est rouvert au prochain point sûr
+    // (voir ApplyPendingBuffer).
+    bool Init(int frequency = 44100, int bufferSamples = 2048, bool adaptive = false);
     void Clean();
 
+    // Ne fait que vérifier le fichier : la piste est lue en flux (SoundStream, un anneau par
+    // platine de MusicPlayer), ouverte sur un worker au premier PlayMusic ou dès PrefetchMusic et
+    // fermée quand elle a fini de jouer.
     bool LoadMusic(const std::string& id, const std::string& source);
-    bool LoadSound(const std::string& id, const std::string& source);
+    // SOUND_LAZY et SOUND_STREAMED ne font que vérifier le fichier ; un son illisible en flux
+    // (ni WAV PCM ni OGG) est chargé en SOUND_LAZY.
+    bool LoadSound(const std::string& id, const std::string& source, SoundPolicy policy = SOUND_RESIDENT);
+    // Chaque image, depuis le thread qui joue les sons : notifications du thread audio, flux à
+    // alimenter, sons paresseux à libérer
+    void Update();
+    // Notifications reçues par le dernier Update
+    inline const std::vector<AudioEvent>& GetEvents() const { return m_events; }
 
+    // Fondu enchaîné depuis la musique en cours (voir SetMusicFade et MusicPlayer) ; si le début
+    // de la piste n'est pas encore décodé, elle démarre ensuite, sans bloquer le thread appelant.
     void PlayMusic(const std::string& id, int loops = -1);
+    // Ouvre la piste et décode son début d'avance, gardés jusqu'au prochain PlayMusic (changement de scène)
+    void PrefetchMusic(const std::string& id);
+    void SetMusicFade(Uint32 ms);
+    // Vu du thread de jeu : vrai depuis PlayMusic jusqu'à StopMusic ou AUDIO_MUSIC_FINISHED
+    inline bool IsMusicPlaying() const { return m_musicPlaying; }
+
+    // Sons joués sur un groupe de VOICE_COUNT voix gérées : au plus maxInstances lectures
+    // simultanées d'un même son (la plus ancienne est relancée), pas deux départs à moins de
+    // cooldownMs, et, toutes les voix occupées, la voix de plus basse priorité (la plus ancienne
+    // à égalité) est volée si elle ne dépasse pas celle du nouveau son. À appeler après LoadSound.
+    void ConfigureSound(const std::string& id, int priority, int maxInstances = 0, Uint32 cooldownMs = 0);
+    SoundHandle GetSoundHandle(const std::string& id) const;
+    void PlaySound(SoundHandle sound, int loops = 0);
     void PlaySound(const std::string& id, int loops = 0);
 
-    void StopMusic();
+    void StopMusic(); // En fondu
     void PauseMusic();
     void ResumeMusic();
+    // Suspension du jeu : met en pause / reprend tous les canaux et la musique
+    void PauseAll();
+    void ResumeAll();
+    // Mode adaptatif, point sûr choisi par l'appelant (menu au repos, jeu suspendu) : rouvre le
+    // périphérique avec le tampon doublé en attente, seulement si aucune voix ne joue, sans son
+    // moteur ni fondu enchaîné. La musique reprend où elle en était, pauses comprises. Bloque
+    // le temps de fermer et rouvrir le périphérique ; vrai si le tampon a changé.
+    bool ApplyPendingBuffer();
 
     void SetMusicVolume(int volume);
     void SetSoundVolume(const std::string& soundId, int volume);
     void SetAllSoundsVolume(int volume);
 
+    // Son moteur synthétisé (voir EngineSynth) sur le canal ENGINE_CHANNEL, hors du groupe de
+    // voix : jamais volé. SetEngineSound chaque image de course, sans verrou.
+    void StartEngineSound();
+    void StopEngineSound();
+    void SetEngineSound(float rpm, float load);
+
+    // Mémoire occupée par les sons (et ce qu'occuperaient les sons non résidents une fois décodés),
+    // temps de chargement au démarrage ; flux de musique à part
+    size_t GetSoundMemoryBytes() const;
+    void LogMemoryReport() const;
+    // Sous-alimentations, durée du rappel audio et latence estimée (voir AudioMonitor)
+    inline const AudioMonitor& GetMonitor() const { return m_monitor; }
+    inline int GetBufferSamples() const { return m_bufferSamples; }
+    inline int GetFrequency() const { return m_frequency; }
+    inline Uint16 GetFormat() const { return m_format; }
+    inline int GetChannels() const { return m_channels; }
+    inline AudioMonitor& GetMonitor() { return m_monitor; }
+    // Rendu hors ligne (voir AudioBenchmark) : cooldowns et âge des voix comptés en temps audio
+    // rendu au lieu de SDL_GetTicks, pour un résultat indépendant de la vitesse du rendu
+    inline void SetOfflineTime(Uint32 ms) { m_offlineClock = true; m_offlineMs = ms; }
+    // Lectures et vols par voix, lectures, relances, refus (cooldown) et famines par son,
+    // files de commandes, coût du son moteur
+    void LogVoiceReport() const;
+
+    static const int VOICE_COUNT = 16;
+    static const int ENGINE_CHANNEL = VOICE_COUNT; // Canaux alloués en plus des voix
+    static const int MUSIC_CHANNEL = VOICE_COUNT + 1;
+    static const int ENGINE_VOLUME = MIX_MAX_VOLUME / 2;
+    static const int ADAPTIVE_MIN_SAMPLES = 256;
+    static const int ADAPTIVE_MAX_SAMPLES = 4096;
+    static const Uint32 ADAPTIVE_UNDERRUNS = 3;
+    static const size_t COMMAND_CAPACITY = 256;
+    static const size_t EVENT_CAPACITY = 256;
+
+    // Rechargement à chaud (voir AssetWatcher), sons SOUND_RESIDENT seulement : les autres sont
+    // relus depuis le fichier à chaque lecture. DecodeSound lit un WAV et le convertit au format
+    // du mixer sans appeler SDL_mixer : appelable depuis un worker. Les échantillons sont alloués
+    // avec SDL_malloc.
+    std::vector<std::string> GetSoundIds(const std::string& source) const;
+    bool DecodeSound(const std::string& source, Uint8** samples, Uint32* length, std::string* error) const;
+    // Remplace le son 'id' (volume conservé, canaux qui le jouent arrêtés) ; reprend samples
+    bool ReplaceSound(const std::string& id, Uint8* samples, Uint32 length);
+
 private:
-    AudioManager() {}
+    AudioManager() : m_eventsLost(0) {}
     static AudioManager* s_Instance;
 
-    std::map<std::string, Mix_Music*> m_MusicMap;
-    std::map<std::string, Mix_Chunk*> m_SoundMap;
+    struct MusicTrack
+    {
+        std::string id;
+        std::string source;
+        std::string error;       // Illisible en flux : PlayMusic ne fait que loguer
+        size_t decodedBytes = 0; // Taille de la piste entière décodée (LogMemoryReport), connue après sa lecture
+    };
+    std::vector<MusicTrack> m_Musics;
+    std::map<std::string, int> m_MusicIds;
+    // Flux de musique : un par platine de MusicPlayer, plus un préparé d'avance (PrefetchMusic).
+    // Libre quand track vaut -1 ; le flux est détruit par Update, une fois sa préparation finie.
+    struct MusicStream
+    {
+        std::unique_ptr<SoundStream> stream;
+        int track = -1;
+        Uint32 serial = 0; // Lecture envoyée au mixer, 0 tant que le flux n'est pas joué
+    };
+    static const int MUSIC_STREAMS = MusicPlayer::DECKS + 1;
+    MusicStream m_musicStreams[MUSIC_STREAMS];
+    struct Sound
+    {
+        std::string id;
+        std::string source;
+        SoundPolicy policy = SOUND_RESIDENT;
+        Mix_Chunk* chunk = nullptr;           // Résident, ou paresseux pendant sa lecture
+        std::unique_ptr<SoundStream> stream;  // SOUND_STREAMED
+        int volume = MIX_MAX_VOLUME;
+        size_t decodedBytes = 0;              // Taille décodée (connue après un premier décodage)
+        double loadMs = 0.0;                  // Temps passé dans LoadSound
+
+        int active = 0;                       // Lectures envoyées au mixer, pas encore terminées
+        // SOUND_STREAMED : lecture en cours (0 sinon), et relance en attente de son arrêt
+        Uint32 streamSerial = 0;
+        int streamChannel = -1;
+        bool streamStarting = false;          // Préparée sur un worker, pas encore envoyée au mixer
+        bool streamStopping = false;
+        Uint32 pendingSerial = 0;
+        int pendingChannel = -1;
+
+        int priority = 0;
+        int maxInstances = 0;                 // 0 : sans limite
+        Uint32 cooldownMs = 0;
+        Uint32 lastPlayed = 0;                // SDL_GetTicks du dernier départ
+        bool played = false;
+
+        // Statistiques (LogVoiceReport)
+        Uint32 plays = 0;
+        Uint32 restarts = 0;  // maxInstances atteint : plus ancienne lecture relancée
+        Uint32 cooldowns = 0; // Refusé, trop tôt après le précédent
+        Uint32 starved = 0;   // Refusé, toutes les voix jouent un son plus prioritaire
+    };
+    // Une voix = un canal SDL_mixer, attribué par AcquireVoice. Vue du thread de jeu : occupée
+    // dès l'envoi de la lecture, libérée à son arrêt ou à sa notification de fin.
+    struct Voice
+    {
+        SoundHandle sound = INVALID_SOUND; // Dernier son lancé sur ce canal
+        bool busy = false;
+        Uint32 serial = 0;                 // Lecture en cours
+        int priority = 0;
+        Uint32 started = 0;
+        Uint32 plays = 0;
+        Uint32 steals = 0; // Coupée pour un son plus prioritaire
+    };
+    std::vector<Sound> m_Sounds;                  // Indexé par SoundHandle
+    std::map<std::string, SoundHandle> m_SoundIds;
+    std::vector<Voice> m_Voices;
+    int m_peakVoices = 0;
+
+    enum CommandType {
+        CMD_PLAY_CHUNK, CMD_PLAY_STREAM, CMD_HALT_CHANNEL, CMD_CHUNK_VOLUME, CMD_STREAM_VOLUME,
+        CMD_SOUNDS_VOLUME, CMD_FREE_CHUNK, CMD_PLAY_MUSIC, CMD_HALT_MUSIC, CMD_PAUSE_MUSIC,
+        CMD_RESUME_MUSIC, CMD_MUSIC_VOLUME, CMD_PAUSE_ALL, CMD_RESUME_ALL, CMD_START_ENGINE,
+        CMD_STOP_ENGINE, CMD_MUSIC_FADE
+    };
+    struct Command
+    {
+        explicit Command(CommandType commandType = CMD_HALT_CHANNEL) : type(commandType) {}
+        CommandType type;
+        int channel = -1;
+        int value = 0;                     // Boucles ou volume
+        SoundHandle sound = INVALID_SOUND;
+        int track = -1;                    // Musique
+        Uint32 serial = 0;                 // Lecture ou musique
+        void* target = nullptr;            // Mix_Chunk ou SoundStream (son en flux ou musique)
+    };
+    // Thread de jeu -> thread audio ; file pleine : gardées dans l'ordre par m_backlog
+    SpscQueue<Command, COMMAND_CAPACITY> m_commands;
+    SpscQueue<AudioEvent, EVENT_CAPACITY> m_completions; // Thread audio -> thread de jeu
+    std::vector<Command> m_backlog;
+    std::vector<AudioEvent> m_events;
+    Uint32 m_nextSerial = 0;
+    Uint32 m_musicSerial = 0;
+    bool m_musicPlaying = false;
+    int m_musicTrack = -1;        // Piste du dernier PlayMusic, -1 après StopMusic
+    bool m_musicWaiting = false;  // Lecture de m_musicTrack en attente de son flux
+    int m_musicLoops = -1;
+    bool m_engineRunning = false;
+    Uint32 m_commandsPosted = 0;
+    Uint32 m_commandsBacklogged = 0;
+    size_t m_peakPending = 0;
+
+    // Côté mixer : thread audio, ou thread de jeu une fois MixerTick retiré (StopMixer)
+    struct MixerChannel
+    {
+        Uint32 serial = 0; // Lecture dont la fin reste à notifier
+        SoundHandle sound = INVALID_SOUND;
+    };
+    MixerChannel m_mixerChannels[VOICE_COUNT];
+    int m_mixerMusicVolume = MIX_MAX_VOLUME;
+    std::atomic<Uint32> m_eventsLost;
+    EngineSynth m_engineSynth;
+    MusicPlayer m_music;
+    AudioMonitor m_monitor;
+
+    // Périphérique (voir Init) ; volumes réappliqués à sa réouverture
+    int m_requestedFrequency = 44100;
+    int m_bufferSamples = 2048;
+    bool m_adaptive = false;
+    bool m_growPending = false; // Sous-alimentations : tampon doublé au prochain ApplyPendingBuffer
+    bool m_pausedAll = false;   // PauseAll / PauseMusic en cours, réappliqués par Reopen
+    bool m_musicPaused = false;
+    int m_musicVolume = MIX_MAX_VOLUME;
+    Uint32 m_musicFadeMs = 1000;
+    int m_allSoundsVolume = MIX_MAX_VOLUME;
+    bool m_offlineClock = false;
+    Uint32 m_offlineMs = 0;
+    size_t m_peakSoundBytes = 0;
+
+    // Format de sortie du mixer, lu après Mix_OpenAudio
+    int m_frequency = 0;
+    Uint16 m_format = 0;
+    int m_channels = 0;
 
     bool IsMusicLoaded(const std::string& id);
     bool IsSoundLoaded(const std::string& id);
+    Mix_Chunk* DecodeChunk(const std::string& source);
+    int AcquireVoice(SoundHandle sound); // Canal libre, libéré ou volé ; -1 si refusé
+    void StopVoice(int channel);
+    void StartStream(SoundHandle sound, int channel, Uint32 serial); // Préparation sur un worker
+    void PollStream(SoundHandle sound); // Préparation finie : envoyée au mixer, ou abandonnée
+    void ReleaseLazyChunk(Sound& sound); // Son paresseux sans lecture en cours : libéré côté mixer
+    Uint32 NextSerial();
+    MusicStream* FindMusicStream(int track); // Flux préparé pour track, pas encore joué
+    MusicStream* PrepareMusic(int track);    // nullptr sans flux libre
+    void StartMusic();                       // Lecture de m_musicTrack, son flux prêt
+
+    // Thread de jeu
+    void PostCommand(const Command& command);
+    void FlushBacklog();
+    void OnCompletion(const AudioEvent& event);
+    // Côté mixer
+    static void MixerTick(int channel, void* stream, int length, void* userdata); // Effet MIX_CHANNEL_POST
+    void ApplyCommands();
+    void Apply(const Command& command);
+    void PollMixer();
+    void PollMusic();
+    void FinishChannel(int channel);
+    void PostEvent(AudioEventType type, SoundHandle sound, int channel, Uint32 serial, int track = -1);
+    // Périphérique à fermer : retire MixerTick, applique les commandes en attente et coupe tout
+    // depuis le thread de jeu
+    void StopMixer();
+    void SettleMixer();
+    void TrackPeak();
+    inline Uint32 Now() const { return m_offlineClock ? m_offlineMs : SDL_GetTicks(); }
+    bool OpenDevice(int bufferSamples);
+    bool Reopen(int bufferSamples);
 };
 
 #endif // AUDIOMANAGER_H
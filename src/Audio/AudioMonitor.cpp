@@ -0,0 +1,107 @@
+#include "AudioMonitor.h"
+#include <cstdio>
+#include <SDL_mixer.h>
+
+const float AudioMonitor::LATE_FACTOR = 1.5f;
+const int AudioMonitor::DEVICE_BUFFERS;
+const Uint32 AudioMonitor::WARMUP_CALLBACKS;
+
+AudioMonitor::AudioMonitor()
+    : m_callbacks(0), m_underruns(0), m_bufferFrames(0), m_maxGapTicks(0),
+      m_mixSamples(0), m_mixTotalTicks(0), m_mixMaxTicks(0), m_hook(nullptr)
+{
+}
+
+void AudioMonitor::Start(int frequency, Uint16 format, int channels) {
+    Stop();
+    m_frequency = frequency;
+    m_frameBytes = (SDL_AUDIO_BITSIZE(format) / 8) * channels;
+    m_lastCounter = 0;
+    m_mixStart = 0;
+    m_callbacks.store(0, std::memory_order_relaxed);
+    m_underruns.store(0, std::memory_order_relaxed);
+    m_bufferFrames.store(0, std::memory_order_relaxed);
+    m_maxGapTicks.store(0, std::memory_order_relaxed);
+    m_mixSamples.store(0, std::memory_order_relaxed);
+    m_mixTotalTicks.store(0, std::memory_order_relaxed);
+    m_mixMaxTicks.store(0, std::memory_order_relaxed);
+    Mix_HookMusic(MixStart, this);
+    Mix_SetPostMix(PostMix, this);
+}
+
+void AudioMonitor::Stop() {
+    Mix_SetPostMix(nullptr, nullptr);
+    Mix_HookMusic(nullptr, nullptr);
+}
+
+void AudioMonitor::SetBufferHook(BufferHook hook, void* userdata) {
+    if (hook != nullptr) m_hookData = userdata; // Visible du thread audio avec le crochet (release)
+    m_hook.store(hook, std::memory_order_release);
+}
+
+void AudioMonitor::MixStart(void* userdata, Uint8* /*stream*/, int /*length*/) {
+    // Avant les canaux : le tampon reste le silence posé par SDL_mixer
+    static_cast<AudioMonitor*>(userdata)->m_mixStart = SDL_GetPerformanceCounter();
+}
+
+void AudioMonitor::PostMix(void* userdata, Uint8* stream, int length) {
+    AudioMonitor* self = static_cast<AudioMonitor*>(userdata);
+    Uint64 now = SDL_GetPerformanceCounter();
+    int frames = length / self->m_frameBytes;
+    self->m_bufferFrames.store(frames, std::memory_order_relaxed);
+    Uint32 callback = self->m_callbacks.fetch_add(1, std::memory_order_relaxed) + 1;
+
+    if (callback > WARMUP_CALLBACKS && self->m_lastCounter != 0) {
+        Uint64 gap = now - self->m_lastCounter;
+        double bufferTicks = static_cast<double>(frames) / self->m_frequency * SDL_GetPerformanceFrequency();
+        if (static_cast<double>(gap) > bufferTicks * LATE_FACTOR) self->m_underruns.fetch_add(1, std::memory_order_relaxed);
+        if (gap > self->m_maxGapTicks.load(std::memory_order_relaxed)) self->m_maxGapTicks.store(gap, std::memory_order_relaxed);
+
+        if (self->m_mixStart != 0 && self->m_mixStart <= now) {
+            Uint64 spent = now - self->m_mixStart;
+            self->m_mixTotalTicks.fetch_add(spent, std::memory_order_relaxed);
+            self->m_mixSamples.fetch_add(1, std::memory_order_relaxed);
+            if (spent > self->m_mixMaxTicks.load(std::memory_order_relaxed)) self->m_mixMaxTicks.store(spent, std::memory_order_relaxed);
+        }
+    }
+    self->m_lastCounter = now;
+
+    BufferHook hook = self->m_hook.load(std::memory_order_acquire);
+    if (hook != nullptr) hook(self->m_hookData, stream, length);
+}
+
+AudioStats AudioMonitor::GetStats() const {
+    AudioStats stats;
+    stats.callbacks = m_callbacks.load(std::memory_order_relaxed);
+    stats.underruns = m_underruns.load(std::memory_order_relaxed);
+    stats.bufferFrames = m_bufferFrames.load(std::memory_order_relaxed);
+    stats.bufferMs = m_frequency > 0 ? stats.bufferFrames * 1000.0 / m_frequency : 0.0;
+    const double tickUs = 1e6 / SDL_GetPerformanceFrequency();
+    Uint32 mixSamples = m_mixSamples.load(std::memory_order_relaxed);
+    stats.callbackMeanUs = mixSamples > 0 ? m_mixTotalTicks.load(std::memory_order_relaxed) * tickUs / mixSamples : -1.0;
+    stats.callbackMaxUs = mixSamples > 0 ? m_mixMaxTicks.load(std::memory_order_relaxed) * tickUs : -1.0;
+    stats.maxGapMs = m_maxGapTicks.load(std::memory_order_relaxed) * 1000.0 / SDL_GetPerformanceFrequency();
+    stats.latencyMs = stats.bufferMs * DEVICE_BUFFERS + (stats.callbackMeanUs > 0.0 ? stats.callbackMeanUs / 1000.0 : 0.0);
+    return stats;
+}
+
+std::string AudioMonitor::Describe() const {
+    AudioStats stats = GetStats();
+    char text[128];
+    std::snprintf(text, sizeof(text), "audio %d@%d ~%.0fms, %u sous-alim.", stats.bufferFrames, m_frequency, stats.latencyMs, stats.underruns);
+    return text;
+}
+
+void AudioMonitor::LogReport() const {
+    AudioStats stats = GetStats();
+    if (stats.callbacks == 0) {
+        SDL_Log("AudioMonitor - Aucun tampon audio rendu.");
+        return;
+    }
+    SDL_Log("AudioMonitor - %u tampon(s) de %d images a %d Hz (%.1f ms), latence estimee %.1f ms, %u sous-alimentation(s), ecart max %.1f ms.",
+            stats.callbacks, stats.bufferFrames, m_frequency, stats.bufferMs, stats.latencyMs, stats.underruns, stats.maxGapMs);
+    if (stats.callbackMeanUs >= 0.0) {
+        SDL_Log("AudioMonitor - Rappel audio : %.1f us en moyenne, %.1f us au pire (%.2f%% du tampon).",
+                stats.callbackMeanUs, stats.callbackMaxUs, stats.callbackMeanUs / 10.0 / stats.bufferMs);
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef AUDIOMONITOR_H
+#define AUDIOMONITOR_H
+
+#include <atomic>
+#include <string>
+#include <SDL.h>
+
+struct AudioStats
+{
+    Uint32 callbacks;
+    Uint32 underruns;      // Tampons rendus en retard (voir AudioMonitor::LATE_FACTOR)
+    int bufferFrames;      // Taille réelle d'un tampon, vue par le mixer
+    double bufferMs;
+    double callbackMeanUs; // Durée du mixage par tampon (canaux, effets, commandes), -1 avant la mesure
+    double callbackMaxUs;
+    double maxGapMs;       // Plus grand écart entre deux tampons
+    double latencyMs;      // Estimation de la latence de sortie
+};
+
+// Instrumentation du périphérique audio, posée sur le crochet de musique de SDL_mixer (début de
+// chaque rappel audio, avant les canaux, voir Mix_HookMusic) et sur son post-mix (fin du
+// rappel, voir Mix_SetPostMix) :
+// - sous-alimentations : un tampon rendu plus de LATE_FACTOR durées de tampon après le
+//   précédent arrive trop tard, la file du périphérique s'est vidée (craquement) ;
+// - durée du rappel : temps écoulé entre ces deux crochets (SDL_GetPerformanceCounter, toutes
+//   plateformes), le reste du temps le thread attend le périphérique. La musique passe par
+//   MusicPlayer sur un canal : Mix_PlayMusic, dont le crochet prend la place, n'est pas utilisé ;
+// - latence estimée : DEVICE_BUFFERS tampons en file plus la durée moyenne du rappel.
+// Fonctionne aussi avec les pilotes "dummy" et "disk" de SDL (SDL_AUDIODRIVER).
+// Start/Stop : sous le verrou de SDL_mixer (Mix_HookMusic, Mix_SetPostMix) ; lectures sans verrou.
+class AudioMonitor
+{
+public:
+    AudioMonitor();
+
+    void Start(int frequency, Uint16 format, int channels); // Remet les compteurs à zéro
+    void Stop();
+
+    AudioStats GetStats() const;
+    inline Uint32 GetUnderruns() const { return m_underruns.load(std::memory_order_relaxed); }
+    std::string Describe() const; // Résumé court pour l'overlay de debug
+    void LogReport() const;
+
+    static const float LATE_FACTOR;
+    static const int DEVICE_BUFFERS = 2; // Tampons en file côté SDL / système
+    static const Uint32 WARMUP_CALLBACKS = 8; // Premiers rappels irréguliers à l'ouverture : ignorés
+
+    // Appelé à la fin de chaque tampon, sur le thread audio, avec le mixage final (rendu hors
+    // ligne, voir AudioBenchmark). nullptr pour retirer.
+    typedef void (*BufferHook)(void* userdata, const Uint8* stream, int length);
+    void SetBufferHook(BufferHook hook, void* userdata);
+
+private:
+    static void MixStart(void* userdata, Uint8* stream, int length); // Thread audio
+    static void PostMix(void* userdata, Uint8* stream, int length);
+
+    int m_frequency = 0;
+    int m_frameBytes = 0;
+
+    // Thread audio seulement
+    Uint64 m_lastCounter = 0;
+    Uint64 m_mixStart = 0; // Début du rappel en cours, 0 avant le premier
+
+    std::atomic<Uint32> m_callbacks;
+    std::atomic<Uint32> m_underruns;
+    std::atomic<int> m_bufferFrames;
+    std::atomic<Uint64> m_maxGapTicks;
+    std::atomic<Uint32> m_mixSamples;
+    std::atomic<Uint64> m_mixTotalTicks;
+    std::atomic<Uint64> m_mixMaxTicks;
+
+    std::atomic<BufferHook> m_hook;
+    void* m_hookData = nullptr;
+};
+
+#endif // AUDIOMONITOR_H
@@ -0,0 +1,292 @@
+#include "EngineSynth.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ENGINESYNTH_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+const int EngineSynth::HARMONICS;
+const int EngineSynth::BLOCK_FRAMES;
+const float EngineSynth::IDLE_HZ = 38.0f;
+const float EngineSynth::MAX_HZ = 170.0f;
+const float EngineSynth::CPU_BUDGET = 0.02f;
+
+static_assert(std::atomic<float>::is_always_lock_free, "EngineSynth: std::atomic<float> doit etre sans verrou");
+
+namespace {
+
+const int CARRIER_BYTES = 16384;       // Une boucle de silence couvre au moins un tampon du périphérique
+const float RPM_TIME_CONSTANT = 0.12f; // Secondes : inertie du moteur
+const float LOAD_TIME_CONSTANT = 0.04f;
+const float OUTPUT_GAIN = 0.2f;        // Somme des harmoniques à pleine charge < 1 après ce gain
+const double TWO_PI = 6.283185307179586;
+
+// Poids des harmoniques : sourd en frein moteur, riche à pleine accélération
+const float LOW_LOAD_WEIGHTS[EngineSynth::HARMONICS] = { 1.0f, 0.30f, 0.12f, 0.06f, 0.03f, 0.02f, 0.01f, 0.005f };
+const float HIGH_LOAD_WEIGHTS[EngineSynth::HARMONICS] = { 1.0f, 0.65f, 0.55f, 0.40f, 0.32f, 0.22f, 0.16f, 0.10f };
+
+inline Uint32 XorShift(Uint32 x) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+}
+
+// Voies indépendantes comme dans le noyau SSE2, pour des résultats identiques.
+void KernelScalar(const EngineSynth::Block& block, float* out, int count, Uint32* noiseState) {
+    float c[4], s[4];
+    for (int lane = 0; lane < 4; ++lane) {
+        c[lane] = block.cos[lane];
+        s[lane] = block.sin[lane];
+    }
+    for (int i = 0; i < count; i += 4) {
+        for (int lane = 0; lane < 4; ++lane) {
+            // sin((h+1)x) = 2cos(x)sin(hx) - sin((h-1)x)
+            float twoCos = c[lane] + c[lane];
+            float previous = 0.0f, current = s[lane];
+            float sum = block.weights[0] * current;
+            for (int h = 1; h < EngineSynth::HARMONICS; ++h) {
+                float next = twoCos * current - previous;
+                sum += block.weights[h] * next;
+                previous = current;
+                current = next;
+            }
+            noiseState[lane] = XorShift(noiseState[lane]);
+            float noise = static_cast<float>(static_cast<Sint32>(noiseState[lane])) * (1.0f / 2147483648.0f);
+            float envelope = 0.5f + 0.5f * c[lane]; // Explosion au passage de la phase à 0
+            float gain = block.gain + block.gainStep * static_cast<float>(i + lane);
+            out[i + lane] = gain * (sum + block.noise * noise * envelope * envelope);
+
+            float rotated = c[lane] * block.rotateCos - s[lane] * block.rotateSin;
+            s[lane] = s[lane] * block.rotateCos + c[lane] * block.rotateSin;
+            c[lane] = rotated;
+        }
+    }
+}
+
+#ifdef ENGINESYNTH_X86_KERNELS
+// 4 échantillons consécutifs par itération, un par voie.
+__attribute__((target("sse2")))
+void KernelSSE2(const EngineSynth::Block& block, float* out, int count, Uint32* noiseState) {
+    __m128 c = _mm_load_ps(block.cos);
+    __m128 s = _mm_load_ps(block.sin);
+    const __m128 rotateCos = _mm_set1_ps(block.rotateCos);
+    const __m128 rotateSin = _mm_set1_ps(block.rotateSin);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 noiseLevel = _mm_set1_ps(block.noise * (1.0f / 2147483648.0f));
+    __m128 weights[EngineSynth::HARMONICS];
+    for (int h = 0; h < EngineSynth::HARMONICS; ++h) weights[h] = _mm_set1_ps(block.weights[h]);
+    __m128 gain = _mm_setr_ps(block.gain, block.gain + block.gainStep,
+                              block.gain + 2.0f * block.gainStep, block.gain + 3.0f * block.gainStep);
+    const __m128 gainStep = _mm_set1_ps(4.0f * block.gainStep);
+    __m128i state = _mm_load_si128(reinterpret_cast<const __m128i*>(noiseState));
+
+    for (int i = 0; i < count; i += 4) {
+        __m128 twoCos = _mm_add_ps(c, c);
+        __m128 previous = _mm_setzero_ps(), current = s;
+        __m128 sum = _mm_mul_ps(weights[0], current);
+        for (int h = 1; h < EngineSynth::HARMONICS; ++h) {
+            __m128 next = _mm_sub_ps(_mm_mul_ps(twoCos, current), previous);
+            sum = _mm_add_ps(sum, _mm_mul_ps(weights[h], next));
+            previous = current;
+            current = next;
+        }
+        state = _mm_xor_si128(state, _mm_slli_epi32(state, 13));
+        state = _mm_xor_si128(state, _mm_srli_epi32(state, 17));
+        state = _mm_xor_si128(state, _mm_slli_epi32(state, 5));
+        __m128 envelope = _mm_add_ps(half, _mm_mul_ps(half, c));
+        __m128 noise = _mm_mul_ps(_mm_mul_ps(_mm_cvtepi32_ps(state), noiseLevel), _mm_mul_ps(envelope, envelope));
+        _mm_storeu_ps(out + i, _mm_mul_ps(gain, _mm_add_ps(sum, noise)));
+
+        __m128 rotated = _mm_sub_ps(_mm_mul_ps(c, rotateCos), _mm_mul_ps(s, rotateSin));
+        s = _mm_add_ps(_mm_mul_ps(s, rotateCos), _mm_mul_ps(c, rotateSin));
+        c = rotated;
+        gain = _mm_add_ps(gain, gainStep);
+    }
+    _mm_store_si128(reinterpret_cast<__m128i*>(noiseState), state);
+}
+#endif
+
+} // namespace
+
+EngineSynth::EngineSynth()
+    : m_kernel(KernelScalar), m_targetRpm(0.0f), m_targetLoad(0.0f),
+      m_buffers(0), m_overBudget(0), m_totalTicks(0), m_maxTicks(0), m_renderedFrames(0)
+{
+#ifdef ENGINESYNTH_X86_KERNELS
+    if (SDL_HasSSE2()) {
+        m_kernel = KernelSSE2;
+        m_simd = true;
+    }
+#endif
+    for (int lane = 0; lane < 4; ++lane) m_noiseState[lane] = 0x9E3779B9u * static_cast<Uint32>(lane + 1);
+}
+
+EngineSynth::~EngineSynth() {
+    Stop();
+    if (m_carrier != nullptr) Mix_FreeChunk(m_carrier);
+}
+
+bool EngineSynth::Open(int frequency, Uint16 format, int channels) {
+    if (format != AUDIO_S16SYS && format != AUDIO_F32SYS) {
+        SDL_Log("EngineSynth::Open - ECHEC: format du mixer 0x%04X non gere (S16 ou F32).", format);
+        return false;
+    }
+    m_frequency = frequency;
+    m_format = format;
+    m_channels = channels;
+    m_frameBytes = (SDL_AUDIO_BITSIZE(format) / 8) * channels;
+
+    // Lissage exponentiel appliqué une fois par bloc
+    float blockSeconds = static_cast<float>(BLOCK_FRAMES) / static_cast<float>(frequency);
+    m_rpmSmoothing = 1.0f - std::exp(-blockSeconds / RPM_TIME_CONSTANT);
+    m_loadSmoothing = 1.0f - std::exp(-blockSeconds / LOAD_TIME_CONSTANT);
+
+    if (m_carrier == nullptr) {
+        m_carrierSamples.assign(CARRIER_BYTES, 0);
+        m_carrier = Mix_QuickLoad_RAW(m_carrierSamples.data(), static_cast<Uint32>(m_carrierSamples.size()));
+    }
+    if (m_carrier == nullptr) {
+        SDL_Log("EngineSynth::Open - ECHEC: bloc de silence : %s", Mix_GetError());
+        return false;
+    }
+    return true;
+}
+
+bool EngineSynth::Start(int channel, int volume) {
+    Stop();
+    if (!IsOpen()) return false;
+    m_rpm = m_targetRpm.load(std::memory_order_relaxed);
+    m_load = 0.0f;
+    m_gain = 0.0f; // Montée progressive depuis le silence
+    m_phase = 0.0;
+
+    Mix_VolumeChunk(m_carrier, volume);
+    m_channel = Mix_PlayChannel(channel, m_carrier, -1);
+    if (m_channel < 0) {
+        SDL_Log("EngineSynth::Start - ECHEC: canal %d : %s", channel, Mix_GetError());
+        return false;
+    }
+    if (Mix_RegisterEffect(m_channel, Effect, EffectDone, this) == 0) {
+        SDL_Log("EngineSynth::Start - ECHEC: effet sur le canal %d : %s", m_channel, Mix_GetError());
+        Stop();
+        return false;
+    }
+    return true;
+}
+
+void EngineSynth::Stop() {
+    if (m_channel >= 0) {
+        Mix_HaltChannel(m_channel); // Retire l'effet, sous le verrou du périphérique audio
+        m_channel = -1;
+    }
+}
+
+void EngineSynth::SetVolume(int volume) {
+    if (m_carrier != nullptr) Mix_VolumeChunk(m_carrier, volume);
+}
+
+void EngineSynth::SetTarget(float rpm, float load) {
+    m_targetRpm.store(std::max(0.0f, std::min(rpm, 1.0f)), std::memory_order_relaxed);
+    m_targetLoad.store(std::max(0.0f, std::min(load, 1.0f)), std::memory_order_relaxed);
+}
+
+const char* EngineSynth::GetKernelName() const {
+    return m_simd ? "SSE2" : "scalaire";
+}
+
+void EngineSynth::Effect(int /*channel*/, void* stream, int length, void* userdata) {
+    EngineSynth* self = static_cast<EngineSynth*>(userdata);
+    Uint64 start = SDL_GetPerformanceCounter();
+    int frames = length / self->m_frameBytes;
+    self->Render(static_cast<Uint8*>(stream), frames);
+    Uint64 ticks = SDL_GetPerformanceCounter() - start;
+
+    // Budget : une fraction de la durée que ce tampon représente
+    double budget = static_cast<double>(frames) / self->m_frequency * CPU_BUDGET * SDL_GetPerformanceFrequency();
+    self->m_buffers.fetch_add(1, std::memory_order_relaxed);
+    if (static_cast<double>(ticks) > budget) self->m_overBudget.fetch_add(1, std::memory_order_relaxed);
+    self->m_totalTicks.fetch_add(ticks, std::memory_order_relaxed);
+    self->m_renderedFrames.fetch_add(static_cast<Uint64>(frames), std::memory_order_relaxed);
+    if (ticks > self->m_maxTicks.load(std::memory_order_relaxed)) self->m_maxTicks.store(ticks, std::memory_order_relaxed);
+}
+
+void EngineSynth::EffectDone(int /*channel*/, void* /*userdata*/) {
+    // Canal arrêté par Stop : rien à libérer, tout appartient à l'objet
+}
+
+void EngineSynth::Render(Uint8* out, int frames) {
+    while (frames > 0) {
+        int count = std::min(frames, BLOCK_FRAMES);
+        RenderBlock(count);
+        WriteBlock(out, count);
+        out += count * m_frameBytes;
+        frames -= count;
+    }
+}
+
+void EngineSynth::RenderBlock(int frames) {
+    float targetRpm = m_targetRpm.load(std::memory_order_relaxed);
+    float targetLoad = m_targetLoad.load(std::memory_order_relaxed);
+    m_rpm += (targetRpm - m_rpm) * m_rpmSmoothing;
+    m_load += (targetLoad - m_load) * m_loadSmoothing;
+
+    float hz = IDLE_HZ + (MAX_HZ - IDLE_HZ) * m_rpm;
+    double step = TWO_PI * hz / m_frequency;
+    Block block;
+    for (int lane = 0; lane < 4; ++lane) {
+        double phase = m_phase + step * lane;
+        block.cos[lane] = static_cast<float>(std::cos(phase));
+        block.sin[lane] = static_cast<float>(std::sin(phase));
+    }
+    block.rotateCos = static_cast<float>(std::cos(4.0 * step));
+    block.rotateSin = static_cast<float>(std::sin(4.0 * step));
+    float nyquist = 0.45f * m_frequency;
+    for (int h = 0; h < HARMONICS; ++h) {
+        bool audible = hz * (h + 1) < nyquist; // Pas de repliement aux basses fréquences d'échantillonnage
+        block.weights[h] = audible ? LOW_LOAD_WEIGHTS[h] + (HIGH_LOAD_WEIGHTS[h] - LOW_LOAD_WEIGHTS[h]) * m_load : 0.0f;
+    }
+    // Rampe de gain sur le bloc : pas de claquement quand la charge change
+    float targetGain = OUTPUT_GAIN * (0.55f + 0.45f * m_load) * (0.8f + 0.2f * m_rpm);
+    block.gain = m_gain;
+    block.gainStep = (targetGain - m_gain) / BLOCK_FRAMES;
+    block.noise = 0.08f + 0.25f * m_load;
+
+    m_kernel(block, m_block, (frames + 3) & ~3, m_noiseState);
+    m_gain += block.gainStep * frames;
+    m_phase = std::fmod(m_phase + step * frames, TWO_PI);
+}
+
+void EngineSynth::WriteBlock(Uint8* out, int frames) const {
+    // Mono recopié sur chaque canal de sortie, à la place du silence porté par le canal
+    if (m_format == AUDIO_F32SYS) {
+        float* samples = reinterpret_cast<float*>(out);
+        for (int i = 0; i < frames; ++i) {
+            for (int channel = 0; channel < m_channels; ++channel) *samples++ = m_block[i];
+        }
+        return;
+    }
+    Sint16* samples = reinterpret_cast<Sint16*>(out);
+    for (int i = 0; i < frames; ++i) {
+        float value = std::max(-1.0f, std::min(m_block[i], 1.0f)) * 32767.0f;
+        Sint16 sample = static_cast<Sint16>(std::lrint(value));
+        for (int channel = 0; channel < m_channels; ++channel) *samples++ = sample;
+    }
+}
+
+void EngineSynth::LogReport() const {
+    Uint32 buffers = m_buffers.load(std::memory_order_relaxed);
+    if (buffers == 0) {
+        SDL_Log("EngineSynth - Son moteur jamais joue.");
+        return;
+    }
+    double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+    double averageUs = m_totalTicks.load(std::memory_order_relaxed) * 1e6 / frequency / buffers;
+    double maxUs = m_maxTicks.load(std::memory_order_relaxed) * 1e6 / frequency;
+    double audioSeconds = static_cast<double>(m_renderedFrames.load(std::memory_order_relaxed)) / m_frequency;
+    double cpuShare = m_totalTicks.load(std::memory_order_relaxed) / frequency / audioSeconds;
+    SDL_Log("EngineSynth - Noyau %s : %u tampon(s), %.1f us en moyenne, %.1f us au pire, %.3f%% du temps audio (budget %.1f%%), %u hors budget.",
+            GetKernelName(), buffers, averageUs, maxUs, cpuShare * 100.0, CPU_BUDGET * 100.0, m_overBudget.load(std::memory_order_relaxed));
+}
@@ -0,0 +1,105 @@
+#ifndef ENGINESYNTH_H
+#define ENGINESYNTH_H
+
+#include <atomic>
+#include <vector>
+#include <SDL.h>
+#include <SDL_mixer.h>
+
+// Son moteur de la moto, synthétisé en temps réel (voir AudioManager::StartEngineSound).
+// Comme SoundStream, un effet SDL_mixer est posé sur un canal réservé qui joue en boucle un bloc
+// de silence : volume, pause et Mix_Volume s'appliquent comme pour un son ordinaire.
+// L'effet remplace ce silence par une somme d'harmoniques de la fréquence d'allumage (phaseur
+// tournant + récurrence de Tchebychev, sans sin/cos par échantillon) et un bruit d'explosion
+// modulé par la phase. Le régime fixe la hauteur, la charge (accélération / frein moteur) le
+// timbre et le niveau. Noyaux scalaire/SSE2 choisis à l'exécution, par blocs de BLOCK_FRAMES.
+//
+// Open : thread de jeu, alloue le bloc de silence. Start/Stop/SetVolume : côté mixer (commandes
+// d'AudioManager appliquées sur le thread audio). SetTarget : thread de jeu, sans verrou
+// (atomiques lus par le thread audio). Rien n'est alloué sur le thread audio ; son coût par
+// tampon est mesuré et comparé à CPU_BUDGET (voir LogReport).
+class EngineSynth
+{
+public:
+    EngineSynth();
+    ~EngineSynth();
+
+    // Faux si le format du mixer n'est pas géré (S16 ou F32)
+    bool Open(int frequency, Uint16 format, int channels);
+    // Faux si Open n'a pas réussi ou si le canal ne démarre pas
+    bool Start(int channel, int volume);
+    void Stop();
+    void SetVolume(int volume);
+    // rpm : 0 = ralenti, 1 = régime maximal ; load : 0 = frein moteur, 1 = pleine accélération
+    void SetTarget(float rpm, float load);
+
+    inline bool IsOpen() const { return m_carrier != nullptr && m_frameBytes > 0; }
+    inline bool IsRunning() const { return m_channel >= 0; }
+    inline int GetChannel() const { return m_channel; }
+    const char* GetKernelName() const;
+    // Coût moyen et maximal par tampon, tampons hors budget
+    void LogReport() const;
+
+    static const int HARMONICS = 8;
+    static const int BLOCK_FRAMES = 64;   // Paramètres lissés et hauteur fixe par bloc
+    static const float IDLE_HZ;           // Fréquence d'allumage au ralenti...
+    static const float MAX_HZ;            // ... et au régime maximal
+    static const float CPU_BUDGET;        // Part maximale de la durée d'un tampon
+
+    // Paramètres d'un bloc, calculés par le thread audio avant l'appel du noyau
+    struct Block
+    {
+        alignas(16) float cos[4];    // Phaseur de départ des 4 voies (échantillons i, i+1, i+2, i+3)
+        alignas(16) float sin[4];
+        float rotateCos;             // Rotation de 4 échantillons
+        float rotateSin;
+        float weights[HARMONICS];
+        float gain;                  // Gain du premier échantillon, puis + gainStep par échantillon
+        float gainStep;
+        float noise;                 // Niveau du bruit d'explosion
+    };
+    // count multiple de 4 ; noiseState : 4 graines xorshift, mises à jour
+    typedef void (*KernelFn)(const Block& block, float* out, int count, Uint32* noiseState);
+
+private:
+    static void Effect(int channel, void* stream, int length, void* userdata); // Thread audio
+    static void EffectDone(int channel, void* userdata);
+    void Render(Uint8* out, int frames);
+    void RenderBlock(int frames);
+    void WriteBlock(Uint8* out, int frames) const;
+
+    // Format de sortie du mixer
+    int m_frequency = 0;
+    Uint16 m_format = 0;
+    int m_channels = 0;
+    int m_frameBytes = 0;
+    KernelFn m_kernel;
+    bool m_simd = false;
+
+    // Cibles écrites par le thread de jeu
+    std::atomic<float> m_targetRpm;
+    std::atomic<float> m_targetLoad;
+
+    // État du thread audio
+    double m_phase = 0.0;            // Radians, dans [0, 2π)
+    float m_rpm = 0.0f;
+    float m_load = 0.0f;
+    float m_gain = 0.0f;
+    float m_rpmSmoothing = 1.0f;     // Coefficients de lissage par bloc (voir Open)
+    float m_loadSmoothing = 1.0f;
+    alignas(16) Uint32 m_noiseState[4];
+    alignas(16) float m_block[BLOCK_FRAMES];
+
+    // Mesures (thread audio), lues par LogReport
+    std::atomic<Uint32> m_buffers;
+    std::atomic<Uint32> m_overBudget;
+    std::atomic<Uint64> m_totalTicks;
+    std::atomic<Uint64> m_maxTicks;
+    std::atomic<Uint64> m_renderedFrames;
+
+    std::vector<Uint8> m_carrierSamples; // Silence joué en boucle par le canal
+    Mix_Chunk* m_carrier = nullptr;
+    int m_channel = -1;
+};
+
+#endif // ENGINESYNTH_H
@@ -0,0 +1,208 @@
+#include "MusicPlayer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+const int MusicPlayer::DECKS;
+const int MusicPlayer::BLOCK_FRAMES;
+
+namespace {
+
+const int CARRIER_BYTES = 16384; // Une boucle de silence couvre au moins un tampon du périphérique
+
+// Ajoute frames images de in, au gain croissant ou décroissant de step par image, à mix
+template <typename T>
+void Accumulate(const T* in, float scale, int channels, Uint32 frames, float gain, float step, float* mix) {
+    for (Uint32 i = 0; i < frames; ++i) {
+        float g = std::max(0.0f, std::min(gain, 1.0f)) * scale;
+        for (int channel = 0; channel < channels; ++channel) *mix++ += g * static_cast<float>(*in++);
+        gain += step;
+    }
+}
+
+} // namespace
+
+MusicPlayer::MusicPlayer()
+{
+}
+
+MusicPlayer::~MusicPlayer() {
+    if (m_carrier != nullptr) Mix_FreeChunk(m_carrier); // Canal déjà arrêté par AudioManager
+}
+
+bool MusicPlayer::Open(int frequency, Uint16 format, int channels) {
+    if (format != AUDIO_S16SYS && format != AUDIO_F32SYS) {
+        SDL_Log("MusicPlayer::Open - ECHEC: format du mixer 0x%04X non gere (S16 ou F32).", format);
+        return false;
+    }
+    m_frequency = frequency;
+    m_format = format;
+    m_channels = channels;
+    m_frameBytes = (SDL_AUDIO_BITSIZE(format) / 8) * channels;
+    m_mix.assign(static_cast<size_t>(BLOCK_FRAMES) * channels, 0.0f);
+    m_block.assign(static_cast<size_t>(BLOCK_FRAMES) * m_frameBytes, 0);
+
+    if (m_carrier == nullptr) {
+        m_carrierSamples.assign(CARRIER_BYTES, 0);
+        m_carrier = Mix_QuickLoad_RAW(m_carrierSamples.data(), static_cast<Uint32>(m_carrierSamples.size()));
+    }
+    if (m_carrier == nullptr) {
+        SDL_Log("MusicPlayer::Open - ECHEC: bloc de silence : %s", Mix_GetError());
+        return false;
+    }
+    return true;
+}
+
+bool MusicPlayer::Attach(int channel) {
+    if (!IsOpen()) return false;
+    if (Mix_PlayChannel(channel, m_carrier, -1) < 0) {
+        SDL_Log("MusicPlayer::Attach - ECHEC: canal %d : %s", channel, Mix_GetError());
+        return false;
+    }
+    if (Mix_RegisterEffect(channel, Effect, nullptr, this) == 0) {
+        SDL_Log("MusicPlayer::Attach - ECHEC: effet sur le canal %d : %s", channel, Mix_GetError());
+        Mix_HaltChannel(channel);
+        return false;
+    }
+    return true;
+}
+
+void MusicPlayer::SetFade(Uint32 ms) {
+    m_fadeFrames = static_cast<Uint32>(static_cast<Uint64>(ms) * m_frequency / 1000);
+}
+
+float MusicPlayer::FadeStep() const {
+    return m_fadeFrames > 0 ? 1.0f / static_cast<float>(m_fadeFrames) : 1.0f;
+}
+
+void MusicPlayer::Play(SoundStream* stream, int track, Uint32 serial) {
+    // Deux platines audibles : la plus faible est coupée, sa platine reste réservée jusqu'à TakeChange
+    Deck* quietest = nullptr;
+    int active = 0;
+    for (Deck& deck : m_decks) {
+        if (!deck.active) continue;
+        ++active;
+        if (quietest == nullptr || deck.gain < quietest->gain) quietest = &deck;
+    }
+    if (active >= DECKS - 1) End(*quietest, CHANGE_FADED);
+
+    Deck* incoming = nullptr;
+    for (Deck& deck : m_decks) {
+        if (!deck.active && deck.end == CHANGE_NONE && deck.loopsToReport == 0) {
+            incoming = &deck;
+            break;
+        }
+    }
+    if (incoming == nullptr) return; // Fins pas encore signalées (voir AudioManager::ApplyCommands)
+    FadeOut();
+
+    incoming->stream = stream;
+    incoming->gain = m_fadeFrames > 0 ? 0.0f : 1.0f;
+    incoming->gainStep = m_fadeFrames > 0 ? FadeStep() : 0.0f;
+    incoming->track = track;
+    incoming->serial = serial;
+    incoming->loopsToReport = 0;
+    incoming->end = CHANGE_NONE;
+    incoming->active = true;
+}
+
+void MusicPlayer::FadeOut() {
+    for (Deck& deck : m_decks) {
+        if (!deck.active) continue;
+        if (m_fadeFrames == 0) {
+            End(deck, CHANGE_FADED);
+        } else {
+            deck.gain = std::min(deck.gain, 1.0f);
+            deck.gainStep = -FadeStep(); // Depuis son gain actuel : plus tôt éteinte si déjà en fondu
+        }
+    }
+}
+
+void MusicPlayer::Stop() {
+    for (Deck& deck : m_decks) {
+        if (deck.active) End(deck, CHANGE_FADED);
+    }
+}
+
+void MusicPlayer::End(Deck& deck, Change end) {
+    deck.active = false;
+    deck.end = end;
+}
+
+MusicPlayer::Change MusicPlayer::TakeChange(int* track, Uint32* serial) {
+    for (Deck& deck : m_decks) {
+        if (deck.loopsToReport == 0 && deck.end == CHANGE_NONE) continue;
+        *track = deck.track;
+        *serial = deck.serial;
+        if (deck.loopsToReport > 0) {
+            --deck.loopsToReport;
+            return CHANGE_LOOPED;
+        }
+        Change end = deck.end;
+        deck.end = CHANGE_NONE;
+        deck.stream = nullptr; // Le flux peut être fermé
+        return end;
+    }
+    return CHANGE_NONE;
+}
+
+void MusicPlayer::Effect(int /*channel*/, void* stream, int length, void* userdata) {
+    MusicPlayer* self = static_cast<MusicPlayer*>(userdata);
+    bool active = false;
+    for (const Deck& deck : self->m_decks) active = active || deck.active;
+    if (!active) return; // Le canal porte déjà du silence
+
+    Uint8* out = static_cast<Uint8*>(stream);
+    int frames = length / self->m_frameBytes;
+    while (frames > 0) {
+        int count = std::min(frames, BLOCK_FRAMES);
+        std::fill(self->m_mix.begin(), self->m_mix.begin() + count * self->m_channels, 0.0f);
+        for (Deck& deck : self->m_decks) self->MixDeck(deck, count);
+
+        // Remplace le silence porté par le canal
+        const float* mix = self->m_mix.data();
+        int samples = count * self->m_channels;
+        if (self->m_format == AUDIO_F32SYS) {
+            std::memcpy(out, mix, samples * sizeof(float));
+        } else {
+            Sint16* target = reinterpret_cast<Sint16*>(out);
+            for (int i = 0; i < samples; ++i) {
+                float value = std::max(-1.0f, std::min(mix[i], 1.0f)) * 32767.0f;
+                target[i] = static_cast<Sint16>(std::lrint(value));
+            }
+        }
+        out += count * self->m_frameBytes;
+        frames -= count;
+    }
+}
+
+void MusicPlayer::MixDeck(Deck& deck, int frames) {
+    if (!deck.active) return;
+    Uint32 count = static_cast<Uint32>(frames);
+    if (deck.gainStep < 0.0f) {
+        // Fondu sortant : s'arrête à l'image où le gain atteint zéro
+        Uint32 left = static_cast<Uint32>(std::ceil(deck.gain / -deck.gainStep));
+        count = std::min(count, left);
+    }
+    // Anneau en retard ou fin du flux : le manque est mixé comme du silence
+    size_t bytes = static_cast<size_t>(count) * m_frameBytes;
+    bool looped = false;
+    size_t got = deck.stream->Read(m_block.data(), bytes, &looped);
+    std::memset(m_block.data() + got, 0, bytes - got);
+    if (looped) ++deck.loopsToReport;
+
+    if (m_format == AUDIO_F32SYS) {
+        Accumulate(reinterpret_cast<const float*>(m_block.data()), 1.0f, m_channels, count, deck.gain, deck.gainStep, m_mix.data());
+    } else {
+        Accumulate(reinterpret_cast<const Sint16*>(m_block.data()), 1.0f / 32768.0f, m_channels, count, deck.gain, deck.gainStep, m_mix.data());
+    }
+    deck.gain += deck.gainStep * count;
+
+    if (deck.gainStep < 0.0f && deck.gain <= 0.0f) {
+        End(deck, CHANGE_FADED);
+    } else if (deck.gainStep > 0.0f && deck.gain >= 1.0f) {
+        deck.gain = 1.0f;
+        deck.gainStep = 0.0f;
+    }
+    if (deck.active && deck.stream->IsFinished()) End(deck, CHANGE_FINISHED);
+}
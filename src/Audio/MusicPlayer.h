@@ -0,0 +1,85 @@
+#ifndef MUSICPLAYER_H
+#define MUSICPLAYER_H
+
+#include <vector>
+#include <SDL.h>
+#include <SDL_mixer.h>
+#include "SoundStream.h"
+
+// Musique de fond sans coupure (voir AudioManager::PlayMusic). Comme SoundStream et
+// EngineSynth, un effet SDL_mixer est posé sur un canal réservé qui joue en boucle un bloc de
+// silence : volume et pause du canal font office de volume et de pause de la musique.
+// L'effet mixe deux platines au plus : la piste entrante monte pendant que l'autre s'éteint, en
+// fondu enchaîné linéaire de SetFade millisecondes (0 : coupure franche). Chaque platine lit un
+// SoundStream préparé par AudioManager : décodage par tranches sur un worker dans un anneau au
+// format du mixer, boucles comprises ; le thread audio ne fait qu'y puiser (SoundStream::Read).
+//
+// Open : thread de jeu, alloue tout. Le reste : côté mixer (commandes d'AudioManager appliquées
+// sur le thread audio). Une piste reste lue tant que TakeChange n'a pas signalé sa fin.
+class MusicPlayer
+{
+public:
+    MusicPlayer();
+    ~MusicPlayer();
+
+    // Faux si le format du mixer n'est pas géré (S16 ou F32)
+    bool Open(int frequency, Uint16 format, int channels);
+    // Joue le bloc de silence sur le canal et y pose l'effet, à chaque ouverture du périphérique
+    bool Attach(int channel);
+    inline bool IsOpen() const { return m_carrier != nullptr && m_frameBytes > 0; }
+
+    void SetFade(Uint32 ms);
+    // Fondu vers stream, préparé et à ses boucles (SoundStream::SetLoops). Deux platines déjà
+    // audibles : la plus faible est coupée. Les fins signalées par TakeChange avant l'appel,
+    // une platine est toujours libre. Le flux reste lu jusqu'à ce que TakeChange signale sa fin.
+    void Play(SoundStream* stream, int track, Uint32 serial);
+    void FadeOut();
+    void Stop(); // Sans fondu
+
+    enum Change {
+        CHANGE_NONE,
+        CHANGE_LOOPED,   // Piste revenue au début pour une nouvelle lecture
+        CHANGE_FINISHED, // Piste au bout de ses lectures
+        CHANGE_FADED     // Piste éteinte par un fondu, coupée ou arrêtée
+    };
+    // Après le mixage d'un tampon : une boucle ou une fin depuis le dernier appel, avec la piste
+    // et la lecture concernées ; CHANGE_NONE s'il n'y a plus rien à signaler
+    Change TakeChange(int* track, Uint32* serial);
+
+    static const int DECKS = 3; // Deux audibles, une troisième réservée à une piste coupée pas encore signalée
+    static const int BLOCK_FRAMES = 256; // Mixage par blocs dans m_mix
+
+private:
+    struct Deck
+    {
+        SoundStream* stream = nullptr;
+        float gain = 0.0f;
+        float gainStep = 0.0f;   // Par image
+        bool active = false;     // Mixée
+        int track = -1;
+        Uint32 serial = 0;
+        Uint32 loopsToReport = 0;
+        Change end = CHANGE_NONE; // Fin pas encore signalée : platine réservée jusque-là
+    };
+
+    static void Effect(int channel, void* stream, int length, void* userdata); // Thread audio
+    void MixDeck(Deck& deck, int frames);
+    void End(Deck& deck, Change end);
+    float FadeStep() const;
+
+    // Format de sortie du mixer
+    int m_frequency = 0;
+    Uint16 m_format = 0;
+    int m_channels = 0;
+    int m_frameBytes = 0;
+
+    Uint32 m_fadeFrames = 0;
+    Deck m_decks[DECKS];
+    std::vector<float> m_mix;    // BLOCK_FRAMES images
+    std::vector<Uint8> m_block;  // BLOCK_FRAMES images lues d'une platine, au format du mixer
+
+    std::vector<Uint8> m_carrierSamples; // Silence joué en boucle par le canal
+    Mix_Chunk* m_carrier = nullptr;
+};
+
+#endif // MUSICPLAYER_H
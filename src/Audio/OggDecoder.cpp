@@ -0,0 +1,185 @@
+#include "OggDecoder.h"
+#include <cstddef>
+
+// En-têtes de libvorbis présents (SDK à côté de SDL) : les déclarations ci-dessous sont vérifiées
+// contre eux à la compilation
+#if defined(__has_include)
+#if __has_include(<vorbis/vorbisfile.h>)
+#include <vorbis/vorbisfile.h>
+#define OGGDECODER_CHECK_ABI
+#endif
+#endif
+
+const size_t OggDecoder::FILE_STATE_BYTES;
+
+namespace {
+
+#if defined(_WIN32)
+const char* const VORBISFILE_LIBRARY = "libvorbisfile-3.dll";
+#elif defined(__APPLE__)
+const char* const VORBISFILE_LIBRARY = "libvorbisfile.3.dylib";
+#else
+const char* const VORBISFILE_LIBRARY = "libvorbisfile.so.3";
+#endif
+
+const int OV_HOLE = -3; // Trou dans les données : ov_read peut continuer
+
+// Déclarations de vorbis/vorbisfile.h utilisées ici (ABI stable depuis libvorbis 1.0)
+struct OvCallbacks
+{
+    size_t (*read)(void* ptr, size_t size, size_t count, void* source);
+    int (*seek)(void* source, Sint64 offset, int whence);
+    int (*close)(void* source);
+    long (*tell)(void* source);
+};
+
+struct VorbisInfo // Début de vorbis_info
+{
+    int version;
+    int channels;
+    long rate;
+};
+
+#ifdef OGGDECODER_CHECK_ABI
+static_assert(sizeof(OggVorbis_File) <= OggDecoder::FILE_STATE_BYTES, "OggDecoder::FILE_STATE_BYTES trop petit pour OggVorbis_File");
+static_assert(sizeof(ogg_int64_t) == sizeof(Sint64), "ogg_int64_t");
+static_assert(sizeof(OvCallbacks) == sizeof(ov_callbacks) &&
+              offsetof(OvCallbacks, read) == offsetof(ov_callbacks, read_func) &&
+              offsetof(OvCallbacks, seek) == offsetof(ov_callbacks, seek_func) &&
+              offsetof(OvCallbacks, close) == offsetof(ov_callbacks, close_func) &&
+              offsetof(OvCallbacks, tell) == offsetof(ov_callbacks, tell_func), "OvCallbacks != ov_callbacks");
+static_assert(offsetof(VorbisInfo, version) == offsetof(vorbis_info, version) &&
+              offsetof(VorbisInfo, channels) == offsetof(vorbis_info, channels) &&
+              offsetof(VorbisInfo, rate) == offsetof(vorbis_info, rate), "VorbisInfo != vorbis_info");
+#endif
+
+// Valeurs plausibles lues dans les en-têtes : au-delà, bibliothèque d'une autre ABI ou fichier corrompu
+const int MAX_CHANNELS = 8;
+const long MIN_RATE = 8000;
+const long MAX_RATE = 192000;
+
+struct VorbisFileApi
+{
+    int (*openCallbacks)(void* source, void* file, const char* initial, long initialBytes, OvCallbacks callbacks) = nullptr;
+    VorbisInfo* (*info)(void* file, int link) = nullptr;
+    Sint64 (*pcmTotal)(void* file, int link) = nullptr;
+    long (*read)(void* file, char* buffer, int length, int bigEndian, int word, int sgned, int* link) = nullptr;
+    int (*pcmSeek)(void* file, Sint64 position) = nullptr;
+    int (*clear)(void* file) = nullptr;
+    bool loaded = false;
+};
+
+template <typename T>
+bool LoadFunction(void* library, const char* name, T& function) {
+    function = reinterpret_cast<T>(SDL_LoadFunction(library, name));
+    return function != nullptr;
+}
+
+VorbisFileApi LoadApi() {
+    VorbisFileApi api;
+    void* library = SDL_LoadObject(VORBISFILE_LIBRARY);
+    if (library == nullptr) {
+        SDL_Log("OggDecoder - %s introuvable : musiques OGG non lisibles (%s).", VORBISFILE_LIBRARY, SDL_GetError());
+        return api;
+    }
+    api.loaded = LoadFunction(library, "ov_open_callbacks", api.openCallbacks) && LoadFunction(library, "ov_info", api.info) &&
+                 LoadFunction(library, "ov_pcm_total", api.pcmTotal) && LoadFunction(library, "ov_read", api.read) &&
+                 LoadFunction(library, "ov_pcm_seek", api.pcmSeek) && LoadFunction(library, "ov_clear", api.clear);
+    if (!api.loaded) {
+        SDL_Log("OggDecoder - %s incomplete : musiques OGG non lisibles (%s).", VORBISFILE_LIBRARY, SDL_GetError());
+        SDL_UnloadObject(library);
+    }
+    return api; // Bibliothèque gardée jusqu'à la fin du programme
+}
+
+const VorbisFileApi& Api() {
+    static const VorbisFileApi api = LoadApi(); // Initialisation protégée : workers compris
+    return api;
+}
+
+// Lecture de l'asset (AssetPack : fichier ou données liées à l'exécutable)
+size_t ReadSource(void* ptr, size_t size, size_t count, void* source) {
+    return SDL_RWread(static_cast<SDL_RWops*>(source), ptr, size, count);
+}
+
+int SeekSource(void* source, Sint64 offset, int whence) {
+    return SDL_RWseek(static_cast<SDL_RWops*>(source), offset, whence) < 0 ? -1 : 0; // SEEK_* == RW_SEEK_*
+}
+
+int CloseSource(void* source) {
+    return SDL_RWclose(static_cast<SDL_RWops*>(source));
+}
+
+long TellSource(void* source) {
+    return static_cast<long>(SDL_RWtell(static_cast<SDL_RWops*>(source)));
+}
+
+} // namespace
+
+OggDecoder::OggDecoder()
+{
+}
+
+OggDecoder::~OggDecoder() {
+    Close();
+}
+
+bool OggDecoder::IsAvailable() {
+    return Api().loaded;
+}
+
+bool OggDecoder::Open(SDL_RWops* rw, std::string* error) {
+    Close();
+    if (!IsAvailable()) {
+        SDL_RWclose(rw);
+        *error = std::string(VORBISFILE_LIBRARY) + " introuvable";
+        return false;
+    }
+    const OvCallbacks callbacks = { ReadSource, SeekSource, CloseSource, TellSource };
+    if (Api().openCallbacks(rw, m_file, nullptr, 0, callbacks) != 0) {
+        SDL_RWclose(rw); // Laissé à l'appelant par ov_open_callbacks en cas d'échec
+        *error = "pas un fichier Ogg Vorbis";
+        return false;
+    }
+    m_open = true; // ov_clear fermera rw
+    const VorbisInfo* info = Api().info(m_file, -1);
+    bool plausible = info != nullptr && info->version == 0 && info->channels > 0 && info->channels <= MAX_CHANNELS &&
+                     info->rate >= MIN_RATE && info->rate <= MAX_RATE;
+    m_channels = plausible ? info->channels : 0;
+    m_frequency = plausible ? static_cast<int>(info->rate) : 0;
+    m_frames = Api().pcmTotal(m_file, -1);
+    if (m_frames < 0) m_frames = -1;
+    if (!plausible) {
+        Close();
+        *error = "en-tetes Vorbis invalides";
+        return false;
+    }
+    return true;
+}
+
+void OggDecoder::Close() {
+    if (!m_open) return;
+    Api().clear(m_file);
+    m_open = false;
+}
+
+int OggDecoder::Read(Uint8* buffer, int bytes) {
+    const int frameBytes = 2 * m_channels;
+    bytes -= bytes % frameBytes;
+    int total = 0;
+    while (total < bytes) {
+        // Un paquet Vorbis au plus par appel : on boucle pour remplir la tranche
+        int link = 0;
+        long got = Api().read(m_file, reinterpret_cast<char*>(buffer + total), bytes - total,
+                              SDL_BYTEORDER == SDL_BIG_ENDIAN ? 1 : 0, 2, 1, &link);
+        if (got == OV_HOLE) continue;
+        if (got < 0) return total > 0 ? total : -1;
+        if (got == 0) break;
+        total += static_cast<int>(got);
+    }
+    return total;
+}
+
+bool OggDecoder::Rewind() {
+    return m_open && Api().pcmSeek(m_file, 0) == 0;
+}
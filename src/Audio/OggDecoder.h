@@ -0,0 +1,52 @@
+#ifndef OGGDECODER_H
+#define OGGDECODER_H
+
+#include <string>
+#include <SDL.h>
+
+// Décodage Ogg Vorbis par tranches, pour SoundStream : SDL_mixer ne sait que décoder un OGG en
+// entier (Mix_LoadWAV_RW) ou le jouer seul (Mix_Music). libvorbisfile, déjà livrée à côté de
+// l'exécutable pour SDL_mixer (libvorbisfile-3.dll), est chargée à l'exécution comme le fait
+// SDL_mixer : ni en-tête ni bibliothèque de plus au build. Les déclarations de vorbisfile.h
+// utilisées sont reprises dans OggDecoder.cpp et vérifiées par static_assert quand les en-têtes
+// de libvorbis sont trouvés ; Open refuse des en-têtes Vorbis invraisemblables. Sans la
+// bibliothèque, IsAvailable est faux (voir SoundStream::Open pour le repli des musiques).
+// Sortie : S16 système entrelacé, aux canaux et à la fréquence du fichier.
+// Un décodeur n'est utilisé que par un thread à la fois (worker de SoundStream).
+class OggDecoder
+{
+public:
+    OggDecoder();
+    ~OggDecoder();
+
+    static bool IsAvailable(); // Charge libvorbisfile au premier appel
+
+    // Lit les en-têtes. Prend rw, même en cas d'échec.
+    bool Open(SDL_RWops* rw, std::string* error);
+    void Close();
+    inline bool IsOpen() const { return m_open; }
+
+    // Octets décodés (bytes au plus, trames entières), 0 à la fin du fichier, -1 sur erreur
+    int Read(Uint8* buffer, int bytes);
+    bool Rewind(); // Retour à la première image, sans relire les en-têtes
+
+    inline int GetChannels() const { return m_channels; }
+    inline int GetFrequency() const { return m_frequency; }
+    inline Sint64 GetFrames() const { return m_frames; } // -1 si inconnu (flux non positionnable)
+
+    // OggVorbis_File, opaque ici : 944 octets en 64 bits avec libvorbis 1.3, réservé large
+    // (static_assert avec les en-têtes de libvorbis)
+    static const size_t FILE_STATE_BYTES = 4096;
+
+private:
+    OggDecoder(const OggDecoder&) = delete;
+    OggDecoder& operator=(const OggDecoder&) = delete;
+
+    alignas(16) unsigned char m_file[FILE_STATE_BYTES];
+    bool m_open = false;
+    int m_channels = 0;
+    int m_frequency = 0;
+    Sint64 m_frames = -1;
+};
+
+#endif // OGGDECODER_H
@@ -0,0 +1,381 @@
+#include "SoundStream.h"
+#include <algorithm>
+#include <cstring>
+#include "../Core/AssetPack.h"
+
+const Uint32 SoundStream::RING_MS;
+const Uint32 SoundStream::PREFILL_MS;
+const int SoundStream::READ_BYTES;
+const size_t SoundStream::NO_LOOP_MARK;
+
+namespace {
+
+const Uint16 WAVE_PCM = 0x0001;
+const Uint16 WAVE_FLOAT = 0x0003;
+const Uint16 WAVE_EXTENSIBLE = 0xFFFE;
+const int CARRIER_BYTES = 4096;
+
+bool ReadTag(SDL_RWops* rw, char tag[4]) {
+    return SDL_RWread(rw, tag, 1, 4) == 4;
+}
+
+} // namespace
+
+SoundStream::SoundStream(const std::string& source, int frequency, Uint16 format, int channels)
+    : m_source(source), m_frequency(frequency), m_format(format), m_channels(channels),
+      m_readPos(0), m_writePos(0), m_loopMark(NO_LOOP_MARK), m_loops(0), m_decodeDone(false), m_finished(false), m_underruns(0)
+{
+    m_frameBytes = (SDL_AUDIO_BITSIZE(format) / 8) * channels;
+    m_silence = (format == AUDIO_U8) ? 0x80 : 0x00;
+}
+
+SoundStream::~SoundStream() {
+    Release(); // Canal déjà arrêté par AudioManager
+    if (m_carrier != nullptr) Mix_FreeChunk(m_carrier);
+    if (m_wholeTrack != nullptr) Mix_FreeChunk(m_wholeTrack); // Jamais joué sur un canal
+}
+
+bool SoundStream::Open(std::string* error, bool wholeTrack) {
+    SDL_RWops* rw = AssetPack::GetInstance()->Open(m_source);
+    if (rw == nullptr) {
+        *error = SDL_GetError();
+        return false;
+    }
+    char tag[4];
+    m_ogg = ReadTag(rw, tag) && std::memcmp(tag, "OggS", 4) == 0;
+    SDL_RWseek(rw, 0, RW_SEEK_SET);
+    if (m_ogg && wholeTrack && !OggDecoder::IsAvailable()) {
+        // Décodeur intégré de SDL_mixer : toute la piste en mémoire, mais la musique joue
+        m_wholeTrack = Mix_LoadWAV_RW(rw, 1);
+        if (m_wholeTrack == nullptr) {
+            *error = Mix_GetError();
+            return false;
+        }
+        m_ogg = false;
+        m_fileFormat = m_format;
+        m_fileChannels = m_channels;
+        m_fileFrequency = m_frequency;
+        m_dataBytes = m_wholeTrack->alen;
+        SDL_Log("SoundStream::Open - '%s' decode en entier sans libvorbisfile (%u Ko).", m_source.c_str(), m_dataBytes / 1024);
+    } else if (m_ogg) {
+        // Décodé en S16 aux canaux et à la fréquence du fichier ; rouvert par Start
+        if (!m_decoder.Open(rw, error)) return false; // Ferme rw
+        m_fileFormat = AUDIO_S16SYS;
+        m_fileChannels = m_decoder.GetChannels();
+        m_fileFrequency = m_decoder.GetFrequency();
+        Sint64 bytes = m_decoder.GetFrames() * 2 * m_fileChannels;
+        m_dataBytes = static_cast<Uint32>(std::max<Sint64>(0, std::min<Sint64>(bytes, SDL_MAX_UINT32)));
+        m_decoder.Close();
+    } else if (!OpenWave(rw, error)) {
+        return false;
+    }
+
+    // Anneau et tampons dimensionnés une fois : rien n'est alloué pendant la lecture.
+    size_t ringFrames = static_cast<size_t>(m_frequency) * RING_MS / 1000;
+    m_ring.assign(ringFrames * m_frameBytes, m_silence);
+    m_readBuffer.resize(READ_BYTES);
+    m_convertBuffer.resize(READ_BYTES * 4); // Conversion mono 8 bits -> stéréo 16 bits comprise
+    if (m_carrier == nullptr) {
+        m_carrierSamples.assign(CARRIER_BYTES, m_silence);
+        m_carrier = Mix_QuickLoad_RAW(m_carrierSamples.data(), static_cast<Uint32>(m_carrierSamples.size()));
+    }
+    if (m_carrier == nullptr) {
+        *error = Mix_GetError();
+        m_ring.clear();
+        return false;
+    }
+    return true;
+}
+
+bool SoundStream::OpenWave(SDL_RWops* rw, std::string* error) {
+    char tag[4];
+    bool riff = ReadTag(rw, tag) && std::memcmp(tag, "RIFF", 4) == 0;
+    SDL_ReadLE32(rw);
+    riff = riff && ReadTag(rw, tag) && std::memcmp(tag, "WAVE", 4) == 0;
+    if (!riff) {
+        SDL_RWclose(rw);
+        *error = "pas un fichier WAV ni OGG";
+        return false;
+    }
+
+    Uint16 encoding = 0;
+    int bits = 0;
+    m_dataOffset = 0;
+    while (ReadTag(rw, tag)) {
+        Uint32 size = SDL_ReadLE32(rw);
+        Sint64 next = SDL_RWtell(rw) + size + (size & 1);
+        if (std::memcmp(tag, "fmt ", 4) == 0 && size >= 16) {
+            encoding = SDL_ReadLE16(rw);
+            m_fileChannels = SDL_ReadLE16(rw);
+            m_fileFrequency = static_cast<int>(SDL_ReadLE32(rw));
+            SDL_ReadLE32(rw); // Octets par seconde
+            SDL_ReadLE16(rw); // Alignement des blocs
+            bits = SDL_ReadLE16(rw);
+            if (encoding == WAVE_EXTENSIBLE && size >= 40) {
+                SDL_RWseek(rw, 8, RW_SEEK_CUR); // Taille, bits utiles, masque des canaux
+                encoding = SDL_ReadLE16(rw);    // Début du GUID du sous-format
+            }
+        } else if (std::memcmp(tag, "data", 4) == 0) {
+            m_dataOffset = SDL_RWtell(rw);
+            m_dataBytes = size;
+            break;
+        }
+        SDL_RWseek(rw, next, RW_SEEK_SET);
+    }
+    SDL_RWclose(rw);
+
+    m_fileFormat = 0;
+    if (encoding == WAVE_PCM && bits == 8) m_fileFormat = AUDIO_U8;
+    else if (encoding == WAVE_PCM && bits == 16) m_fileFormat = AUDIO_S16LSB;
+    else if (encoding == WAVE_PCM && bits == 32) m_fileFormat = AUDIO_S32LSB;
+    else if (encoding == WAVE_FLOAT && bits == 32) m_fileFormat = AUDIO_F32LSB;
+    if (m_dataOffset == 0 || m_fileFormat == 0 || m_fileChannels <= 0 || m_fileFrequency <= 0) {
+        *error = "format WAV non lisible en flux (PCM 8/16/32 bits ou flottant 32 bits)";
+        return false;
+    }
+    return true;
+}
+
+void SoundStream::PrepareAsync(int loops) {
+    JobSystem* jobs = JobSystem::GetInstance();
+    std::vector<JobSystem::JobHandle> previous;
+    if (m_job) previous.push_back(m_job); // Décodage de la lecture précédente : suivi, pas attendu
+    m_error.clear();
+    m_preparing = true;
+    m_job = jobs->Schedule("sound_stream_prepare", [this, loops]() {
+        Close();
+        if (m_ring.empty() && !Open(&m_error, true)) return; // En-têtes lus au premier appel
+        Start(loops);
+    }, previous);
+    if (jobs->GetWorkerCount() == 0) jobs->Wait(m_job); // Sans worker, une tâche n'avancerait que dans Wait()
+}
+
+bool SoundStream::IsPreparing() {
+    return IsBusy() && m_preparing;
+}
+
+bool SoundStream::IsBusy() {
+    if (m_job && JobSystem::GetInstance()->IsDone(m_job)) {
+        m_job.reset();
+        m_preparing = false;
+    }
+    return static_cast<bool>(m_job);
+}
+
+void SoundStream::SetLoops(int loops) {
+    m_loops.store(loops, std::memory_order_relaxed);
+}
+
+bool SoundStream::Attach(int channel, int volume) {
+    Mix_VolumeChunk(m_carrier, volume);
+    if (Mix_PlayChannel(channel, m_carrier, -1) < 0) {
+        SDL_Log("SoundStream::Attach - ECHEC: canal %d pour '%s' : %s", channel, m_source.c_str(), Mix_GetError());
+        return false;
+    }
+    // Le canal peut mixer un bloc de silence avant l'effet : sans conséquence.
+    if (Mix_RegisterEffect(channel, Effect, EffectDone, this) == 0) {
+        SDL_Log("SoundStream::Attach - ECHEC: effet sur le canal %d : %s", channel, Mix_GetError());
+        Mix_HaltChannel(channel);
+        return false;
+    }
+    return true;
+}
+
+bool SoundStream::Start(int loops) {
+    if (!RewindSource()) {
+        m_error = SDL_GetError();
+        CloseSource();
+        return false;
+    }
+    m_converter = SDL_NewAudioStream(m_fileFormat, static_cast<Uint8>(m_fileChannels), m_fileFrequency,
+                                     m_format, static_cast<Uint8>(m_channels), m_frequency);
+    if (m_converter == nullptr) {
+        m_error = SDL_GetError();
+        CloseSource();
+        return false;
+    }
+    m_flushed = false;
+    m_readPos.store(0, std::memory_order_relaxed);
+    m_writePos.store(0, std::memory_order_relaxed);
+    m_loopMark.store(NO_LOOP_MARK, std::memory_order_relaxed);
+    m_loops.store(loops, std::memory_order_relaxed);
+    m_decodeDone.store(false, std::memory_order_relaxed);
+    m_finished.store(false, std::memory_order_relaxed);
+    Decode(static_cast<size_t>(m_frequency) * PREFILL_MS / 1000 * m_frameBytes);
+    return true;
+}
+
+bool SoundStream::RewindSource() {
+    m_dataRead = 0;
+    if (m_wholeTrack != nullptr) return true;
+    if (m_ogg) {
+        if (m_decoder.IsOpen()) return m_decoder.Rewind();
+        SDL_RWops* rw = AssetPack::GetInstance()->Open(m_source);
+        std::string error;
+        if (rw != nullptr && !m_decoder.Open(rw, &error)) SDL_SetError("%s", error.c_str());
+        return m_decoder.IsOpen();
+    }
+    if (m_file == nullptr) m_file = AssetPack::GetInstance()->Open(m_source);
+    return m_file != nullptr && SDL_RWseek(m_file, m_dataOffset, RW_SEEK_SET) >= 0;
+}
+
+int SoundStream::ReadSource() {
+    if (m_ogg) return m_decoder.Read(m_readBuffer.data(), static_cast<int>(m_readBuffer.size()));
+    Uint32 wanted = std::min<Uint32>(static_cast<Uint32>(m_readBuffer.size()), m_dataBytes - m_dataRead);
+    if (m_wholeTrack != nullptr) {
+        std::memcpy(m_readBuffer.data(), m_wholeTrack->abuf + m_dataRead, wanted);
+        return static_cast<int>(wanted);
+    }
+    return wanted > 0 ? static_cast<int>(SDL_RWread(m_file, m_readBuffer.data(), 1, wanted)) : 0;
+}
+
+void SoundStream::CloseSource() {
+    if (m_file != nullptr) {
+        SDL_RWclose(m_file);
+        m_file = nullptr;
+    }
+    m_decoder.Close();
+}
+
+void SoundStream::Release() {
+    if (m_job) {
+        JobSystem::GetInstance()->Wait(m_job);
+        m_job.reset();
+    }
+    m_preparing = false;
+    Close();
+}
+
+void SoundStream::Close() {
+    if (m_converter != nullptr) {
+        SDL_FreeAudioStream(m_converter);
+        m_converter = nullptr;
+        if (GetUnderruns() > 0) SDL_Log("SoundStream - '%s' : %d sous-alimentation(s) de l'anneau.", m_source.c_str(), GetUnderruns());
+    }
+    CloseSource();
+}
+
+void SoundStream::SetVolume(int volume) {
+    if (m_carrier != nullptr) Mix_VolumeChunk(m_carrier, volume);
+}
+
+void SoundStream::Update() {
+    if (IsBusy() || m_converter == nullptr || m_finished.load(std::memory_order_acquire)) return;
+    JobSystem* jobs = JobSystem::GetInstance();
+    // Moins d'un demi-anneau d'avance : on complète
+    if (m_decodeDone.load(std::memory_order_relaxed) || Available() > m_ring.size() / 2) return;
+    size_t limit = m_ring.size();
+    if (jobs->GetWorkerCount() == 0) {
+        Decode(limit); // Sans worker, une tâche n'avancerait que dans Wait()
+        return;
+    }
+    m_job = jobs->Schedule("sound_stream", [this, limit]() { Decode(limit); });
+}
+
+size_t SoundStream::Available() const {
+    return m_writePos.load(std::memory_order_acquire) - m_readPos.load(std::memory_order_acquire);
+}
+
+void SoundStream::Decode(size_t limit) {
+    const size_t capacity = m_ring.size();
+    size_t write = m_writePos.load(std::memory_order_relaxed);
+    while (!m_decodeDone.load(std::memory_order_relaxed)) {
+        size_t space = std::min(limit, capacity) - std::min(limit, write - m_readPos.load(std::memory_order_acquire));
+        space -= space % m_frameBytes;
+        if (space == 0) break;
+
+        // Données converties prêtes, sinon lecture d'une tranche du fichier
+        if (SDL_AudioStreamAvailable(m_converter) == 0) {
+            if (m_flushed) {
+                m_decodeDone.store(true, std::memory_order_release);
+                break;
+            }
+            int read = ReadSource();
+            if (read > 0) {
+                m_dataRead += static_cast<Uint32>(read);
+                SDL_AudioStreamPut(m_converter, m_readBuffer.data(), read);
+                continue;
+            }
+            int loops = m_loops.load(std::memory_order_relaxed);
+            if (read == 0 && loops != 0 && m_dataRead > 0) {
+                // Boucle : le fichier repart du début sans vider le convertisseur, pas de blanc à la
+                // jointure. Une seule jointure dans l'anneau : la suivante attend que la lecture
+                // ait franchi celle-ci (Update relance alors le décodage).
+                if (m_loopMark.load(std::memory_order_acquire) != NO_LOOP_MARK) break;
+                if (RewindSource()) {
+                    if (loops > 0) m_loops.compare_exchange_strong(loops, loops - 1, std::memory_order_relaxed);
+                    m_loopMark.store(write, std::memory_order_release);
+                    continue;
+                }
+            }
+            SDL_AudioStreamFlush(m_converter); // Fin du fichier : derniers échantillons du rééchantillonnage
+            m_flushed = true;
+            continue;
+        }
+        int wanted = static_cast<int>(std::min(space, m_convertBuffer.size()));
+        wanted -= wanted % m_frameBytes; // SDL_AudioStreamGet refuse les trames partielles
+        int got = SDL_AudioStreamGet(m_converter, m_convertBuffer.data(), wanted);
+        if (got <= 0) {
+            m_decodeDone.store(true, std::memory_order_release); // Erreur de conversion : fin du son
+            break;
+        }
+        size_t offset = write % capacity;
+        size_t first = std::min(static_cast<size_t>(got), capacity - offset);
+        std::memcpy(&m_ring[offset], m_convertBuffer.data(), first);
+        std::memcpy(&m_ring[0], m_convertBuffer.data() + first, got - first);
+        write += got;
+        m_writePos.store(write, std::memory_order_release);
+    }
+}
+
+void SoundStream::Effect(int /*channel*/, void* stream, int length, void* userdata) {
+    SoundStream* self = static_cast<SoundStream*>(userdata);
+    Uint8* out = static_cast<Uint8*>(stream);
+    bool looped = false;
+    size_t count = self->Read(out, static_cast<size_t>(length), &looped);
+    if (count < static_cast<size_t>(length)) std::memset(out + count, self->m_silence, length - count);
+}
+
+size_t SoundStream::Read(Uint8* out, size_t bytes, bool* looped) {
+    const size_t capacity = m_ring.size();
+    size_t read = m_readPos.load(std::memory_order_relaxed);
+    size_t available = m_writePos.load(std::memory_order_acquire) - read;
+    size_t count = std::min(available, bytes);
+
+    size_t offset = read % capacity;
+    size_t first = std::min(count, capacity - offset);
+    std::memcpy(out, &m_ring[offset], first);
+    std::memcpy(out + first, &m_ring[0], count - first);
+
+    // Jointure de boucle franchie : le décodeur peut en poser une autre
+    size_t mark = m_loopMark.load(std::memory_order_acquire);
+    *looped = mark != NO_LOOP_MARK && read + count > mark;
+    if (*looped) m_loopMark.store(NO_LOOP_MARK, std::memory_order_release);
+    m_readPos.store(read + count, std::memory_order_release);
+
+    if (count < bytes) {
+        if (m_decodeDone.load(std::memory_order_acquire)) {
+            m_finished.store(true, std::memory_order_release);
+        } else {
+            m_underruns.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    return count;
+}
+
+void SoundStream::EffectDone(int /*channel*/, void* userdata) {
+    // Canal arrêté (Mix_HaltChannel, côté mixer) : AudioManager appellera Release
+    static_cast<SoundStream*>(userdata)->m_finished.store(true, std::memory_order_release);
+}
+
+size_t SoundStream::GetMemoryBytes() const {
+    size_t wholeTrack = m_wholeTrack != nullptr ? m_wholeTrack->alen : 0;
+    return m_ring.size() + m_readBuffer.size() + m_convertBuffer.size() + m_carrierSamples.size() + wholeTrack;
+}
+
+size_t SoundStream::GetDecodedBytes() const {
+    int fileFrameBytes = (SDL_AUDIO_BITSIZE(m_fileFormat) / 8) * m_fileChannels;
+    if (fileFrameBytes == 0 || m_fileFrequency == 0) return 0;
+    Uint64 frames = static_cast<Uint64>(m_dataBytes / fileFrameBytes) * m_frequency / m_fileFrequency;
+    return static_cast<size_t>(frames * m_frameBytes);
+}
@@ -0,0 +1,123 @@
+#ifndef SOUNDSTREAM_H
+#define SOUNDSTREAM_H
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <SDL.h>
+#include <SDL_mixer.h>
+#include "../Core/JobSystem.h"
+#include "OggDecoder.h"
+
+// Lecture en flux d'un gros WAV ou d'un OGG (voir AudioManager, SOUND_STREAMED, et les musiques) :
+// seul un anneau de RING_MS millisecondes au format du mixer reste en mémoire au lieu du son
+// entier décodé. Le fichier est lu (OggDecoder pour un OGG) et converti (SDL_AudioStream) par
+// tranches sur le JobSystem ; le thread audio vide l'anneau, soit dans un effet SDL_mixer posé
+// sur un canal qui joue en boucle un bloc de silence (Attach : volume, pause et Mix_Volume
+// s'appliquent comme pour un son ordinaire), soit par Read (platines de MusicPlayer).
+// Une seule lecture à la fois. PrepareAsync/Update/Release : thread de jeu (celui qui appelle
+// AudioManager), sans jamais y lire le fichier. Attach/SetVolume/Read : côté mixer (commandes
+// d'AudioManager appliquées sur le thread audio) ; la lecture s'arrête avec son canal
+// (Mix_HaltChannel, côté mixer aussi) ou sa platine. PrepareAsync n'est permis qu'une fois la
+// lecture précédente arrêtée : plus rien ne lit l'anneau.
+class SoundStream
+{
+public:
+    SoundStream(const std::string& source, int frequency, Uint16 format, int channels);
+    ~SoundStream();
+
+    // Lit l'en-tête du WAV ou de l'OGG. Faux si le fichier manque ou si son format n'est pas
+    // lisible en flux. wholeTrack : OGG sans libvorbisfile (OggDecoder::IsAvailable) décodé en
+    // entier par SDL_mixer (Mix_LoadWAV_RW) puis relu depuis la mémoire, pour que les musiques
+    // jouent quand même ; sinon échec (AudioManager se rabat alors sur SOUND_LAZY).
+    bool Open(std::string* error, bool wholeTrack = false);
+    // Sur un worker, après le décodage en cours sans l'attendre : ferme la lecture précédente,
+    // lit les en-têtes au premier appel (Open), rouvre le fichier et remplit le début de l'anneau.
+    // Sans worker, tout de suite. Prêt pour Attach ou Read quand IsPreparing devient faux, si
+    // IsReady. loops : boucles après la première lecture, -1 sans fin.
+    void PrepareAsync(int loops);
+    bool IsPreparing();
+    bool IsBusy(); // Préparation ou décodage en cours sur un worker : Release attendrait
+    inline bool IsReady() const { return m_converter != nullptr; }
+    inline const std::string& GetError() const { return m_error; } // Échec de PrepareAsync
+    // Boucles restantes, avant la lecture : celles déjà décodées dans l'anneau ne sont pas reprises
+    void SetLoops(int loops);
+    // Joue le bloc de silence sur le canal donné et y pose l'effet
+    bool Attach(int channel, int volume);
+    void SetVolume(int volume);
+    // Thread audio, sans Attach : copie au plus bytes octets de l'anneau dans out (le reste est à
+    // l'appelant). looped : la lecture a franchi le retour au début d'une boucle.
+    size_t Read(Uint8* out, size_t bytes, bool* looped);
+    // Chaque image pendant la lecture : relance le décodage quand l'anneau se vide
+    void Update();
+    // Canal arrêté : attend le décodage en cours, ferme le fichier (sans attente si !IsBusy)
+    void Release();
+
+    // Anneau vidé après la fin du fichier (et des boucles), ou canal arrêté : le canal peut être rendu
+    inline bool IsFinished() const { return m_finished.load(std::memory_order_acquire); }
+    inline int GetUnderruns() const { return m_underruns.load(std::memory_order_relaxed); }
+    // Mémoire occupée (anneau, tampons de lecture, silence) et taille du son entier décodé
+    size_t GetMemoryBytes() const;
+    size_t GetDecodedBytes() const;
+
+    static const Uint32 RING_MS = 500;
+    static const Uint32 PREFILL_MS = 100;   // Décodé par Play avant le démarrage du canal
+    static const int READ_BYTES = 16384;    // Lecture disque par tranche
+    static const size_t NO_LOOP_MARK = static_cast<size_t>(-1);
+
+private:
+    static void Effect(int channel, void* stream, int length, void* userdata); // Thread audio
+    static void EffectDone(int channel, void* userdata);
+    bool OpenWave(SDL_RWops* rw, std::string* error);
+    bool Start(int loops);      // Rouvre le fichier et remplit le début de l'anneau
+    void Close();               // Libère le convertisseur et ferme le fichier
+    bool RewindSource();        // Retour au début des données, fichier rouvert si besoin
+    int ReadSource();           // Tranche suivante dans m_readBuffer : octets, 0 à la fin, -1 sur erreur
+    void CloseSource();
+    void Decode(size_t limit); // Worker : remplit l'anneau jusqu'à limit octets disponibles
+    size_t Available() const;
+
+    std::string m_source;
+    // Format de sortie du mixer
+    int m_frequency;
+    Uint16 m_format;
+    int m_channels;
+    int m_frameBytes;
+
+    // Format du fichier, lu par Open
+    SDL_AudioFormat m_fileFormat = 0;
+    int m_fileChannels = 0;
+    int m_fileFrequency = 0;
+    Sint64 m_dataOffset = 0;
+    Uint32 m_dataBytes = 0;      // Données PCM du WAV ; pour un OGG, taille une fois décodé
+    bool m_ogg = false;
+    Mix_Chunk* m_wholeTrack = nullptr; // Repli de Open (wholeTrack), au format du mixer
+
+    // Côté décodage : thread de jeu à l'arrêt, worker (m_job) pendant la préparation et la lecture
+    SDL_RWops* m_file = nullptr; // WAV
+    OggDecoder m_decoder;        // OGG
+    SDL_AudioStream* m_converter = nullptr;
+    Uint32 m_dataRead = 0;       // Octets lus depuis le début du fichier ou de la boucle
+    bool m_flushed = false;
+    std::vector<Uint8> m_readBuffer;
+    std::vector<Uint8> m_convertBuffer;
+    JobSystem::JobHandle m_job;
+    bool m_preparing = false;
+    std::string m_error;
+
+    // Anneau : le worker écrit, le thread audio lit
+    std::vector<Uint8> m_ring;
+    std::atomic<size_t> m_readPos;
+    std::atomic<size_t> m_writePos;
+    std::atomic<size_t> m_loopMark; // Position du début de la boucle suivante, NO_LOOP_MARK sinon
+    std::atomic<int> m_loops;       // Boucles restantes, -1 sans fin
+    std::atomic<bool> m_decodeDone;
+    std::atomic<bool> m_finished; // Anneau vidé après la fin du fichier, ou canal arrêté de l'extérieur
+    std::atomic<int> m_underruns;
+    Uint8 m_silence = 0;
+
+    std::vector<Uint8> m_carrierSamples; // Silence joué en boucle par le canal
+    Mix_Chunk* m_carrier = nullptr;
+};
+
+#endif // SOUNDSTREAM_H
@@ -0,0 +1,43 @@
+#include "AssetPack.h"
+#include <algorithm>
+#include <cstring>
+
+AssetPack* AssetPack::s_Instance = nullptr;
+
+#ifdef GAME_EMBED_ASSETS
+const EmbeddedAsset* AssetPack::FindEmbedded(const std::string& path) const {
+    // La table est triée par le générateur : recherche dichotomique, pas d'index à construire.
+    const EmbeddedAsset* first = g_EmbeddedAssets;
+    const EmbeddedAsset* last = g_EmbeddedAssets + g_EmbeddedAssetCount;
+    const EmbeddedAsset* it = std::lower_bound(first, last, path.c_str(),
+        [](const EmbeddedAsset& asset, const char* key) { return std::strcmp(asset.path, key) < 0; });
+    if (it != last && std::strcmp(it->path, path.c_str()) == 0) {
+        return it;
+    }
+    return nullptr;
+}
+#endif
+
+SDL_RWops* AssetPack::Open(const std::string& path) {
+#ifdef GAME_EMBED_ASSETS
+    const EmbeddedAsset* asset = FindEmbedded(path);
+    if (asset == nullptr) {
+        SDL_SetError("Asset '%s' absent de l'executable", path.c_str());
+        return nullptr;
+    }
+    return SDL_RWFromConstMem(asset->data, static_cast<int>(asset->size));
+#else
+    return SDL_RWFromFile(path.c_str(), "rb");
+#endif
+}
+
+bool AssetPack::Exists(const std::string& path) {
+#ifdef GAME_EMBED_ASSETS
+    return FindEmbedded(path) != nullptr;
+#else
+    SDL_RWops* rw = SDL_RWFromFile(path.c_str(), "rb");
+    if (rw == nullptr) return false;
+    SDL_RWclose(rw);
+    return true;
+#endif
+}
@@ -0,0 +1,53 @@
+#ifndef ASSETPACK_H
+#define ASSETPACK_H
+
+#include <string>
+#include "SDL.h"
+
+// Point d'accès unique aux fichiers du dossier assets/.
+// En build normal, Open() ouvre le fichier sur le disque.
+// En build "binaire unique" (GAME_EMBED_ASSETS), les assets sont liés dans l'exécutable
+// par tools/AssetEmbedder.cpp et Open() renvoie un SDL_RWFromConstMem sur ces données :
+// aucun open() ni parcours de dossier au démarrage, les pages sont chargées à la demande.
+
+#ifdef GAME_EMBED_ASSETS
+// Table générée (triée par chemin) par tools/AssetEmbedder.cpp dans embedded_assets.S
+struct EmbeddedAsset {
+    const char* path;
+    const unsigned char* data;
+    unsigned long long size;
+};
+extern "C" const EmbeddedAsset g_EmbeddedAssets[];
+extern "C" const unsigned long long g_EmbeddedAssetCount;
+#endif
+
+class AssetPack
+{
+public:
+    static AssetPack* GetInstance()
+    {
+        return s_Instance = (s_Instance != nullptr) ? s_Instance : new AssetPack();
+    }
+
+    // Renvoie un flux en lecture sur l'asset (à fermer par l'appelant ou via freesrc=1), nullptr si absent.
+    SDL_RWops* Open(const std::string& path);
+    bool Exists(const std::string& path);
+
+    inline bool IsEmbedded() const {
+#ifdef GAME_EMBED_ASSETS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+private:
+    AssetPack() {}
+    static AssetPack* s_Instance;
+
+#ifdef GAME_EMBED_ASSETS
+    const EmbeddedAsset* FindEmbedded(const std::string& path) const;
+#endif
+};
+
+#endif // ASSETPACK_H
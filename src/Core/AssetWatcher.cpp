@@ -0,0 +1,247 @@
+#include "AssetWatcher.h"
+#include <algorithm>
+#include "AssetPack.h"
+#include "../Audio/AudioManager.h"
+#include "../Graphics/TexturePreloader.h"
+
+#ifdef __linux__
+#include <dirent.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+AssetWatcher* AssetWatcher::s_Instance = nullptr;
+const Uint32 AssetWatcher::SETTLE_MS;
+
+namespace {
+
+std::string Extension(const std::string& path) {
+    size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos || path.find('/', dot) != std::string::npos) return std::string();
+    std::string extension = path.substr(dot + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    return extension;
+}
+
+} // namespace
+
+bool AssetWatcher::Start(const std::string& directory) {
+    if (AssetPack::GetInstance()->IsEmbedded()) {
+        SDL_Log("AssetWatcher::Start - Assets integres a l'executable : rechargement a chaud desactive.");
+        return false;
+    }
+#ifdef __linux__
+    m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_fd < 0) {
+        SDL_Log("AssetWatcher::Start - ECHEC: inotify_init1 : %s", std::strerror(errno));
+        return false;
+    }
+    AddWatch(directory);
+    if (m_directories.empty()) {
+        Stop();
+        return false;
+    }
+    SDL_Log("AssetWatcher::Start - Rechargement a chaud actif sur '%s' (%zu dossier(s)).", directory.c_str(), m_directories.size());
+    return true;
+#else
+    SDL_Log("AssetWatcher::Start - Rechargement a chaud disponible sous Linux seulement (inotify).");
+    return false;
+#endif
+}
+
+void AssetWatcher::AddWatch(const std::string& directory) {
+#ifdef __linux__
+    // Nouveaux dossiers suivis aussi : un export peut créer une arborescence entière.
+    int wd = inotify_add_watch(m_fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR);
+    if (wd < 0) {
+        SDL_Log("AssetWatcher::AddWatch - ECHEC: '%s' : %s", directory.c_str(), std::strerror(errno));
+        return;
+    }
+    m_directories[wd] = directory;
+
+    DIR* dir = opendir(directory.c_str());
+    if (dir == nullptr) return;
+    while (dirent* entry = readdir(dir)) {
+        if (entry->d_name[0] == '.') continue;
+        std::string path = directory + "/" + entry->d_name;
+        if (entry->d_type == DT_DIR) AddWatch(path);
+    }
+    closedir(dir);
+#endif
+}
+
+void AssetWatcher::ReadEvents() {
+#ifdef __linux__
+    alignas(inotify_event) char buffer[4096];
+    for (;;) {
+        ssize_t length = read(m_fd, buffer, sizeof(buffer));
+        if (length <= 0) break; // EAGAIN : plus rien à lire
+        for (char* cursor = buffer; cursor < buffer + length; ) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(cursor);
+            cursor += sizeof(inotify_event) + event->len;
+            auto dir = m_directories.find(event->wd);
+            if (dir == m_directories.end() || event->len == 0) continue;
+            std::string path = dir->second + "/" + event->name;
+            if (event->mask & IN_ISDIR) {
+                if (event->mask & (IN_CREATE | IN_MOVED_TO)) AddWatch(path);
+            } else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+                m_changed[path] = SDL_GetTicks();
+            }
+        }
+    }
+#endif
+}
+
+int AssetWatcher::Poll() {
+    if (!IsActive()) return 0;
+    ReadEvents();
+
+    Uint32 now = SDL_GetTicks();
+    for (auto it = m_changed.begin(); it != m_changed.end(); ) {
+        // Fichier encore en cours de décodage : sa nouvelle version sera relue ensuite.
+        if (now - it->second < SETTLE_MS || IsDecoding(it->first)) {
+            ++it;
+            continue;
+        }
+        Schedule(it->first);
+        it = m_changed.erase(it);
+    }
+
+    // Échange en début d'image : la texture est remplacée avant tout dessin qui l'utilise.
+    JobSystem* jobs = JobSystem::GetInstance();
+    int swapped = 0;
+    for (auto it = m_decoding.begin(); it != m_decoding.end(); ) {
+        ReloadPtr reload = *it;
+        if (jobs->GetWorkerCount() == 0) jobs->Wait(reload->job); // Sans worker, rien ne progresse ailleurs
+        if (!jobs->IsDone(reload->job)) {
+            ++it;
+            continue;
+        }
+        it = m_decoding.erase(it);
+        if (!reload->error.empty()) {
+            SDL_Log("AssetWatcher::Poll - ECHEC: rechargement de '%s' : %s", reload->path.c_str(), reload->error.c_str());
+            FreeReload(*reload);
+        } else if (reload->kind == ASSET_TEXTURE) {
+            SwapTexture(*reload);
+            ++swapped;
+        } else {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_sounds.push_back(reload);
+        }
+    }
+    return swapped;
+}
+
+void AssetWatcher::Schedule(const std::string& path) {
+    ReloadPtr reload = std::make_shared<Reload>();
+    reload->path = path;
+    std::string extension = Extension(path);
+    if (extension == "wav") {
+        reload->kind = ASSET_SOUND;
+        reload->ids = AudioManager::GetInstance()->GetSoundIds(path);
+    } else if (extension == "png" || extension == "jpg" || extension == "jpeg" || extension == "bmp") {
+        reload->kind = ASSET_TEXTURE;
+        reload->ids = TextureManager::GetInstance()->GetIdsForFile(path);
+    }
+    if (reload->ids.empty()) return; // Pas (encore) chargé : le prochain chargement lira la nouvelle version
+
+    Reload* target = reload.get();
+    reload->job = JobSystem::GetInstance()->Schedule("asset_reload", [target]() {
+        if (target->kind == ASSET_TEXTURE) {
+            target->surface = TextureManager::GetInstance()->LoadPrepared(target->path, &target->info, &target->error);
+        } else {
+            AudioManager::GetInstance()->DecodeSound(target->path, &target->samples, &target->length, &target->error);
+        }
+    });
+    m_decoding.push_back(reload);
+    SDL_Log("AssetWatcher::Schedule - '%s' modifie, rechargement.", path.c_str());
+}
+
+bool AssetWatcher::IsDecoding(const std::string& path) const {
+    for (const ReloadPtr& reload : m_decoding) {
+        if (reload->path == path) return true;
+    }
+    return false;
+}
+
+void AssetWatcher::SwapTexture(Reload& reload) {
+    TextureManager* textures = TextureManager::GetInstance();
+    for (size_t i = 0; i < reload.ids.size(); ++i) {
+        const std::string& id = reload.ids[i];
+        const TextureInfo* previous = textures->GetTextureInfo(id);
+        bool resized = previous != nullptr && (previous->width != reload.info.width || previous->height != reload.info.height);
+
+        // Un même fichier peut servir à plusieurs identifiants (niveaux) : copie sauf pour le dernier.
+        SDL_Surface* surface = reload.surface;
+        if (i + 1 < reload.ids.size()) surface = SDL_ConvertSurface(reload.surface, reload.surface->format, 0);
+        if (surface == nullptr) {
+            SDL_Log("AssetWatcher::SwapTexture - ECHEC: copie pour '%s' : %s", id.c_str(), SDL_GetError());
+            continue;
+        }
+        if (!textures->Replace(id, surface, reload.info)) continue;
+        TexturePreloader::GetInstance()->UpdateSize(id, reload.info);
+        if (resized) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_resized.push_back({ id, reload.info.width, reload.info.height });
+        }
+    }
+    reload.surface = nullptr; // Reprise par Replace
+}
+
+void AssetWatcher::SwapSounds() {
+    std::vector<ReloadPtr> sounds;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        sounds.swap(m_sounds);
+    }
+    AudioManager* audio = AudioManager::GetInstance();
+    for (const ReloadPtr& reload : sounds) {
+        for (size_t i = 0; i < reload->ids.size(); ++i) {
+            // Le Mix_Chunk prend possession des échantillons : copie sauf pour le dernier.
+            Uint8* samples = reload->samples;
+            if (i + 1 < reload->ids.size()) {
+                samples = static_cast<Uint8*>(SDL_malloc(reload->length));
+                if (samples == nullptr) continue;
+                SDL_memcpy(samples, reload->samples, reload->length);
+            }
+            audio->ReplaceSound(reload->ids[i], samples, reload->length);
+        }
+        reload->samples = nullptr;
+    }
+}
+
+std::vector<ResizedTexture> AssetWatcher::TakeResized() {
+    std::vector<ResizedTexture> resized;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    resized.swap(m_resized);
+    return resized;
+}
+
+void AssetWatcher::FreeReload(Reload& reload) {
+    if (reload.surface != nullptr) SDL_FreeSurface(reload.surface);
+    if (reload.samples != nullptr) SDL_free(reload.samples);
+    reload.surface = nullptr;
+    reload.samples = nullptr;
+}
+
+void AssetWatcher::Stop() {
+    for (const ReloadPtr& reload : m_decoding) {
+        JobSystem::GetInstance()->Wait(reload->job);
+        FreeReload(*reload);
+    }
+    m_decoding.clear();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const ReloadPtr& reload : m_sounds) FreeReload(*reload);
+        m_sounds.clear();
+        m_resized.clear();
+    }
+    m_changed.clear();
+    m_directories.clear();
+#ifdef __linux__
+    if (m_fd >= 0) close(m_fd);
+#endif
+    m_fd = -1;
+}
@@ -0,0 +1,91 @@
+#ifndef ASSETWATCHER_H
+#define ASSETWATCHER_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "SDL.h"
+#include "JobSystem.h"
+#include "../Graphics/TextureManager.h"
+
+// Nouvelle taille logique d'une texture rechargée (voir AssetWatcher::TakeResized)
+struct ResizedTexture
+{
+    std::string id;
+    int width;
+    int height;
+};
+
+// Rechargement à chaud des assets en développement (--hot-reload) : surveille le dossier des
+// assets avec inotify (Linux seulement, sans effet ailleurs et avec GAME_EMBED_ASSETS).
+// Seuls les fichiers modifiés sont relus, décodés sur le JobSystem, puis échangés sous le même
+// identifiant en début d'image : textures par Poll() sur le thread de rendu, sons par
+// SwapSounds() sur le thread de simulation (celui qui les joue). Les musiques ne sont pas
+// rechargées (flux ouvert pendant la lecture).
+class AssetWatcher
+{
+public:
+    static AssetWatcher* GetInstance()
+    {
+        return s_Instance = (s_Instance != nullptr) ? s_Instance : new AssetWatcher();
+    }
+
+    // Après le chargement des textures et des sons. Faux si la surveillance est impossible.
+    bool Start(const std::string& directory);
+    inline bool IsActive() const { return m_fd >= 0; }
+
+    // Thread de rendu : lit les changements, lance les décodages et remplace les textures
+    // décodées. Renvoie le nombre de textures remplacées (calques à recomposer).
+    int Poll();
+    // Thread de simulation : remplace les sons décodés
+    void SwapSounds();
+    // Thread de simulation : textures dont la taille a changé depuis le dernier appel
+    std::vector<ResizedTexture> TakeResized();
+    void Stop(); // Attend les décodages en cours
+
+    // Délai entre la dernière écriture d'un fichier et son rechargement : un éditeur ou un
+    // export écrit souvent un fichier en plusieurs fois.
+    static const Uint32 SETTLE_MS = 150;
+
+private:
+    AssetWatcher() {}
+    static AssetWatcher* s_Instance;
+
+    enum AssetKind { ASSET_TEXTURE, ASSET_SOUND };
+
+    struct Reload
+    {
+        AssetKind kind;
+        std::string path;
+        std::vector<std::string> ids;
+        // Texture : surface préparée (voir TextureManager::LoadPrepared)
+        SDL_Surface* surface = nullptr;
+        TextureInfo info;
+        // Son : échantillons au format du mixer (voir AudioManager::DecodeSound)
+        Uint8* samples = nullptr;
+        Uint32 length = 0;
+        std::string error;
+        JobSystem::JobHandle job;
+    };
+    typedef std::shared_ptr<Reload> ReloadPtr;
+
+    void ReadEvents();
+    void AddWatch(const std::string& directory);
+    void Schedule(const std::string& path);
+    bool IsDecoding(const std::string& path) const;
+    void SwapTexture(Reload& reload);
+    static void FreeReload(Reload& reload);
+
+    int m_fd = -1;
+    std::map<int, std::string> m_directories; // Descripteur inotify -> dossier surveillé
+    std::map<std::string, Uint32> m_changed;  // Fichier modifié -> SDL_GetTicks de la dernière écriture
+    std::vector<ReloadPtr> m_decoding;        // Thread de rendu seulement
+
+    std::mutex m_mutex; // Protège ce qui suit, échangé avec la simulation
+    std::vector<ReloadPtr> m_sounds;
+    std::vector<ResizedTexture> m_resized;
+};
+
+#endif // ASSETWATCHER_H
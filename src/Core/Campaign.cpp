@@ -0,0 +1,182 @@
+#include "Campaign.h"
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+#include "AssetPack.h"
+
+Campaign* Campaign::s_Instance = nullptr;
+
+namespace {
+
+std::string Trim(const std::string& text) {
+    const char* spaces = " \t\r\n";
+    size_t begin = text.find_first_not_of(spaces);
+    if (begin == std::string::npos) return std::string();
+    size_t end = text.find_last_not_of(spaces);
+    return text.substr(begin, end - begin + 1);
+}
+
+bool ParseFloat(const std::string& value, float& out) {
+    char* end = nullptr;
+    float parsed = std::strtof(value.c_str(), &end);
+    if (end == value.c_str() || *end != '\0') return false;
+    out = parsed;
+    return true;
+}
+
+bool ParseInt(const std::string& value, int& out) {
+    char* end = nullptr;
+    long parsed = std::strtol(value.c_str(), &end, 10);
+    if (end == value.c_str() || *end != '\0') return false;
+    out = static_cast<int>(parsed);
+    return true;
+}
+
+} // namespace
+
+bool Campaign::Load(const std::string& campaignFile) {
+    m_levels.clear();
+    std::string text;
+    if (ReadText(campaignFile, text)) {
+        std::istringstream lines(text);
+        std::string line;
+        while (std::getline(lines, line)) {
+            line = Trim(line);
+            if (line.empty() || line[0] == '#') continue;
+            LevelDef level;
+            if (LoadLevel(line, level)) m_levels.push_back(level);
+        }
+    }
+
+    if (m_levels.empty()) {
+        SDL_Log("Campaign::Load - Attention: aucun niveau lu dans '%s', course d'origine seule.", campaignFile.c_str());
+        LevelDef level;
+        level.name = "Marrakech";
+        level.background = "assets/Background1.png";
+        level.track = "assets/Track.png";
+        for (int i = 1; i <= 4; ++i) level.obstacles.push_back("assets/obstacle" + std::to_string(i) + ".png");
+        m_levels.push_back(level);
+        return false;
+    }
+    SDL_Log("Campaign::Load - %d niveau(x) charge(s) depuis '%s'.", GetLevelCount(), campaignFile.c_str());
+    return true;
+}
+
+std::string Campaign::GetGroupName(int index) {
+    return "level" + std::to_string(index + 1);
+}
+
+std::string Campaign::GetBackgroundId(int index) {
+    return GetGroupName(index) + "_background";
+}
+
+std::string Campaign::GetTrackId(int index) {
+    return GetGroupName(index) + "_track";
+}
+
+std::string Campaign::GetObstacleId(int index, int obstacle) {
+    return GetGroupName(index) + "_obstacle" + std::to_string(obstacle + 1);
+}
+
+TextureList Campaign::GetTextures(int index) const {
+    const LevelDef& level = m_levels[index];
+    TextureList textures;
+    textures.push_back({ GetBackgroundId(index), level.background });
+    textures.push_back({ GetTrackId(index), level.track });
+    for (size_t i = 0; i < level.obstacles.size(); ++i) {
+        textures.push_back({ GetObstacleId(index, static_cast<int>(i)), level.obstacles[i], true });
+    }
+    return textures;
+}
+
+bool Campaign::LoadLevel(const std::string& path, LevelDef& level) const {
+    std::string text;
+    if (!ReadText(path, text)) return false;
+
+    std::istringstream lines(text);
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(lines, line)) {
+        ++lineNumber;
+        line = Trim(line);
+        if (line.empty() || line[0] == '#') continue;
+        size_t equal = line.find('=');
+        if (equal == std::string::npos) {
+            SDL_Log("Campaign::LoadLevel - %s:%d : 'cle = valeur' attendu.", path.c_str(), lineNumber);
+            continue;
+        }
+        std::string key = Trim(line.substr(0, equal));
+        std::string value = Trim(line.substr(equal + 1));
+
+        // Valeur lue dans un temporaire : une valeur invalide laisse celle par défaut
+        bool valid = true;
+        float number = 0.0f;
+        int integer = 0;
+        if (key == "name") {
+            level.name = value;
+        } else if (key == "background") {
+            level.background = value;
+        } else if (key == "track") {
+            level.track = value;
+        } else if (key == "obstacles") {
+            std::istringstream list(value);
+            std::string obstacle;
+            while (std::getline(list, obstacle, ',')) {
+                obstacle = Trim(obstacle);
+                if (!obstacle.empty()) level.obstacles.push_back(obstacle);
+            }
+        } else if (key == "distance") {
+            valid = ParseFloat(value, number) && number > 0.0f;
+            if (valid) level.distance = number;
+        } else if (key == "duration") {
+            valid = ParseInt(value, integer) && integer > 0;
+            if (valid) level.duration = std::min(integer, 60);
+        } else if (key == "spawn_interval") {
+            valid = ParseFloat(value, number) && number > 0.0f;
+            if (valid) level.spawnInterval = number;
+        } else if (key == "min_spawn_interval") {
+            valid = ParseFloat(value, number) && number > 0.0f;
+            if (valid) level.minSpawnInterval = number;
+        } else if (key == "spawn_reduction") {
+            valid = ParseFloat(value, number) && number >= 0.0f;
+            if (valid) level.spawnReduction = number;
+        } else if (key == "difficulty_interval") {
+            valid = ParseFloat(value, number) && number > 0.0f;
+            if (valid) level.difficultyInterval = number;
+        } else if (key == "double_spawn_chance") {
+            valid = ParseInt(value, integer);
+            if (valid) level.doubleSpawnChance = std::max(0, std::min(integer, 100));
+        } else if (key == "max_speed_increase") {
+            valid = ParseFloat(value, number) && number >= 0.0f;
+            if (valid) level.maxSpeedIncrease = number;
+        } else {
+            SDL_Log("Campaign::LoadLevel - %s:%d : cle inconnue '%s'.", path.c_str(), lineNumber, key.c_str());
+        }
+        if (!valid) {
+            SDL_Log("Campaign::LoadLevel - %s:%d : valeur invalide pour '%s' : '%s'.", path.c_str(), lineNumber, key.c_str(), value.c_str());
+        }
+    }
+
+    if (level.background.empty() || level.track.empty() || level.obstacles.empty()) {
+        SDL_Log("Campaign::LoadLevel - ECHEC: %s : background, track et obstacles sont obligatoires.", path.c_str());
+        return false;
+    }
+    if (level.name.empty()) level.name = path;
+    SDL_Log("Campaign::LoadLevel - Niveau '%s' : %.0f m en %d s, %zu obstacle(s).",
+            level.name.c_str(), level.distance / 10.0f, level.duration, level.obstacles.size());
+    return true;
+}
+
+bool Campaign::ReadText(const std::string& path, std::string& text) {
+    SDL_RWops* rw = AssetPack::GetInstance()->Open(path);
+    if (rw == nullptr) {
+        SDL_Log("Campaign::ReadText - ECHEC: ouverture de '%s' : %s", path.c_str(), SDL_GetError());
+        return false;
+    }
+    Sint64 size = SDL_RWsize(rw);
+    text.assign(size > 0 ? static_cast<size_t>(size) : 0, '\0');
+    size_t read = size > 0 ? SDL_RWread(rw, &text[0], 1, text.size()) : 0;
+    SDL_RWclose(rw);
+    text.resize(read);
+    return true;
+}
@@ -0,0 +1,60 @@
+#ifndef CAMPAIGN_H
+#define CAMPAIGN_H
+
+#include <string>
+#include <vector>
+#include "../Graphics/TexturePreloader.h"
+
+// Un quartier de la campagne, lu dans un fichier de niveau (voir assets/levels)
+struct LevelDef
+{
+    std::string name;
+    std::string background;
+    std::string track;
+    std::vector<std::string> obstacles; // Chemins ; il suffit qu'un seul se charge
+    float distance = 40000.0f;          // Ligne d'arrivée
+    int duration = 60;                  // Secondes, 60 au plus (textures du minuteur)
+    float spawnInterval = 2.3f;         // Courbe de difficulté : intervalle initial entre obstacles,
+    float minSpawnInterval = 0.55f;     // plancher,
+    float spawnReduction = 0.18f;       // réduction à chaque palier,
+    double difficultyInterval = 6.0;    // durée d'un palier en secondes
+    int doubleSpawnChance = 40;         // % de chances d'un obstacle double
+    float maxSpeedIncrease = 20.0f;     // Gain de vitesse max par seconde
+};
+
+// Niveaux de la campagne, dans l'ordre. Chargés une fois au lancement puis en lecture seule :
+// utilisables depuis la simulation comme depuis le rendu.
+// Les textures d'un niveau forment un groupe du TexturePreloader ("level<N>") avec des
+// identifiants propres au niveau, pour que le suivant se charge pendant que l'actuel s'affiche.
+class Campaign
+{
+public:
+    static Campaign* GetInstance()
+    {
+        return s_Instance = (s_Instance != nullptr) ? s_Instance : new Campaign();
+    }
+
+    // Fichier listant un fichier de niveau par ligne. En cas d'échec, la course d'origine
+    // sert de niveau unique.
+    bool Load(const std::string& campaignFile);
+    inline int GetLevelCount() const { return static_cast<int>(m_levels.size()); }
+    inline const LevelDef& GetLevel(int index) const { return m_levels[index]; }
+    inline bool IsLastLevel(int index) const { return index + 1 >= GetLevelCount(); }
+
+    static std::string GetGroupName(int index);
+    static std::string GetBackgroundId(int index);
+    static std::string GetTrackId(int index);
+    static std::string GetObstacleId(int index, int obstacle);
+    TextureList GetTextures(int index) const;
+
+private:
+    Campaign() {}
+    static Campaign* s_Instance;
+
+    bool LoadLevel(const std::string& path, LevelDef& level) const;
+    static bool ReadText(const std::string& path, std::string& text);
+
+    std::vector<LevelDef> m_levels;
+};
+
+#endif // CAMPAIGN_H
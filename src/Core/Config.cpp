@@ -0,0 +1,142 @@
+#include "Config.h"
+#include <cstdlib>
+#include <cstring>
+#include "SDL.h"
+
+static bool ReadFloatArg(int argc, char** argv, int& i, float& out) {
+    if (i + 1 >= argc) {
+        SDL_Log("ParseCommandLine - ECHEC: valeur manquante pour '%s'", argv[i]);
+        return false;
+    }
+    char* end = nullptr;
+    float value = std::strtof(argv[i + 1], &end);
+    if (end == argv[i + 1] || *end != '\0') {
+        SDL_Log("ParseCommandLine - ECHEC: valeur invalide '%s' pour '%s'", argv[i + 1], argv[i]);
+        return false;
+    }
+    out = value;
+    ++i;
+    return true;
+}
+
+static bool ReadIntArg(int argc, char** argv, int& i, int& out) {
+    if (i + 1 >= argc) {
+        SDL_Log("ParseCommandLine - ECHEC: valeur manquante pour '%s'", argv[i]);
+        return false;
+    }
+    char* end = nullptr;
+    long value = std::strtol(argv[i + 1], &end, 10);
+    if (end == argv[i + 1] || *end != '\0') {
+        SDL_Log("ParseCommandLine - ECHEC: valeur invalide '%s' pour '%s'", argv[i + 1], argv[i]);
+        return false;
+    }
+    out = static_cast<int>(value);
+    ++i;
+    return true;
+}
+
+bool ParseCommandLine(int argc, char** argv, EngineConfig& config) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--dynamic-resolution") == 0) {
+            config.dynamicResolution = true;
+        } else if (std::strcmp(arg, "--target-frame-ms") == 0) {
+            if (!ReadFloatArg(argc, argv, i, config.targetFrameMs)) return false;
+        } else if (std::strcmp(arg, "--min-render-scale") == 0) {
+            if (!ReadFloatArg(argc, argv, i, config.minRenderScale)) return false;
+            if (config.minRenderScale < 0.25f) config.minRenderScale = 0.25f;
+            if (config.minRenderScale > 1.0f) config.minRenderScale = 1.0f;
+        } else if (std::strcmp(arg, "--fps") == 0) {
+            if (!ReadIntArg(argc, argv, i, config.targetFps)) return false;
+            if (config.targetFps < 0) config.targetFps = 0;
+        } else if (std::strcmp(arg, "--low-latency") == 0) {
+            config.lowLatency = true;
+        } else if (std::strcmp(arg, "--audio-rate") == 0) {
+            if (!ReadIntArg(argc, argv, i, config.audioFrequency)) return false;
+            if (config.audioFrequency < 8000) config.audioFrequency = 8000;
+            if (config.audioFrequency > 192000) config.audioFrequency = 192000;
+        } else if (std::strcmp(arg, "--audio-buffer") == 0) {
+            if (!ReadIntArg(argc, argv, i, config.audioBuffer)) return false;
+            int samples = 64; // Puissance de deux immédiatement supérieure, entre 64 et 8192
+            while (samples < config.audioBuffer && samples < 8192) samples *= 2;
+            config.audioBuffer = samples;
+        } else if (std::strcmp(arg, "--audio-adaptive") == 0) {
+            config.audioAdaptive = true;
+        } else if (std::strcmp(arg, "--music-fade") == 0) {
+            if (!ReadIntArg(argc, argv, i, config.musicFadeMs)) return false;
+            if (config.musicFadeMs < 0) config.musicFadeMs = 0;
+            if (config.musicFadeMs > 10000) config.musicFadeMs = 10000;
+        } else if (std::strcmp(arg, "--job-threads") == 0) {
+            if (!ReadIntArg(argc, argv, i, config.jobThreads)) return false;
+            if (config.jobThreads < 0) config.jobThreads = 0;
+        } else if (std::strcmp(arg, "--sim-thread") == 0) {
+            config.simThread = true;
+        } else if (std::strcmp(arg, "--sim-hz") == 0) {
+            if (!ReadIntArg(argc, argv, i, config.simHz)) return false;
+            if (config.simHz < 30) config.simHz = 30;
+            if (config.simHz > 1000) config.simHz = 1000;
+        } else if (std::strcmp(arg, "--level") == 0) {
+            if (!ReadIntArg(argc, argv, i, config.startLevel)) return false;
+            config.startLevel = config.startLevel > 1 ? config.startLevel - 1 : 0; // Borné au nombre de niveaux par Engine
+        } else if (std::strcmp(arg, "--hot-reload") == 0) {
+            config.hotReload = true;
+        } else if (std::strcmp(arg, "--time-scale") == 0) {
+            if (!ReadFloatArg(argc, argv, i, config.timeScale)) return false;
+            if (config.timeScale < 0.1f) config.timeScale = 0.1f;
+            if (config.timeScale > 4.0f) config.timeScale = 4.0f;
+        } else if (std::strcmp(arg, "--no-focus-pause") == 0) {
+            config.pauseOnFocusLoss = false;
+        } else if (std::strcmp(arg, "--soft-raster") == 0) {
+            config.softRaster = true;
+        } else if (std::strcmp(arg, "--raster-threads") == 0) {
+            if (!ReadIntArg(argc, argv, i, config.rasterThreads)) return false;
+            if (config.rasterThreads < 0) config.rasterThreads = 0;
+            if (config.rasterThreads > 8) config.rasterThreads = 8;
+        } else if (std::strcmp(arg, "--render-heatmap") == 0) {
+            config.renderHeatmap = true;
+        } else if (std::strcmp(arg, "--premultiply-alpha") == 0) {
+            config.premultiplyAlpha = true;
+        } else if (std::strcmp(arg, "--capture-every") == 0) {
+            if (!ReadIntArg(argc, argv, i, config.captureEvery)) return false;
+        } else if (std::strcmp(arg, "--capture-from") == 0) {
+            if (!ReadIntArg(argc, argv, i, config.captureFirst)) return false;
+        } else if (std::strcmp(arg, "--capture-to") == 0) {
+            if (!ReadIntArg(argc, argv, i, config.captureLast)) return false;
+            if (config.captureFirst < 0) config.captureFirst = 0;
+        } else if (std::strcmp(arg, "--capture-dir") == 0 || std::strcmp(arg, "--golden") == 0) {
+            if (i + 1 >= argc) {
+                SDL_Log("ParseCommandLine - ECHEC: valeur manquante pour '%s'", arg);
+                return false;
+            }
+            config.captureDir = argv[++i];
+            if (std::strcmp(arg, "--golden") == 0) config.golden = true;
+        } else if (std::strcmp(arg, "--capture-format") == 0) {
+            if (i + 1 >= argc || (std::strcmp(argv[i + 1], "png") != 0 && std::strcmp(argv[i + 1], "raw") != 0)) {
+                SDL_Log("ParseCommandLine - ECHEC: '%s' attend 'png' ou 'raw'", arg);
+                return false;
+            }
+            config.captureRaw = std::strcmp(argv[++i], "raw") == 0;
+        } else if (std::strcmp(arg, "--capture-buffers") == 0) {
+            if (!ReadIntArg(argc, argv, i, config.captureBuffers)) return false;
+            if (config.captureBuffers < 1) config.captureBuffers = 1;
+        } else if (std::strcmp(arg, "--bench") == 0) {
+            if (i + 1 >= argc) {
+                SDL_Log("ParseCommandLine - ECHEC: valeur manquante pour '%s'", arg);
+                return false;
+            }
+            config.benchmark = argv[++i];
+        } else if (std::strcmp(arg, "--audio-out") == 0) {
+            if (i + 1 >= argc) {
+                SDL_Log("ParseCommandLine - ECHEC: valeur manquante pour '%s'", arg);
+                return false;
+            }
+            config.audioRenderPath = argv[++i];
+        } else if (std::strcmp(arg, "--bench-frames") == 0) {
+            if (!ReadIntArg(argc, argv, i, config.benchmarkFrames)) return false;
+            if (config.benchmarkFrames < 1) config.benchmarkFrames = 1;
+        } else {
+            SDL_Log("ParseCommandLine - Attention: argument inconnu '%s' ignore.", arg);
+        }
+    }
+    return true;
+}
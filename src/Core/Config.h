@@ -0,0 +1,77 @@
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#include <string>
+
+// Options de lancement du moteur, renseignées depuis la ligne de commande dans main.cpp
+// puis transmises à Engine::SetConfig() avant Engine::Init().
+struct EngineConfig
+{
+    // Mise à l'échelle dynamique de la résolution interne (voir RenderScaler)
+    bool dynamicResolution = false;
+    float targetFrameMs = 16.6f;
+    float minRenderScale = 0.5f;
+
+    // Limiteur d'images (voir FramePacer) : -1 = auto (60 si le renderer n'a pas la synchro verticale), 0 = sans limite
+    int targetFps = -1;
+    // Avec la synchro verticale : début des images retardé pour lire les entrées au plus près de
+    // la présentation (voir FramePacer::EnableLateStart)
+    bool lowLatency = false;
+
+    // Périphérique audio (voir AudioManager::Init) : fréquence, images par tampon (puissance de
+    // deux) ; adaptatif = plus petit tampon sans sous-alimentation, choisi pendant la partie
+    int audioFrequency = 44100;
+    int audioBuffer = 2048;
+    bool audioAdaptive = false;
+    int musicFadeMs = 1000; // Fondu enchaîné entre deux musiques (voir AudioManager::PlayMusic), 0 = coupure franche
+
+    // Rendu logiciel SIMD multi-thread pour les machines sans GPU (voir SoftRenderer)
+    bool softRaster = false;
+    int rasterThreads = 0; // Bandes exécutées en parallèle, 0 = une par worker du JobSystem (+ thread principal)
+
+    // Workers du JobSystem partagé par les sous-systèmes : -1 = un par coeur moins le thread principal
+    int jobThreads = -1;
+
+    // Simulation sur un thread dédié (le rendu reste sur le thread principal), à simHz mises à jour par seconde.
+    // Ignoré avec --golden, qui doit rester déterministe.
+    bool simThread = false;
+    int simHz = 120;
+
+    // Niveau de départ de la campagne (voir Campaign), à partir de 0 ; --level le prend à partir de 1
+    int startLevel = 0;
+
+    // Développement : textures et sons modifiés dans assets/ rechargés sans relancer (voir AssetWatcher)
+    bool hotReload = false;
+
+    // Vitesse de l'horloge de jeu (voir GameClock) : 1 = temps réel
+    float timeScale = 1.0f;
+
+    // Suspendre le jeu quand la fenêtre perd le focus (toujours suspendu si elle est réduite)
+    bool pauseOnFocusLoss = true;
+
+    // Overlay de debug RenderStats affiché dès le lancement (sinon touche F3)
+    bool renderHeatmap = false;
+
+    // Textures semi-transparentes en alpha prémultiplié (voir TextureManager::SetPremultiplyAlpha)
+    bool premultiplyAlpha = false;
+
+    // Capture d'images (voir FrameCapture) : une sur captureEvery dans [captureFirst, captureLast]
+    int captureEvery = 0;
+    int captureFirst = -1;
+    int captureLast = -1;
+    std::string captureDir = "captures";
+    bool captureRaw = false; // ARGB8888 brut au lieu de PNG (enregistrement vidéo)
+    int captureBuffers = 4;
+    // Parcours scripté des états avec une image de référence par état dans captureDir, puis fermeture
+    bool golden = false;
+
+    // Benchmark hors écran à lancer à la place du jeu ("raster", "jobs", "audio"), vide sinon
+    std::string benchmark;
+    int benchmarkFrames = 200;
+    std::string audioRenderPath = "audio_session.wav"; // Mixage de --bench audio
+};
+
+// Renvoie false si un argument est invalide (le message est déjà loggé).
+bool ParseCommandLine(int argc, char** argv, EngineConfig& config);
+
+#endif // CONFIG_H
@@ -7,13 +7,42 @@
 #include <vector>
 
 #include "../Audio/AudioManager.h"
+#include "../Graphics/LayerCache.h"
+#include "../Graphics/RenderScaler.h"
+#include "../Graphics/SoftRenderer.h"
+#include "../Graphics/FrameCapture.h"
+#include "../Graphics/RenderStats.h"
 #include "../Graphics/TextureManager.h"
 #include "../Menu/MainMenu.h"
 #include "../Objects/Player.h" 
+#include "../Scenes/AboutScene.h"
+#include "../Scenes/EndScene.h"
+#include "../Scenes/MenuScene.h"
+#include "../Scenes/PlayingScene.h"
+#include "../Scenes/StartScene.h"
+#include "AssetPack.h"
+#include "AssetWatcher.h"
+#include "Campaign.h"
+#include "FramePacer.h"
+#include "GameClock.h"
+#include "JobSystem.h"
+#include "LatencyTracker.h"
 #include "Engine.h"
 
 Engine* Engine::s_Instance = nullptr;
 
+static const char* GameStateName(GameState state) {
+  switch (state) {
+    case STATE_MAIN_MENU: return "MAIN_MENU";
+    case STATE_START_SCREEN: return "START_SCREEN";
+    case STATE_PLAYING: return "PLAYING";
+    case STATE_GAME_OVER: return "GAME_OVER";
+    case STATE_ABOUT: return "ABOUT";
+    case STATE_WIN: return "WIN";
+  }
+  return "?";
+}
+
 void Engine::ApplyMasterVolume() {
   if (m_isMuted) {
     AudioManager::GetInstance()->SetMusicVolume(0);
@@ -61,8 +90,32 @@ void Engine::ToggleMute() {
   ApplyMasterVolume();
 }
 
+void Engine::LoadAudio() {
+  // Sons courts et fréquents décodés au lancement (SDL_mixer ne se charge pas depuis un worker) ;
+  // les longs stingers de fin, joués une fois par partie, sont lus en flux (voir SoundStream).
+  SDL_Log("Engine::LoadAudio() - Chargement des ressources audio...");
+  if (!AudioManager::GetInstance()->LoadMusic("menu_music", "assets/audio/menu_theme.ogg")) { SDL_Log("Engine::LoadAudio() - Echec chargement musique 'menu_music'"); }
+  if (!AudioManager::GetInstance()->LoadMusic("game_music", "assets/audio/game_loop.ogg")) { SDL_Log("Engine::LoadAudio() - Echec chargement musique 'game_music'"); }
+  if (!AudioManager::GetInstance()->LoadSound("click", "assets/audio/button_click.wav")) { SDL_Log("Engine::LoadAudio() - Echec chargement son 'click'"); }
+  if (!AudioManager::GetInstance()->LoadSound("crash", "assets/audio/player_crash.wav")) { SDL_Log("Engine::LoadAudio() - Echec chargement son 'crash'"); }
+  if (!AudioManager::GetInstance()->LoadSound("win", "assets/audio/level_win.wav", SOUND_STREAMED)) { SDL_Log("Engine::LoadAudio() - Echec chargement son 'win'"); }
+  if (!AudioManager::GetInstance()->LoadSound("lose", "assets/audio/game_over.wav", SOUND_STREAMED)) { SDL_Log("Engine::LoadAudio() - Echec chargement son 'lose'"); }
+  if (!AudioManager::GetInstance()->LoadSound("countdown", "assets/audio/timer_tick.wav")) { SDL_Log("Engine::LoadAudio() - Echec chargement son 'countdown'"); }
+  // Voix : le tic du compte à rebours passe avant tout, le crash ne s'empile pas.
+  AudioManager* audio = AudioManager::GetInstance();
+  audio->ConfigureSound("countdown", 3, 1);
+  audio->ConfigureSound("win", 2);
+  audio->ConfigureSound("lose", 2);
+  audio->ConfigureSound("crash", 1, 1, 150);
+  audio->ConfigureSound("click", 0, 2, 40);
+  m_crashSound = audio->GetSoundHandle("crash");
+  m_countdownSound = audio->GetSoundHandle("countdown");
+  SDL_Log("Engine::LoadAudio() - Ressources audio chargees (ou tentatives effectuees).");
+}
+
 bool Engine::Init() {
   SDL_Log("Engine::Init() - Initialisation du moteur...");
+  SDL_Log("Engine::Init() - Assets %s.", AssetPack::GetInstance()->IsEmbedded() ? "integres a l'executable" : "lus depuis le disque");
   if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER | SDL_INIT_AUDIO) != 0) {
     SDL_Log("Engine::Init() - ECHEC: Initialisation SDL: %s", SDL_GetError());
     return false;
@@ -84,18 +137,19 @@ bool Engine::Init() {
   }
   SDL_Log("Engine::Init() - SDL_ttf initialise.");
 
-  if (!AudioManager::GetInstance()->Init()) {
+  if (!AudioManager::GetInstance()->Init(m_config.audioFrequency, m_config.audioBuffer, m_config.audioAdaptive)) {
     SDL_Log("Engine::Init() - ECHEC: Initialisation AudioManager!"); 
     TTF_Quit();
     IMG_Quit();
     SDL_Quit();
     return false;
   }
+  AudioManager::GetInstance()->SetMusicFade(static_cast<Uint32>(m_config.musicFadeMs));
   SDL_Log("Engine::Init() - AudioManager initialise.");
 
   m_Window = SDL_CreateWindow("Moto Game",
     SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, 
-    SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_FULLSCREEN_DESKTOP); 
+    SCREEN_WIDTH, SCREEN_HEIGHT, m_config.golden ? 0 : SDL_WINDOW_FULLSCREEN_DESKTOP); // Taille fixe pour les images de référence
   
   if (m_Window == nullptr) {
     SDL_Log("Engine::Init() - ECHEC: Creation de la fenetre: %s", SDL_GetError());
@@ -120,6 +174,43 @@ bool Engine::Init() {
   SDL_Log("Engine::Init() - Renderer cree.");
   SDL_SetRenderDrawBlendMode(m_Renderer, SDL_BLENDMODE_BLEND); 
 
+  int targetFps = m_config.targetFps;
+  if (targetFps < 0) {
+    // Auto : si le renderer annonce la synchro verticale, SDL_RenderPresent cadence déjà la boucle.
+    SDL_RendererInfo rendererInfo;
+    bool vsync = SDL_GetRendererInfo(m_Renderer, &rendererInfo) == 0 && (rendererInfo.flags & SDL_RENDERER_PRESENTVSYNC);
+    targetFps = vsync ? 0 : 60;
+  }
+  FramePacer::GetInstance()->Init(targetFps);
+  if (m_config.lowLatency && !m_config.golden) {
+    SDL_DisplayMode displayMode;
+    int refreshRate = SDL_GetWindowDisplayMode(m_Window, &displayMode) == 0 ? displayMode.refresh_rate : 0;
+    FramePacer::GetInstance()->EnableLateStart(refreshRate);
+  }
+
+  JobSystem::GetInstance()->Init(m_config.jobThreads); // Avant SoftRenderer et le chargement des assets
+
+  if (m_config.softRaster) {
+    // Avant le chargement des textures : en rendu logiciel elles restent des surfaces.
+    if (!SoftRenderer::GetInstance()->Init(m_Renderer, SCREEN_WIDTH, SCREEN_HEIGHT, m_config.rasterThreads)) {
+      SDL_Log("Engine::Init() - Attention: rendu logiciel indisponible, rendu SDL standard.");
+    }
+  }
+
+  if (m_config.dynamicResolution) {
+    if (SoftRenderer::GetInstance()->IsActive()) {
+      SDL_Log("Engine::Init() - Resolution dynamique ignoree avec le rendu logiciel.");
+    } else {
+      // Non bloquant : sans textures cibles on rend directement dans la fenêtre comme avant.
+      RenderScaler::GetInstance()->Init(m_Renderer, SCREEN_WIDTH, SCREEN_HEIGHT, m_config.targetFrameMs, m_config.minRenderScale);
+    }
+  }
+
+  RenderStats::GetInstance()->Init(m_Renderer, SCREEN_WIDTH, SCREEN_HEIGHT);
+  RenderStats::GetInstance()->SetHeatmapEnabled(m_config.renderHeatmap);
+
+  TextureManager::GetInstance()->SetPremultiplyAlpha(m_config.premultiplyAlpha); // Avant tout chargement de texture
+
   SDL_Log("Engine::Init() - Initialisation de MainMenu...");
   if (!MainMenu::GetInstance()->Init()) { // Ceci est l'appel qui échouait initialement
     SDL_Log("Engine::Init() - ERREUR CRITIQUE: Echec de l'initialisation du menu principal. Verifiez les logs de MainMenu::Init().");
@@ -133,87 +224,23 @@ bool Engine::Init() {
   }
   SDL_Log("Engine::Init() - MainMenu initialise avec succes.");
 
-  SDL_Log("Engine::Init() - Chargement des textures globales...");
-  if (!TextureManager::GetInstance()->Load("background", "assets/Background1.png")) {
-     SDL_Log("Engine::Init() - ECHEC: Chargement texture 'background'"); return false; 
-  }
-  if (!TextureManager::GetInstance()->Load("track", "assets/Track.png")) {
-     SDL_Log("Engine::Init() - ECHEC: Chargement texture 'track'"); return false;
-  }
-  if (!TextureManager::GetInstance()->Load("player", "assets/player_bike.png")) { // Utilisé par Player::load
-     SDL_Log("Engine::Init() - ECHEC: Chargement texture 'player'"); return false;
-  }
-  if (!TextureManager::GetInstance()->Load("start", "assets/timer/start.png")) {
-     SDL_Log("Engine::Init() - ECHEC: Chargement texture 'start'"); return false;
-  }
+  // Textures de la course et des niveaux : préchargées en arrière-plan pendant le menu (voir
+  // RegisterScenes et SelectLevel).
+  Campaign::GetInstance()->Load("assets/levels/campaign.txt");
   m_timerTextures.push_back("start");
   for (int i = 0; i <= 60; i++) {
     std::ostringstream ss;
     ss << std::setw(2) << std::setfill('0') << i;
-    std::string timerName = ss.str();
-    std::string path = "assets/timer/" + timerName + ".png";
-    if (!TextureManager::GetInstance()->Load(timerName, path)) {
-      SDL_Log("Engine::Init() - ECHEC: Chargement texture timer '%s'", timerName.c_str()); return false;
-    }
-    m_timerTextures.push_back(timerName);
-  }
-  if (!TextureManager::GetInstance()->Load("end", "assets/timer/end.png")) {
-     SDL_Log("Engine::Init() - ECHEC: Chargement texture 'end'"); return false;
+    m_timerTextures.push_back(ss.str());
   }
   m_timerTextures.push_back("end");
-  if (!TextureManager::GetInstance()->Load("gameover", "assets/game_over.png")) {
-     SDL_Log("Engine::Init() - ECHEC: Chargement texture 'gameover'"); return false;
-  }
-  if (!TextureManager::GetInstance()->Load("win", "assets/win.png")) {
-     SDL_Log("Engine::Init() - ECHEC: Chargement texture 'win'"); return false;
-  }
-  SDL_Log("Engine::Init() - Textures globales chargees.");
-
-  SDL_Log("Engine::Init() - Chargement des textures d'obstacles...");
-  m_obstacleTextureIds.clear();
-  std::vector<std::pair<std::string, std::string>> obstaclesToLoad = {
-      {"obstacle1", "assets/obstacle1.png"}, {"obstacle2", "assets/obstacle2.png"},
-      {"obstacle3", "assets/obstacle3.png"}, {"obstacle4", "assets/obstacle4.png"}
-  };
-  bool firstObstacleLoaded = false;
-  for (const auto& obsData : obstaclesToLoad) {
-    if (!TextureManager::GetInstance()->Load(obsData.first, obsData.second)) {
-        SDL_Log("Engine::Init() - Attention: Echec chargement texture obstacle '%s'. On continue si d'autres se chargent.", obsData.first.c_str());
-        continue; 
-    }
-    m_obstacleTextureIds.push_back(obsData.first);
-    if (!firstObstacleLoaded) {
-      // Récupérer la largeur/hauteur du premier obstacle chargé pour dimensionner les autres (supposition)
-      TextureManager::GetInstance()->QueryTexture(obsData.first, &m_obstacleTextureWidth, &m_obstacleTextureHeight);
-      if (m_obstacleTextureWidth > 0) firstObstacleLoaded = true;
-    }
-  }
-  if (m_obstacleTextureIds.empty() || !firstObstacleLoaded) {
-    SDL_Log("Engine::Init() - ERREUR CRITIQUE: Aucune texture d'obstacle n'a pu etre chargee ou dimensions invalides.");
-    TextureManager::GetInstance()->Clean(); 
-    SDL_DestroyRenderer(m_Renderer);
-    SDL_DestroyWindow(m_Window);
-    AudioManager::GetInstance()->Clean();
-    TTF_Quit();
-    IMG_Quit();
-    SDL_Quit();
-    return false;
-  }
-  SDL_Log("Engine::Init() - Textures d'obstacles chargees. %zu types disponibles.", m_obstacleTextureIds.size());
-
 
-  SDL_Log("Engine::Init() - Chargement des ressources audio...");
-  if (!AudioManager::GetInstance()->LoadMusic("menu_music", "assets/audio/menu_theme.ogg")) { SDL_Log("Engine::Init() - Echec chargement musique 'menu_music'"); }
-  if (!AudioManager::GetInstance()->LoadMusic("game_music", "assets/audio/game_loop.ogg")) { SDL_Log("Engine::Init() - Echec chargement musique 'game_music'"); }
-  if (!AudioManager::GetInstance()->LoadSound("click", "assets/audio/button_click.wav")) { SDL_Log("Engine::Init() - Echec chargement son 'click'"); }
-  if (!AudioManager::GetInstance()->LoadSound("crash", "assets/audio/player_crash.wav")) { SDL_Log("Engine::Init() - Echec chargement son 'crash'"); }
-  if (!AudioManager::GetInstance()->LoadSound("win", "assets/audio/level_win.wav")) { SDL_Log("Engine::Init() - Echec chargement son 'win'"); }
-  if (!AudioManager::GetInstance()->LoadSound("lose", "assets/audio/game_over.wav")) { SDL_Log("Engine::Init() - Echec chargement son 'lose'"); }
-  if (!AudioManager::GetInstance()->LoadSound("countdown", "assets/audio/timer_tick.wav")) { SDL_Log("Engine::Init() - Echec chargement son 'countdown'"); }
-  SDL_Log("Engine::Init() - Ressources audio chargees (ou tentatives effectuees).");
+  LoadAudio();
+  AudioManager::GetInstance()->LogMemoryReport();
 
   SDL_Log("Engine::Init() - Chargement de la police UI...");
-  m_uiFont = TTF_OpenFont("assets/Swansea-q3pd.ttf", 24); 
+  SDL_RWops* fontRW = AssetPack::GetInstance()->Open("assets/Swansea-q3pd.ttf");
+  m_uiFont = fontRW ? TTF_OpenFontRW(fontRW, 1, 24) : nullptr; // La police relit le flux à la demande : freesrc=1
   if (m_uiFont == nullptr) {
     SDL_Log("Engine::Init() - ECHEC: Chargement police UI 'assets/Swansea-q3pd.ttf': %s", TTF_GetError());
     TextureManager::GetInstance()->Clean();
@@ -235,30 +262,14 @@ bool Engine::Init() {
   m_laneYPositions.push_back(TRACK_Y_POSITION + laneHeight * 1.5f);
   m_laneYPositions.push_back(TRACK_Y_POSITION + laneHeight * 2.5f);
   
-  m_Player = new Player(); 
-  float playerStartX = 150.0f;
-  if (!m_Player || !m_Player->load("player", playerStartX, m_laneYPositions)) {
-    SDL_Log("Engine::Init() - ECHEC: Initialisation du joueur.");
-    if (m_Player) delete m_Player;
-    m_Player = nullptr;
-    TTF_CloseFont(m_uiFont);
-    TextureManager::GetInstance()->Clean();
-    SDL_DestroyRenderer(m_Renderer);
-    SDL_DestroyWindow(m_Window);
-    AudioManager::GetInstance()->Clean();
-    TTF_Quit();
-    IMG_Quit();
-    SDL_Quit();
-    return false;
-  }
-  SDL_Log("Engine::Init() - Joueur initialise.");
+  m_Player = new Player(); // Texture préchargée : chargé à la première entrée sur l'écran de départ
+  m_runAssetsReady = false;
 
   SDL_Log("Engine::Init() - Creation du message 'Retour au menu'...");
   SDL_Color textColor = { 0, 0, 0, 255 }; 
   SDL_Surface* surface = TTF_RenderText_Blended(m_uiFont, "Appuyez sur Echap pour retourner au menu", textColor); 
   if (surface) {
-    m_returnPromptTexture = SDL_CreateTextureFromSurface(m_Renderer, surface);
-    if (m_returnPromptTexture) {
+    if (TextureManager::GetInstance()->LoadFromSurface(RETURN_PROMPT_TEXTURE, surface)) {
       m_returnPromptRect.w = surface->w;
       m_returnPromptRect.h = surface->h;
       m_returnPromptRect.x = (SCREEN_WIDTH - m_returnPromptRect.w) / 2;
@@ -271,113 +282,219 @@ bool Engine::Init() {
     SDL_Log("Engine::Init() - Attention: Echec creation surface 'Retour au menu': %s", TTF_GetError());
   }
   SDL_Log("Engine::Init() - Message 'Retour au menu' cree (ou tentative effectuee).");
+  m_aboutPromptRect = m_returnPromptRect;
+  m_aboutPromptRect.y = SCREEN_HEIGHT - 100;
+  m_aboutPromptRect.x = (SCREEN_WIDTH - m_aboutPromptRect.w) / 2;
+
+  RegisterLayers();
+  RegisterScenes();
+  m_levelIndex = std::min(m_config.startLevel, Campaign::GetInstance()->GetLevelCount() - 1);
+  if (m_config.golden) {
+    m_scenes.PreloadAll(); // Tout est chargé avant la première image de référence
+    TexturePreloader::GetInstance()->LoadNow(Campaign::GetGroupName(m_levelIndex), Campaign::GetInstance()->GetTextures(m_levelIndex));
+  }
+  SelectLevel(m_levelIndex);
 
-  m_lastTick = SDL_GetTicks();
+  if (m_config.golden || m_config.captureEvery > 0 || m_config.captureFirst >= 0) {
+    FrameCapture* capture = FrameCapture::GetInstance();
+    if (capture->Init(m_Renderer, m_config.captureDir, m_config.captureRaw ? FrameCapture::FORMAT_RAW : FrameCapture::FORMAT_PNG, m_config.captureBuffers)) {
+      capture->SetSchedule(m_config.captureEvery, m_config.captureFirst, m_config.captureLast);
+    } else {
+      SDL_Log("Engine::Init() - Attention: capture d'images desactivee.");
+    }
+  }
+  if (m_config.golden) {
+    m_rng.seed(1234); // Obstacles reproductibles d'une exécution à l'autre
+  }
+
+  GameClock* clock = GameClock::GetInstance();
+  clock->Reset();
+  clock->SetTimeScale(m_config.timeScale);
+  if (m_config.golden) {
+    clock->SetFixedStep(1.0 / 60.0); // Même scène et mêmes minuteurs quelle que soit la vitesse de la machine
+  }
   m_deltaTime = 0.0f;
   m_BackgroundScrollX = 0.0f;
   m_IsRunning = true;
-  m_remainingSeconds = 60; 
-  m_lastSecondUpdate = SDL_GetTicks();
-  // m_gameOverStartTime est initialisé dans SetGameState
-  m_showGameOverScreen = false;
-  m_totalDistanceTraveled = 0.0f;
-  m_timeSinceLastSpawn = 1.0f; 
-  m_obstacleSpawnInterval = 2.3f; 
-  m_lastDifficultyIncreaseTime = SDL_GetTicks();
-  m_lastMaxSpeedIncreaseTime = SDL_GetTicks();
-  m_distanceTexture = nullptr;
-  m_lastDisplayedDistance = -1;
-  m_lastCountdownSecondPlayed = -1;
+  ApplyLevel(); // Niveau choisi plus haut par SelectLevel
   m_showReturnPrompt = false;
-  // m_endScreenStartTime est initialisé dans SetGameState
+  m_timeline.CancelAll(); // Minuteurs programmés par les scènes
 
   ApplyMasterVolume();
+  if (m_config.hotReload) {
+    if (m_config.golden) {
+      SDL_Log("Engine::Init() - Rechargement a chaud ignore avec --golden.");
+    } else if (!AssetWatcher::GetInstance()->Start("assets")) {
+      SDL_Log("Engine::Init() - Attention: rechargement a chaud indisponible.");
+    }
+  }
   SetGameState(STATE_MAIN_MENU); 
+  PublishSnapshot(); // Premier instantané avant le premier Render()
+
+  if (m_config.simThread) {
+    if (m_config.golden) {
+      SDL_Log("Engine::Init() - Thread de simulation ignore avec --golden (parcours deterministe).");
+    } else {
+      StartSimulationThread();
+    }
+  }
 
   SDL_Log("Engine::Init() - Initialisation du moteur terminee avec succes !");
   return true;
 }
 
 void Engine::SetGameState(GameState newState) {
-  if (m_gameState == newState) return;
+  m_scenes.Change(newState);
+}
 
-  GameState oldState = m_gameState;
-  m_gameState = newState;
-  SDL_Log("Engine::SetGameState - Changement d'etat de %d a %d", oldState, newState);
-  m_showReturnPrompt = false;
+void Engine::PushScene(GameState state) {
+  m_scenes.Push(state);
+}
 
-  switch (newState) {
-    case STATE_MAIN_MENU:
-      if (oldState == STATE_GAME_OVER || oldState == STATE_WIN || oldState == STATE_PLAYING || oldState == STATE_START_SCREEN) {
-          AudioManager::GetInstance()->StopMusic(); // S'assurer que la musique du jeu est arrêtée
-          AudioManager::GetInstance()->PlayMusic("menu_music", -1); // Puis jouer celle du menu
-          
-          m_obstacles.clear();
-          m_totalDistanceTraveled = 0.0f;
-          if (m_Player) {
-              if (m_laneYPositions.empty()) { // Sécurité si SetGameState est appelé avant que Init ait tout rempli
-                   float laneHeight_temp = TRACK_HEIGHT / 3.0f;
-                   m_laneYPositions.push_back(TRACK_Y_POSITION + laneHeight_temp * 0.5f);
-                   m_laneYPositions.push_back(TRACK_Y_POSITION + laneHeight_temp * 1.5f);
-                   m_laneYPositions.push_back(TRACK_Y_POSITION + laneHeight_temp * 2.5f);
-              }
-              m_Player->reset(150.0f, m_laneYPositions);
-          }
-      } else if (!Mix_PlayingMusic()){ 
-         AudioManager::GetInstance()->PlayMusic("menu_music", -1);
-      }
-      break;
-    case STATE_ABOUT:
-      // Si on vient du jeu, arrêter la musique du jeu et jouer celle du menu
-      if (oldState == STATE_PLAYING || oldState == STATE_START_SCREEN) {
-          AudioManager::GetInstance()->StopMusic();
-          AudioManager::GetInstance()->PlayMusic("menu_music", -1);
-      } else if (!Mix_PlayingMusic()) { // Si on vient d'un autre état (ex: menu principal) et que rien ne joue
-          AudioManager::GetInstance()->PlayMusic("menu_music", -1);
-      }
-      break;
-    case STATE_START_SCREEN: 
-      AudioManager::GetInstance()->StopMusic();
-      m_remainingSeconds = 60;
-      // m_gameOverStartTime = 0; // Déjà initialisé
-      m_showGameOverScreen = false;
-      m_obstacles.clear();
-      m_timeSinceLastSpawn = 1.0f;
-      m_obstacleSpawnInterval = 2.3f; 
-      m_lastDifficultyIncreaseTime = SDL_GetTicks();
-      m_lastMaxSpeedIncreaseTime = SDL_GetTicks();
-      m_totalDistanceTraveled = 0.0f;
-      m_lastDisplayedDistance = -1;
-      if (m_distanceTexture) {
-        SDL_DestroyTexture(m_distanceTexture);
-        m_distanceTexture = nullptr;
-      }
-      if (m_Player) {
-        m_Player->reset(150.0f, m_laneYPositions); 
-      }
-      m_lastCountdownSecondPlayed = -1; 
-      SDL_Log("Engine::SetGameState - Etat du jeu reinitialise pour STATE_START_SCREEN.");
-      break;
-    case STATE_PLAYING:
-      AudioManager::GetInstance()->StopMusic(); // S'assurer que toute musique précédente est arrêtée
-      AudioManager::GetInstance()->PlayMusic("game_music", -1);
-      m_lastSecondUpdate = SDL_GetTicks(); 
-      m_lastCountdownSecondPlayed = -1;
-      SDL_Log("Engine::SetGameState - Passage a STATE_PLAYING, musique de jeu lancee.");
-      break;
-    case STATE_GAME_OVER:
-      AudioManager::GetInstance()->StopMusic();
-      AudioManager::GetInstance()->PlaySound("lose", 0);
-      m_gameOverStartTime = SDL_GetTicks(); // Pour le délai avant d'afficher l'écran gameover
-      m_endScreenStartTime = SDL_GetTicks(); // Pour le délai d'affichage du message "Retour"
-      SDL_Log("Engine::SetGameState - Passage a STATE_GAME_OVER.");
-      break;
-    case STATE_WIN:
-      AudioManager::GetInstance()->StopMusic();
-      AudioManager::GetInstance()->PlaySound("win", 0);
-      m_endScreenStartTime = SDL_GetTicks();
-      SDL_Log("Engine::SetGameState - Passage a STATE_WIN.");
-      break;
+void Engine::PopScene() {
+  m_scenes.Pop();
+}
+
+void Engine::RegisterScenes() {
+  m_scenes.Clean();
+  m_scenes.Register(std::unique_ptr<Scene>(new MenuScene()));
+  m_scenes.Register(std::unique_ptr<Scene>(new AboutScene()));
+  m_scenes.Register(std::unique_ptr<Scene>(new StartScene()));
+  m_scenes.Register(std::unique_ptr<Scene>(new PlayingScene()));
+  m_scenes.Register(std::unique_ptr<Scene>(new EndScene(STATE_GAME_OVER)));
+  m_scenes.Register(std::unique_ptr<Scene>(new EndScene(STATE_WIN)));
+  m_scenes.SetTransitionHook([this](GameState previous, GameState next) { OnSceneTransition(previous, next); });
+}
+
+void Engine::OnSceneTransition(GameState previous, GameState next) {
+  m_gameState = next;
+  SDL_Log("Engine::SetGameState - Changement d'etat de %s a %s", GameStateName(previous), GameStateName(next));
+  m_showReturnPrompt = false; // Le rendu recompose le calque écran au changement d'état (voir ApplyScreenChanges)
+  m_timeline.CancelAll(); // Les minuteurs appartiennent à la scène quittée
+}
+
+TextureList Engine::GetRunTextures() const {
+  // Communes à tous les niveaux ; fond, piste et obstacles viennent du niveau (voir Campaign).
+  TextureList textures;
+  textures.push_back({ "player", "assets/player_bike.png" }); // Utilisé par Player::load
+  for (const auto& timerName : m_timerTextures) {
+    textures.push_back({ timerName, "assets/timer/" + timerName + ".png" });
+  }
+  return textures;
+}
+
+bool Engine::PrepareRunAssets() {
+  if (m_runAssetsReady) return true;
+  // Thread de simulation : les tailles viennent du préchargement, pas du TextureManager.
+  TexturePreloader* preloader = TexturePreloader::GetInstance();
+  int playerWidth = 0, playerHeight = 0;
+  if (!preloader->GetSize("player", &playerWidth, &playerHeight) ||
+      !m_Player->load("player", playerWidth, playerHeight, 150.0f, m_laneYPositions)) {
+    SDL_Log("Engine::PrepareRunAssets - ECHEC: Initialisation du joueur.");
+    return false;
+  }
+
+  SDL_Log("Engine::PrepareRunAssets - Joueur initialise.");
+  m_runAssetsReady = true;
+  return true;
+}
+
+void Engine::SelectLevel(int index) {
+  Campaign* campaign = Campaign::GetInstance();
+  m_levelIndex = std::max(0, std::min(index, campaign->GetLevelCount() - 1));
+  RequestLevel(m_levelIndex, true);
+  if (!campaign->IsLastLevel(m_levelIndex)) RequestLevel(m_levelIndex + 1, true); // Chargé pendant ce niveau
+}
+
+TexturePreloader::GroupState Engine::RequestLevel(int index, bool retryFailed) {
+  // Un groupe libéré entre-temps par le rendu (voir ApplyScreenChanges) est simplement redemandé.
+  // Un groupe en échec ne l'est qu'à la sélection du niveau : IsLevelReady est interrogé à
+  // chaque image et redécoderait sans fin un fichier manquant.
+  TexturePreloader* preloader = TexturePreloader::GetInstance();
+  std::string group = Campaign::GetGroupName(index);
+  TexturePreloader::GroupState state = preloader->GetState(group);
+  if (state == TexturePreloader::GROUP_UNKNOWN || (retryFailed && state == TexturePreloader::GROUP_FAILED)) {
+    preloader->Request(group, Campaign::GetInstance()->GetTextures(index));
+  }
+  return preloader->GetState(group);
+}
+
+bool Engine::IsLevelReady() {
+  return RequestLevel(m_levelIndex) != TexturePreloader::GROUP_LOADING;
+}
+
+bool Engine::PrepareLevel() {
+  // Thread de simulation : les tailles viennent du préchargement, pas du TextureManager.
+  TexturePreloader* preloader = TexturePreloader::GetInstance();
+  const LevelDef& level = Campaign::GetInstance()->GetLevel(m_levelIndex);
+  m_obstacleTextureIds.clear();
+  for (int i = 0; i < static_cast<int>(level.obstacles.size()); ++i) {
+    std::string obstacleId = Campaign::GetObstacleId(m_levelIndex, i);
+    int width = 0, height = 0;
+    if (!preloader->GetSize(obstacleId, &width, &height)) {
+      SDL_Log("Engine::PrepareLevel - Attention: Echec chargement texture obstacle '%s'. On continue si d'autres se chargent.", level.obstacles[i].c_str());
+      continue;
+    }
+    if (m_obstacleTextureIds.empty()) {
+      // Récupérer la largeur/hauteur du premier obstacle chargé pour dimensionner les autres (supposition)
+      m_obstacleTextureWidth = width;
+      m_obstacleTextureHeight = height;
+    }
+    m_obstacleTextureIds.push_back(obstacleId);
+  }
+  if (m_obstacleTextureIds.empty() || m_obstacleTextureWidth <= 0) {
+    SDL_Log("Engine::PrepareLevel - ERREUR CRITIQUE: Aucune texture d'obstacle n'a pu etre chargee pour '%s'.", level.name.c_str());
+    return false;
+  }
+  SDL_Log("Engine::PrepareLevel - Niveau %d/%d '%s' : %zu types d'obstacles disponibles.",
+          m_levelIndex + 1, Campaign::GetInstance()->GetLevelCount(), level.name.c_str(), m_obstacleTextureIds.size());
+  return true;
+}
+
+void Engine::ApplyLevel() {
+  const LevelDef& level = Campaign::GetInstance()->GetLevel(m_levelIndex);
+  m_remainingSeconds = level.duration;
+  m_obstacleSpawnInterval = level.spawnInterval;
+  m_minSpawnInterval = level.minSpawnInterval;
+  m_spawnIntervalReduction = level.spawnReduction;
+  m_difficultyIncreaseInterval = level.difficultyInterval;
+  m_doubleSpawnChance = level.doubleSpawnChance;
+  m_maxSpeedIncreaseAmount = level.maxSpeedIncrease;
+  m_showGameOverScreen = false;
+  m_obstacles.clear();
+  m_totalDistanceTraveled = 0.0f;
+  m_lastDisplayedDistance = -1; // Le rendu retire le texte de distance
+  m_lastCountdownSecondPlayed = -1; 
+}
+
+void Engine::AdvanceLevel() {
+  Campaign* campaign = Campaign::GetInstance();
+  int next = m_levelIndex + 1;
+  // Normalement chargé depuis longtemps ; sinon on continue de rouler, sans pause, jusqu'à ce qu'il le soit.
+  if (RequestLevel(next) == TexturePreloader::GROUP_LOADING) {
+    if (!m_waitingForNextLevel) {
+      SDL_Log("Engine::AdvanceLevel - Arrivee atteinte, textures de '%s' encore en chargement.", campaign->GetLevel(next).name.c_str());
+    }
+    m_waitingForNextLevel = true;
+    return;
+  }
+  m_waitingForNextLevel = false;
+  SDL_Log("Engine::AdvanceLevel - '%s' termine, passage a '%s'.", campaign->GetLevel(m_levelIndex).name.c_str(), campaign->GetLevel(next).name.c_str());
+
+  SelectLevel(next);
+  if (!PrepareLevel()) {
+    SDL_Log("Engine::AdvanceLevel - Attention: niveau sans obstacle.");
+  }
+  ApplyLevel(); // Le joueur garde sa voie et sa vitesse
+  m_timeline.CancelAll();
+  StartPlayingTimers();
+}
+
+void Engine::ResetRun() {
+  ApplyLevel();
+  m_waitingForNextLevel = false;
+  if (m_Player) {
+    m_Player->reset(150.0f, m_laneYPositions);
   }
 }
 
@@ -444,340 +561,611 @@ void Engine::SpawnObstacle() {
 }
 
 void Engine::Update() {
-  Uint32 currentTick = SDL_GetTicks();
-  m_deltaTime = (currentTick - m_lastTick) / 1000.0f;
-  m_lastTick = currentTick;
-  if (m_deltaTime > 0.05f) m_deltaTime = 0.05f; 
-
-  if (m_gameState == STATE_MAIN_MENU) {
-    MainMenu::GetInstance()->Update(m_deltaTime); 
-  } else if (m_gameState == STATE_ABOUT) {
-    // Rien à faire ici, géré par Events
-  } else if (m_gameState == STATE_START_SCREEN) {
-    // Rien à faire ici, géré par Render/Events
-  } else if (m_gameState == STATE_PLAYING) {
-    if (m_Player) m_Player->update(m_deltaTime);
-
-    float playerSpeed = m_Player ? m_Player->getSpeed() : 0.0f; 
-    float scrollAmount = playerSpeed * m_deltaTime; 
-
-    m_BackgroundScrollX -= scrollAmount;
-    if (m_BackgroundScrollX <= -SCREEN_WIDTH) { 
-        m_BackgroundScrollX += SCREEN_WIDTH; 
-    }
+  if (m_suspended) return; // Horloge de simulation arrêtée (voir Resume)
 
-    m_totalDistanceTraveled += playerSpeed * m_deltaTime; 
-    int currentDisplayedDistance = static_cast<int>(m_totalDistanceTraveled / 10.0f);
-    if (currentDisplayedDistance != m_lastDisplayedDistance) {
-      if (m_distanceTexture != nullptr) {
-        SDL_DestroyTexture(m_distanceTexture);
-        m_distanceTexture = nullptr;
-      }
-      std::stringstream ssDistance;
-      ssDistance << "Distance: " << currentDisplayedDistance << " m / " << static_cast<int>(WIN_DISTANCE / 10.0f) << " m";
-      SDL_Color textColor = { 0, 0, 0, 255 }; 
-      if (m_uiFont) {
-        SDL_Surface* surface = TTF_RenderText_Blended(m_uiFont, ssDistance.str().c_str(), textColor); 
-        if (surface) {
-          m_distanceTexture = SDL_CreateTextureFromSurface(m_Renderer, surface);
-          if (m_distanceTexture) {
-            SDL_QueryTexture(m_distanceTexture, NULL, NULL, &m_distanceRect.w, &m_distanceRect.h);
-          } else {
-            SDL_Log("Engine::Update - Echec creation texture distance: %s", SDL_GetError());
-          }
-          SDL_FreeSurface(surface);
-        } else {
-          SDL_Log("Engine::Update - Echec creation surface distance: %s", TTF_GetError());
-        }
-      }
-      m_lastDisplayedDistance = currentDisplayedDistance;
-    }
+  GameClock* clock = GameClock::GetInstance();
+  m_deltaTime = static_cast<float>(clock->Tick()); // Pas fixe avec --golden (voir Init)
+  if (m_deltaTime > MAX_FRAME_DELTA) m_deltaTime = MAX_FRAME_DELTA;
+  if (m_config.golden) {
+    UpdateGoldenRun();
+  }
+  ApplyReloadedAssets();
+  AudioManager::GetInstance()->Update(); // Flux des stingers, sons paresseux terminés
+  m_timeline.Update(); // Compte à rebours, difficulté, apparitions, écrans de fin
+  m_scenes.Update();   // Transition en attente dont les textures viennent d'être créées
 
-    if (currentTick - m_lastDifficultyIncreaseTime >= m_difficultyIncreaseInterval) {
-      m_obstacleSpawnInterval -= m_spawnIntervalReduction;
-      if (m_obstacleSpawnInterval < m_minSpawnInterval) {
-        m_obstacleSpawnInterval = m_minSpawnInterval;
+  Scene* scene = m_scenes.GetActive();
+  if (scene != nullptr) scene->Update(m_deltaTime);
+  // STATE_GAME_OVER / STATE_WIN : écran et message "Retour" affichés par les minuteurs d'EndScene
+
+  PublishSnapshot();
+}
+
+void Engine::ApplyReloadedAssets() {
+  AssetWatcher* watcher = AssetWatcher::GetInstance();
+  if (!watcher->IsActive()) return;
+  watcher->SwapSounds();
+  for (const ResizedTexture& resized : watcher->TakeResized()) {
+    if (m_Player && resized.id == m_Player->GetTextureId()) {
+      m_Player->SetSize(resized.width, resized.height);
+      SDL_Log("Engine::ApplyReloadedAssets - Joueur : %dx%d.", resized.width, resized.height);
+    }
+    // Tous les obstacles du niveau prennent la taille du premier (voir PrepareLevel)
+    if (!m_obstacleTextureIds.empty() && resized.id == m_obstacleTextureIds[0]) {
+      m_obstacleTextureWidth = resized.width;
+      m_obstacleTextureHeight = resized.height;
+      for (Obstacle& obstacle : m_obstacles) {
+        int centerY = obstacle.collider.y + obstacle.collider.h / 2; // Reste centré sur sa voie
+        obstacle.collider.w = resized.width;
+        obstacle.collider.h = resized.height;
+        obstacle.collider.y = centerY - resized.height / 2;
       }
-      m_lastDifficultyIncreaseTime = currentTick;
-      SDL_Log("Engine::Update - Difficulte augmentee! Nouvel interval de spawn: %.2fs", m_obstacleSpawnInterval);
+      SDL_Log("Engine::ApplyReloadedAssets - Obstacles : %dx%d.", resized.width, resized.height);
     }
+  }
+}
 
-    if (currentTick - m_lastMaxSpeedIncreaseTime >= m_maxSpeedIncreaseInterval) {
-      if (m_Player) m_Player->IncreaseMaxSpeed(m_maxSpeedIncreaseAmount, m_absoluteMaxPlayerSpeed);
-      m_lastMaxSpeedIncreaseTime = currentTick;
-    }
+void Engine::UpdateRun(float deltaTime) {
+  if (m_Player) m_Player->update(deltaTime);
 
-    m_timeSinceLastSpawn += m_deltaTime;
-    if (m_timeSinceLastSpawn >= m_obstacleSpawnInterval) {
-      SpawnObstacle();
-      m_timeSinceLastSpawn = 0.0f; 
-    }
+  float playerSpeed = m_Player ? m_Player->getSpeed() : 0.0f; 
+  if (m_Player) {
+    // Le moteur tire tant que le frein n'est pas tenu (voir Player::update)
+    AudioManager::GetInstance()->SetEngineSound(playerSpeed / ENGINE_SOUND_TOP_SPEED, m_Player->IsBraking() ? 0.0f : 1.0f);
+  }
+  float scrollAmount = playerSpeed * deltaTime; 
+
+  m_BackgroundScrollX -= scrollAmount;
+  if (m_BackgroundScrollX <= -SCREEN_WIDTH) { 
+      m_BackgroundScrollX += SCREEN_WIDTH; 
+  }
 
-    SDL_Rect playerFullCollider = m_Player ? m_Player->GetCollider() : SDL_Rect{0,0,0,0};
-    bool collisionProcessedThisFrame = false;
+  m_totalDistanceTraveled += playerSpeed * deltaTime; 
+  m_lastDisplayedDistance = static_cast<int>(m_totalDistanceTraveled / 10.0f); // Texte regénéré par le rendu s'il change
 
-    for (auto it = m_obstacles.begin(); it != m_obstacles.end(); ) {
-      if (!it->isActive) { 
-          it = m_obstacles.erase(it);
-          continue;
-      }
+  SDL_Rect playerFullCollider = m_Player ? m_Player->GetCollider() : SDL_Rect{0,0,0,0};
+  bool collisionProcessedThisFrame = false;
 
-      it->collider.x -= static_cast<int>(scrollAmount); 
-
-      float reductionFactor = 0.7f; 
-      SDL_Rect playerCollisionBox;
-      playerCollisionBox.w = static_cast<int>(playerFullCollider.w * reductionFactor);
-      playerCollisionBox.h = static_cast<int>(playerFullCollider.h * reductionFactor);
-      playerCollisionBox.x = playerFullCollider.x + (playerFullCollider.w - playerCollisionBox.w) / 2;
-      playerCollisionBox.y = playerFullCollider.y + (playerFullCollider.h - playerCollisionBox.h) / 2;
-
-      SDL_Rect obstacleCollisionBox;
-      obstacleCollisionBox.w = static_cast<int>(it->collider.w * reductionFactor);
-      obstacleCollisionBox.h = static_cast<int>(it->collider.h * reductionFactor);
-      obstacleCollisionBox.x = it->collider.x + (it->collider.w - obstacleCollisionBox.w) / 2;
-      obstacleCollisionBox.y = it->collider.y + (it->collider.h - obstacleCollisionBox.h) / 2;
-
-      if (m_Player && SDL_HasIntersection(&playerCollisionBox, &obstacleCollisionBox) && !collisionProcessedThisFrame) {
-        SDL_Log("Engine::Update - Collision detectee avec obstacle '%s'!", it->textureId.c_str());
-        AudioManager::GetInstance()->PlaySound("crash", 0);
-        m_Player->ApplySpeedPenalty(); 
-
-        it = m_obstacles.erase(it); 
-        collisionProcessedThisFrame = true; 
-      } else if (it->collider.x + it->collider.w < 0) { 
+  for (auto it = m_obstacles.begin(); it != m_obstacles.end(); ) {
+    if (!it->isActive) { 
         it = m_obstacles.erase(it);
-      } else {
-        ++it;
-      }
+        continue;
     }
 
-    Uint32 currentTime = SDL_GetTicks();
-    if (currentTime - m_lastSecondUpdate >= 1000 && m_remainingSeconds > 0) {
-      m_remainingSeconds--;
-      m_lastSecondUpdate = currentTime; 
-      SDL_Log("Engine::Update - Temps restant: %d s", m_remainingSeconds);
-
-      if (m_remainingSeconds <= 10 && m_remainingSeconds > 0) {
-        if (m_lastCountdownSecondPlayed != m_remainingSeconds) { 
-          AudioManager::GetInstance()->PlaySound("countdown", 0);
-          m_lastCountdownSecondPlayed = m_remainingSeconds;
-        }
-      }
-      if (m_remainingSeconds == 0) {
-        SDL_Log("Engine::Update - TEMPS ECOULE! Game Over.");
-        SetGameState(STATE_GAME_OVER); 
-      }
+    it->collider.x -= static_cast<int>(scrollAmount); 
+
+    float reductionFactor = 0.7f; 
+    SDL_Rect playerCollisionBox;
+    playerCollisionBox.w = static_cast<int>(playerFullCollider.w * reductionFactor);
+    playerCollisionBox.h = static_cast<int>(playerFullCollider.h * reductionFactor);
+    playerCollisionBox.x = playerFullCollider.x + (playerFullCollider.w - playerCollisionBox.w) / 2;
+    playerCollisionBox.y = playerFullCollider.y + (playerFullCollider.h - playerCollisionBox.h) / 2;
+
+    SDL_Rect obstacleCollisionBox;
+    obstacleCollisionBox.w = static_cast<int>(it->collider.w * reductionFactor);
+    obstacleCollisionBox.h = static_cast<int>(it->collider.h * reductionFactor);
+    obstacleCollisionBox.x = it->collider.x + (it->collider.w - obstacleCollisionBox.w) / 2;
+    obstacleCollisionBox.y = it->collider.y + (it->collider.h - obstacleCollisionBox.h) / 2;
+
+    if (m_Player && SDL_HasIntersection(&playerCollisionBox, &obstacleCollisionBox) && !collisionProcessedThisFrame) {
+      SDL_Log("Engine::Update - Collision detectee avec obstacle '%s'!", it->textureId.c_str());
+      AudioManager::GetInstance()->PlaySound(m_crashSound);
+      m_Player->ApplySpeedPenalty(); 
+
+      it = m_obstacles.erase(it); 
+      collisionProcessedThisFrame = true; 
+    } else if (it->collider.x + it->collider.w < 0) { 
+      it = m_obstacles.erase(it);
+    } else {
+      ++it;
     }
+  }
 
-    if (m_totalDistanceTraveled >= WIN_DISTANCE) {
+  if (m_totalDistanceTraveled >= Campaign::GetInstance()->GetLevel(m_levelIndex).distance) {
+    if (Campaign::GetInstance()->IsLastLevel(m_levelIndex)) {
       SDL_Log("Engine::Update - CONDITION DE VICTOIRE ATTEINTE! Distance: %.2f", m_totalDistanceTraveled);
       SetGameState(STATE_WIN);
+    } else {
+      AdvanceLevel();
     }
+  }
+}
 
-  } else if (m_gameState == STATE_GAME_OVER) {
-    if (!m_showGameOverScreen) { 
-      Uint32 currentTime = SDL_GetTicks();
-      if (currentTime - m_gameOverStartTime >= 2000) { 
-        SDL_Log("Engine::Update - Affichage de l'ecran Game Over.");
-        m_showGameOverScreen = true; 
-      }
-    }
-    if (m_showGameOverScreen && !m_showReturnPrompt && SDL_GetTicks() - m_endScreenStartTime >= RETURN_PROMPT_DELAY) {
-        m_showReturnPrompt = true;
-    }
-  } else if (m_gameState == STATE_WIN) {
-     if (!m_showReturnPrompt && SDL_GetTicks() - m_endScreenStartTime >= RETURN_PROMPT_DELAY) {
-        m_showReturnPrompt = true;
+void Engine::StartPlayingTimers() {
+  m_timeline.Every(1.0, [this] { OnCountdownSecond(); });
+  m_timeline.Every(m_difficultyIncreaseInterval, [this] { OnDifficultyIncrease(); });
+  m_timeline.Every(m_maxSpeedIncreaseInterval, [this] {
+    if (m_Player) m_Player->IncreaseMaxSpeed(m_maxSpeedIncreaseAmount, m_absoluteMaxPlayerSpeed);
+  });
+  ScheduleNextSpawn(m_obstacleSpawnInterval - 1.0f); // Premier obstacle une seconde plus tôt que les suivants
+}
+
+void Engine::OnCountdownSecond() {
+  if (m_remainingSeconds <= 0) return;
+  m_remainingSeconds--;
+  SDL_Log("Engine::Update - Temps restant: %d s", m_remainingSeconds);
+
+  if (m_remainingSeconds <= 10 && m_remainingSeconds > 0) {
+    if (m_lastCountdownSecondPlayed != m_remainingSeconds) { 
+      AudioManager::GetInstance()->PlaySound(m_countdownSound);
+      m_lastCountdownSecondPlayed = m_remainingSeconds;
     }
   }
+  if (m_remainingSeconds == 0) {
+    SDL_Log("Engine::Update - TEMPS ECOULE! Game Over.");
+    SetGameState(STATE_GAME_OVER); // Annule ce minuteur et les autres
+  }
 }
 
-void Engine::Render() {
-  SDL_SetRenderDrawColor(m_Renderer, 0, 0, 0, 255); 
-  SDL_RenderClear(m_Renderer);
-
-  if (m_gameState == STATE_MAIN_MENU) {
-    MainMenu::GetInstance()->Render(); 
-  } else if (m_gameState == STATE_ABOUT) {
-    SDL_SetRenderDrawColor(m_Renderer, 20, 20, 50, 255); 
-    SDL_RenderClear(m_Renderer);
-    if (TextureManager::GetInstance()->QueryTexture("about_screen", nullptr, nullptr)) { 
-        TextureManager::GetInstance()->Draw("about_screen", 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
-    } else {
-        SDL_Log("Engine::Render - Texture 'about_screen' non trouvee pour l'etat STATE_ABOUT.");
-    }
-    if (m_returnPromptTexture) { 
-        SDL_Rect aboutPromptRect = m_returnPromptRect; 
-        aboutPromptRect.y = SCREEN_HEIGHT - 100; 
-        aboutPromptRect.x = (SCREEN_WIDTH - aboutPromptRect.w) / 2;
-        SDL_RenderCopy(m_Renderer, m_returnPromptTexture, NULL, &aboutPromptRect);
-    }
-  } else if (m_gameState == STATE_GAME_OVER) {
-    if (m_showGameOverScreen) {
-      SDL_SetRenderDrawColor(m_Renderer, 0, 0, 0, 255); 
-      SDL_RenderClear(m_Renderer);
-      int imgW = 0, imgH = 0;
-      if (TextureManager::GetInstance()->QueryTexture("gameover", &imgW, &imgH)) {
-        int imgX = (SCREEN_WIDTH - imgW) / 2;
-        int imgY = (SCREEN_HEIGHT - imgH) / 2;
-        TextureManager::GetInstance()->Draw("gameover", imgX, imgY, imgW, imgH);
-      } else {
-        SDL_Log("Engine::Render - Attention: Texture 'gameover' introuvable.");
-      }
-      if (m_showReturnPrompt && m_returnPromptTexture) {
-        SDL_RenderCopy(m_Renderer, m_returnPromptTexture, NULL, &m_returnPromptRect);
-      }
-    } else { 
-      int bgScrollInt = static_cast<int>(m_BackgroundScrollX);
-      TextureManager::GetInstance()->Draw("background", bgScrollInt, 0, SCREEN_WIDTH, SCREEN_HEIGHT * 0.6f); 
-      TextureManager::GetInstance()->Draw("background", bgScrollInt + SCREEN_WIDTH, 0, SCREEN_WIDTH, SCREEN_HEIGHT * 0.6f);
-      TextureManager::GetInstance()->Draw("track", 0, static_cast<int>(TRACK_Y_POSITION), SCREEN_WIDTH, static_cast<int>(TRACK_HEIGHT));
-      if (m_Player) m_Player->draw();
-      for (const auto& obs : m_obstacles) {
-        if (obs.isActive) TextureManager::GetInstance()->Draw(obs.textureId, obs.collider.x, obs.collider.y, obs.collider.w, obs.collider.h);
-      }
-      if (TextureManager::GetInstance()->QueryTexture("00", nullptr, nullptr)) {
-        TextureManager::GetInstance()->Draw("00", m_timerRect.x, m_timerRect.y, m_timerRect.w, m_timerRect.h);
-      }
-      if (m_distanceTexture) SDL_RenderCopy(m_Renderer, m_distanceTexture, NULL, &m_distanceRect);
-    }
-  } else if (m_gameState == STATE_WIN) {
-    SDL_SetRenderDrawColor(m_Renderer, 100, 180, 255, 255); 
-    SDL_RenderClear(m_Renderer);
-    int imgW = 0, imgH = 0;
-    if (TextureManager::GetInstance()->QueryTexture("win", &imgW, &imgH)) {
-      int imgX = (SCREEN_WIDTH - imgW) / 2;
-      int imgY = (SCREEN_HEIGHT - imgH) / 2;
-      TextureManager::GetInstance()->Draw("win", imgX, imgY, imgW, imgH);
-    } else {
-      SDL_Log("Engine::Render - Attention: Texture 'win' introuvable.");
-    }
-    if (m_showReturnPrompt && m_returnPromptTexture) {
-      SDL_RenderCopy(m_Renderer, m_returnPromptTexture, NULL, &m_returnPromptRect);
-    }
-  } else { 
-    int bgScrollInt = static_cast<int>(m_BackgroundScrollX);
-    TextureManager::GetInstance()->Draw("background", bgScrollInt, 0, SCREEN_WIDTH, SCREEN_HEIGHT * 0.6f); 
-    TextureManager::GetInstance()->Draw("background", bgScrollInt + SCREEN_WIDTH, 0, SCREEN_WIDTH, SCREEN_HEIGHT * 0.6f); 
+void Engine::OnDifficultyIncrease() {
+  m_obstacleSpawnInterval -= m_spawnIntervalReduction;
+  if (m_obstacleSpawnInterval < m_minSpawnInterval) {
+    m_obstacleSpawnInterval = m_minSpawnInterval;
+  }
+  SDL_Log("Engine::Update - Difficulte augmentee! Nouvel interval de spawn: %.2fs", m_obstacleSpawnInterval);
+}
 
-    TextureManager::GetInstance()->Draw("track", 0, static_cast<int>(TRACK_Y_POSITION), SCREEN_WIDTH, static_cast<int>(TRACK_HEIGHT));
+void Engine::ScheduleNextSpawn(double delay) {
+  // Intervalle variable (réduit par la difficulté) : chaque apparition programme la suivante.
+  m_timeline.After(delay, [this] {
+    SpawnObstacle();
+    // Plancher : un intervalle nul ou négatif reprogrammerait l'apparition à l'instant même et
+    // Timeline::Update ne rendrait plus la main
+    ScheduleNextSpawn(std::max(static_cast<double>(m_obstacleSpawnInterval), Timeline::MIN_INTERVAL));
+  });
+}
 
-    if (m_gameState == STATE_PLAYING) {
-      for (const auto& obs : m_obstacles) {
-        if (obs.isActive) TextureManager::GetInstance()->Draw(obs.textureId, obs.collider.x, obs.collider.y, obs.collider.w, obs.collider.h);
-      }
+void Engine::PublishSnapshot() {
+  RenderSnapshot& snapshot = m_snapshots.WriteBuffer();
+  snapshot.sequence = ++m_snapshotSequence;
+  snapshot.screen.state = m_gameState;
+  snapshot.screen.level = m_levelIndex;
+  snapshot.screen.showGameOverScreen = m_showGameOverScreen;
+  snapshot.screen.showReturnPrompt = m_showReturnPrompt;
+  snapshot.screen.remainingSeconds = m_remainingSeconds;
+  snapshot.screen.displayedDistance = m_lastDisplayedDistance;
+  snapshot.screen.menu = MainMenu::GetInstance()->GetView();
+  snapshot.backgroundScrollX = m_BackgroundScrollX;
+  snapshot.hasPlayer = m_Player && m_Player->IsDrawable();
+  if (snapshot.hasPlayer) {
+    snapshot.player.textureId = m_Player->GetTextureId();
+    snapshot.player.rect = m_Player->GetDrawRect();
+  }
+  snapshot.obstacles.clear(); // Capacité conservée d'une publication à l'autre
+  for (const auto& obs : m_obstacles) {
+    if (obs.isActive) snapshot.obstacles.push_back({ obs.textureId, obs.collider });
+  }
+  snapshot.goldenCapture = m_goldenCapture;
+  m_goldenCapture.clear();
+  snapshot.inputSequence = m_handledInputs;
+  snapshot.publishCounter = SDL_GetPerformanceCounter();
+
+  // Écran fixe modifié : Events() peut être bloqué en attente sur le thread principal.
+  bool screenChanged = snapshot.screen != m_publishedScreen &&
+                       (IsStaticScreen(snapshot.screen) || IsStaticScreen(m_publishedScreen));
+  m_publishedScreen = snapshot.screen;
+  m_snapshots.Publish(); // snapshot n'appartient plus à la simulation
+  if (screenChanged) WakeMainThread();
+}
+
+void Engine::WakeMainThread() {
+  if (!m_simThreaded) return; // Même thread : Events() ne peut pas être en attente
+  SDL_Event wake;
+  SDL_zero(wake);
+  wake.type = m_wakeEventType;
+  SDL_PushEvent(&wake);
+}
+
+void Engine::RegisterLayers() {
+  LayerCache* layers = LayerCache::GetInstance();
+  layers->Init(m_Renderer);
+
+  // Sources seules : dans un calque on copie les pixels tels quels (mise à l'échelle faite une
+  // seule fois), en rendu direct on dessine normalement.
+  auto drawSource = [](const std::string& id, int x, int y, int w, int h) {
+    if (LayerCache::GetInstance()->IsComposing()) TextureManager::GetInstance()->DrawCopy(id, x, y, w, h);
+    else TextureManager::GetInstance()->Draw(id, x, y, w, h);
+  };
+
+  layers->Register(LAYER_BACKGROUND, SCREEN_WIDTH, static_cast<int>(BACKGROUND_HEIGHT),
+    [this, drawSource](int x, int y) { drawSource(Campaign::GetBackgroundId(m_renderLevel), x, y, SCREEN_WIDTH, static_cast<int>(BACKGROUND_HEIGHT)); },
+    SDL_BLENDMODE_NONE);
+  layers->Register(LAYER_TRACK, SCREEN_WIDTH, static_cast<int>(TRACK_HEIGHT),
+    [this, drawSource](int x, int y) { drawSource(Campaign::GetTrackId(m_renderLevel), x, y, SCREEN_WIDTH, static_cast<int>(TRACK_HEIGHT)); });
+  layers->Register(LAYER_HUD_TIMER, m_timerRect.w, m_timerRect.h,
+    [this, drawSource](int x, int y) {
+      if (!m_hudTimerTextureId.empty()) drawSource(m_hudTimerTextureId, x, y, m_timerRect.w, m_timerRect.h);
+    });
+  layers->Register(LAYER_SCREEN, SCREEN_WIDTH, SCREEN_HEIGHT,
+    [this](int x, int y) { ComposeStaticScreen(x, y); },
+    SDL_BLENDMODE_NONE);
+}
+
+bool Engine::IsStaticScreen(const ScreenView& screen) const {
+  Scene* scene = m_scenes.Get(screen.state);
+  return scene != nullptr && scene->IsStatic(screen);
+}
+
+void Engine::FillScreen(Uint8 r, Uint8 g, Uint8 b) {
+  // SDL_RenderClear ignore le clipping : FillRect permet de ne repeindre que les zones sales.
+  SDL_Rect fullRect = { 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT };
+  TextureManager::GetInstance()->FillRect(fullRect, r, g, b);
+}
+
+void Engine::ComposeStaticScreen(int originX, int originY) {
+  // Le calque écran est toujours à (0,0) : originX/originY ne servent pas ici.
+  (void)originX;
+  (void)originY;
+  const RenderSnapshot& snapshot = m_snapshots.Read(); // Composition sur le thread de rendu
+  Scene* scene = m_scenes.Get(snapshot.screen.state);
+  if (scene != nullptr) scene->Render(snapshot);
+}
+
+void Engine::SetHudTimerTexture(const std::string& textureId) {
+  if (textureId != m_hudTimerTextureId) {
+    m_hudTimerTextureId = textureId;
+    LayerCache::GetInstance()->Invalidate(LAYER_HUD_TIMER); // Une fois par seconde au plus
+  }
+}
+
+void Engine::RenderScene(const RenderSnapshot& snapshot) {
+  // Le fond est opaque et couvre le haut de l'écran : seule la bande en dessous doit être effacée.
+  SDL_Rect clearRect = { 0, static_cast<int>(BACKGROUND_HEIGHT), SCREEN_WIDTH, SCREEN_HEIGHT - static_cast<int>(BACKGROUND_HEIGHT) };
+  TextureManager::GetInstance()->FillRect(clearRect, 0, 0, 0);
+
+  int bgScrollInt = static_cast<int>(snapshot.backgroundScrollX);
+  LayerCache::GetInstance()->Draw(LAYER_BACKGROUND, bgScrollInt, 0);
+  LayerCache::GetInstance()->Draw(LAYER_BACKGROUND, bgScrollInt + SCREEN_WIDTH, 0);
+  LayerCache::GetInstance()->Draw(LAYER_TRACK, 0, static_cast<int>(TRACK_Y_POSITION));
+
+  auto drawSprite = [](const SpriteView& sprite) {
+    TextureManager::GetInstance()->Draw(sprite.textureId, sprite.rect.x, sprite.rect.y, sprite.rect.w, sprite.rect.h);
+  };
+
+  if (snapshot.screen.state == STATE_GAME_OVER) {
+    // Scène figée avant l'écran Game Over : le joueur sous les obstacles, minuteur à zéro.
+    if (snapshot.hasPlayer) drawSprite(snapshot.player);
+    for (const auto& obs : snapshot.obstacles) drawSprite(obs);
+    SetHudTimerTexture(TextureManager::GetInstance()->IsTextureLoaded("00") ? "00" : "");
+  } else {
+    if (snapshot.screen.state == STATE_PLAYING) {
+      for (const auto& obs : snapshot.obstacles) drawSprite(obs);
     }
 
-    if (m_Player) m_Player->draw();
+    if (snapshot.hasPlayer) drawSprite(snapshot.player);
 
-    if (m_gameState == STATE_START_SCREEN) {
-      if (TextureManager::GetInstance()->QueryTexture("start", nullptr, nullptr)) {
-          TextureManager::GetInstance()->Draw("start", m_timerRect.x, m_timerRect.y, m_timerRect.w, m_timerRect.h);
+    if (snapshot.screen.state == STATE_START_SCREEN) {
+      if (TextureManager::GetInstance()->IsTextureLoaded("start")) {
+          SetHudTimerTexture("start");
       } else {
           SDL_Log("Engine::Render - Texture 'start' non trouvee pour STATE_START_SCREEN.");
+          SetHudTimerTexture("");
       }
-    } else if (m_gameState == STATE_PLAYING) {
+    } else if (snapshot.screen.state == STATE_PLAYING) {
       std::string currentTimerTextureId = "end"; 
-      if (m_remainingSeconds > 0 && m_remainingSeconds <= 60) {
+      if (snapshot.screen.remainingSeconds > 0 && snapshot.screen.remainingSeconds <= 60) {
         std::ostringstream ss;
-        ss << std::setw(2) << std::setfill('0') << m_remainingSeconds;
+        ss << std::setw(2) << std::setfill('0') << snapshot.screen.remainingSeconds;
         currentTimerTextureId = ss.str();
-      } else if (m_remainingSeconds > 60) { 
+      } else if (snapshot.screen.remainingSeconds > 60) { 
           currentTimerTextureId = "start"; 
       }
       
-      if (TextureManager::GetInstance()->QueryTexture(currentTimerTextureId, nullptr, nullptr)) {
-          TextureManager::GetInstance()->Draw(currentTimerTextureId, m_timerRect.x, m_timerRect.y, m_timerRect.w, m_timerRect.h);
+      if (TextureManager::GetInstance()->IsTextureLoaded(currentTimerTextureId)) {
+          SetHudTimerTexture(currentTimerTextureId);
       } else {
           SDL_Log("Engine::Render - Texture timer '%s' non trouvee.", currentTimerTextureId.c_str());
-          if (TextureManager::GetInstance()->QueryTexture("00", nullptr, nullptr)) {
-            TextureManager::GetInstance()->Draw("00", m_timerRect.x, m_timerRect.y, m_timerRect.w, m_timerRect.h);
-          }
+          SetHudTimerTexture(TextureManager::GetInstance()->IsTextureLoaded("00") ? "00" : "");
       }
     }
+  }
+  LayerCache::GetInstance()->Draw(LAYER_HUD_TIMER, m_timerRect.x, m_timerRect.y);
 
-    if (m_distanceTexture != nullptr) {
-      SDL_RenderCopy(m_Renderer, m_distanceTexture, NULL, &m_distanceRect);
+  if (TextureManager::GetInstance()->IsTextureLoaded(HUD_DISTANCE_TEXTURE)) {
+    TextureManager::GetInstance()->Draw(HUD_DISTANCE_TEXTURE, m_distanceRect.x, m_distanceRect.y, m_distanceRect.w, m_distanceRect.h);
+  }
+}
+
+void Engine::UpdateGoldenRun() {
+  // Parcours scripté pour les tests de non-régression visuelle : chaque état est capturé une fois
+  // stable (écrans de fin : message "Retour" affiché), puis le jeu se ferme.
+  struct GoldenStep { GameState state; const char* name; int minFrames; };
+  static const GoldenStep steps[] = {
+    { STATE_START_SCREEN, "start_screen", 30 },
+    { STATE_PLAYING, "playing", 45 },
+    { STATE_WIN, "win", 30 },
+    { STATE_GAME_OVER, "game_over", 30 }
+  };
+  const int stepCount = static_cast<int>(sizeof(steps) / sizeof(steps[0]));
+
+  if (m_goldenStep >= stepCount) {
+    Quit();
+    return;
+  }
+  const GoldenStep& step = steps[m_goldenStep];
+  if (m_gameState != step.state) {
+    SetGameState(step.state);
+    m_goldenFrames = 0;
+    return;
+  }
+  ++m_goldenFrames;
+  bool settled = m_goldenFrames >= step.minFrames;
+  if (step.state == STATE_WIN || step.state == STATE_GAME_OVER) settled = settled && m_showReturnPrompt;
+  if (settled) {
+    SDL_Log("Engine::UpdateGoldenRun - Capture de reference '%s'.", step.name);
+    m_goldenCapture = step.name;
+    ++m_goldenStep;
+  }
+}
+
+void Engine::RenderDebugOverlay() {
+  RenderStats* stats = RenderStats::GetInstance();
+  stats->RenderHeatmap();
+
+  // Texte des compteurs de la dernière image, regénéré deux fois par seconde environ.
+  if (m_uiFont && (m_renderStatsFrame++ % 30) == 0) {
+    std::string text = std::string(GameStateName(m_snapshots.Read().screen.state)) + " | " + stats->Describe(stats->GetLastFrame()) +
+                       " | " + LatencyTracker::GetInstance()->Describe() +
+                       " | " + AudioManager::GetInstance()->GetMonitor().Describe();
+    SDL_Color textColor = { 255, 255, 255, 255 };
+    SDL_Surface* surface = TTF_RenderText_Blended(m_uiFont, text.c_str(), textColor);
+    if (surface) {
+      if (TextureManager::GetInstance()->LoadFromSurface(RENDER_STATS_TEXTURE, surface)) {
+        m_renderStatsRect = { 15, SCREEN_HEIGHT - surface->h - 15, surface->w, surface->h };
+      }
+      SDL_FreeSurface(surface);
     }
   }
+  if (TextureManager::GetInstance()->IsTextureLoaded(RENDER_STATS_TEXTURE)) {
+    SDL_Rect background = { m_renderStatsRect.x - 5, m_renderStatsRect.y - 5, m_renderStatsRect.w + 10, m_renderStatsRect.h + 10 };
+    TextureManager::GetInstance()->FillRect(background, 0, 0, 0);
+    TextureManager::GetInstance()->Draw(RENDER_STATS_TEXTURE, m_renderStatsRect.x, m_renderStatsRect.y, m_renderStatsRect.w, m_renderStatsRect.h);
+  }
+}
 
+void Engine::ApplyScreenChanges(const ScreenView& screen) {
+  // Les calques et les textures ne sont touchés que sur le thread de rendu : les changements
+  // de la simulation sont déduits de la différence entre deux instantanés.
+  if (screen.state != m_appliedScreen.state || screen.showGameOverScreen != m_appliedScreen.showGameOverScreen) {
+    LayerCache::GetInstance()->Invalidate(LAYER_SCREEN);
+  } else if (screen.showReturnPrompt != m_appliedScreen.showReturnPrompt) {
+    LayerCache::GetInstance()->InvalidateRect(LAYER_SCREEN, m_returnPromptRect);
+  }
+  if (screen.state == STATE_MAIN_MENU) {
+    MainMenu::GetInstance()->InvalidateChanges(m_appliedScreen.menu, screen.menu);
+  }
+
+  bool levelChanged = screen.level != m_appliedScreen.level;
+  if (levelChanged) {
+    // Calques recomposés avec les textures du nouveau niveau ; on ne garde en mémoire que celles
+    // du niveau courant et du suivant (la simulation redemande un groupe libéré trop tôt).
+    m_renderLevel = screen.level;
+    LayerCache::GetInstance()->Invalidate(LAYER_BACKGROUND);
+    LayerCache::GetInstance()->Invalidate(LAYER_TRACK);
+    for (int level = m_appliedScreen.level; level <= m_appliedScreen.level + 1; ++level) {
+      if (level != screen.level && level != screen.level + 1) {
+        TexturePreloader::GetInstance()->Release(Campaign::GetGroupName(level));
+      }
+    }
+  }
+
+  if (screen.displayedDistance != m_appliedScreen.displayedDistance || levelChanged) {
+    if (screen.displayedDistance < 0) {
+      if (TextureManager::GetInstance()->IsTextureLoaded(HUD_DISTANCE_TEXTURE)) {
+        TextureManager::GetInstance()->Drop(HUD_DISTANCE_TEXTURE);
+      }
+    } else if (m_uiFont) {
+      const LevelDef& level = Campaign::GetInstance()->GetLevel(screen.level);
+      std::stringstream ssDistance;
+      ssDistance << level.name << " (" << screen.level + 1 << "/" << Campaign::GetInstance()->GetLevelCount() << ") - Distance: "
+                 << screen.displayedDistance << " m / " << static_cast<int>(level.distance / 10.0f) << " m";
+      SDL_Color textColor = { 0, 0, 0, 255 }; 
+      SDL_Surface* surface = TTF_RenderText_Blended(m_uiFont, ssDistance.str().c_str(), textColor); 
+      if (surface) {
+        if (TextureManager::GetInstance()->LoadFromSurface(HUD_DISTANCE_TEXTURE, surface)) {
+          m_distanceRect.w = surface->w;
+          m_distanceRect.h = surface->h;
+        } else {
+          SDL_Log("Engine::ApplyScreenChanges - Echec creation texture distance: %s", SDL_GetError());
+        }
+        SDL_FreeSurface(surface);
+      } else {
+        SDL_Log("Engine::ApplyScreenChanges - Echec creation surface distance: %s", TTF_GetError());
+      }
+    }
+  }
+  m_appliedScreen = screen;
+}
+
+void Engine::Render() {
+  if (m_suspended) {
+    LatencyTracker::GetInstance()->DropPending();
+    return;
+  }
+  // Textures des scènes suivantes : quelques millisecondes par image, même sur un écran fixe.
+  TexturePreloader::GetInstance()->Pump(PRELOAD_BUDGET_MS);
+  // Assets modifiés sur le disque (--hot-reload) : calques recomposés avec les nouvelles textures.
+  if (AssetWatcher::GetInstance()->Poll() > 0) {
+    LayerCache::GetInstance()->InvalidateAll();
+    m_redrawRequested = true;
+  }
+
+  bool fresh = m_snapshots.Consume();
+  const RenderSnapshot& snapshot = m_snapshots.Read();
+  if (fresh) ApplyScreenChanges(snapshot.screen);
+  // Une capture de référence n'est faite qu'une fois, avec l'instantané qui l'a demandée.
+  const char* goldenCapture = (fresh && !snapshot.goldenCapture.empty()) ? snapshot.goldenCapture.c_str() : nullptr;
+
+  // Écran fixe inchangé : l'image déjà présentée reste valable.
+  if (IsStaticScreen(snapshot.screen) && !m_redrawRequested && goldenCapture == nullptr &&
+      !LayerCache::GetInstance()->IsDirty(LAYER_SCREEN) && !RenderStats::GetInstance()->IsHeatmapEnabled()) {
+    LatencyTracker::GetInstance()->OnFrameSkipped(snapshot.inputSequence);
+    return;
+  }
+  m_redrawRequested = false;
+
+  RenderScaler::GetInstance()->BeginFrame();
+  RenderStats::GetInstance()->BeginFrame(GameStateName(snapshot.screen.state));
+
+  if (IsStaticScreen(snapshot.screen)) {
+    // Écrans fixes : le calque opaque couvre tout l'écran, pas d'effacement, et seules les zones
+    // invalidées (survol de bouton, message "Retour") sont recomposées.
+    LayerCache::GetInstance()->Draw(LAYER_SCREEN, 0, 0);
+  } else if (Scene* scene = m_scenes.Get(snapshot.screen.state)) {
+    scene->Render(snapshot);
+  }
+
+  RenderStats::GetInstance()->EndFrame();
+  if (RenderStats::GetInstance()->IsHeatmapEnabled()) {
+    RenderDebugOverlay(); // Hors statistiques
+  }
+
+  RenderScaler::GetInstance()->EndFrame();
+  if (SoftRenderer::GetInstance()->IsActive()) {
+    SoftRenderer::GetInstance()->Present();
+  }
+  FrameCapture::GetInstance()->EndFrame(goldenCapture);
+  FramePacer::GetInstance()->MarkPresent();
   SDL_RenderPresent(m_Renderer);
+  LatencyTracker::GetInstance()->OnFramePresented(snapshot.inputSequence, snapshot.publishCounter);
+}
+
+bool Engine::ShouldWaitForEvents() const {
+  if (m_config.golden) return false; // Parcours scripté : jamais d'attente
+  if (m_suspended) return true;
+  // Écran fixe déjà présenté et rien à animer : seul un événement ou un délai peut le changer.
+  // Avec le thread de simulation, un écran fixe modifié réveille l'attente (voir PublishSnapshot).
+  const ScreenView& screen = m_snapshots.Read().screen;
+  if (!IsStaticScreen(screen) || m_redrawRequested) return false;
+  if (LayerCache::GetInstance()->IsDirty(LAYER_SCREEN)) return false;
+  if (m_scenes.Get(screen.state)->IsAnimating(screen)) return false;
+  return !RenderStats::GetInstance()->IsHeatmapEnabled();
+}
+
+Uint32 Engine::IdleWaitTimeout() const {
+  // Préchargement en cours : Render() doit passer régulièrement pour créer les textures.
+  if (!m_suspended && TexturePreloader::GetInstance()->HasWork()) return PRELOAD_POLL_MS;
+  Uint32 maxWait = AssetWatcher::GetInstance()->IsActive() ? HOT_RELOAD_POLL_MS : IDLE_WAIT_MAX_MS;
+  if (m_simThreaded) return maxWait; // La simulation réveille Events() elle-même
+  // Prochain minuteur de la Timeline (ex: message "Retour" des écrans de fin). Le temps restant
+  // part du dernier Tick : au pire une image de retard sur son déclenchement.
+  const GameClock* clock = GameClock::GetInstance();
+  if (!m_suspended && !m_timeline.IsEmpty() && clock->GetTimeScale() > 0.0) {
+    double remaining = (m_timeline.NextDue() - clock->Now()) / clock->GetTimeScale();
+    if (remaining <= 0.0) return 0;
+    return std::min(static_cast<Uint32>(remaining * 1000.0) + 1, maxWait);
+  }
+  return maxWait;
+}
+
+void Engine::Suspend(const char* reason) {
+  if (m_suspended || m_config.golden) return;
+  m_suspended = true;
+  m_suspendStartTime = SDL_GetTicks();
+  GameClock::GetInstance()->SetPaused(true); // Arrête tous les minuteurs du jeu
+  AudioManager::GetInstance()->PauseAll();
+  AudioManager::GetInstance()->ApplyPendingBuffer(); // Tout est en pause : réouverture inaudible
+  SDL_Log("Engine::Suspend - Jeu suspendu (%s).", reason);
+}
+
+void Engine::Resume() {
+  if (!m_suspended) return;
+  m_suspended = false;
+  Uint32 pausedMs = SDL_GetTicks() - m_suspendStartTime;
+  GameClock::GetInstance()->SetPaused(false); // Pas de saut de m_deltaTime à la reprise
+  AudioManager::GetInstance()->ResumeAll();
+  m_redrawRequested = true;
+  WakeMainThread();
+  SDL_Log("Engine::Resume - Reprise apres %u ms de pause.", pausedMs);
 }
 
 void Engine::Events() {
   SDL_Event event;
-  while (SDL_PollEvent(&event)) {
-    if (event.type == SDL_QUIT) {
-      Quit(); 
-      return; 
-    }
+  // Fenêtre suspendue ou écran fixe inchangé : bloquer jusqu'au prochain événement (ou délai)
+  // au lieu de reboucler à pleine cadence.
+  if (ShouldWaitForEvents()) {
+    bool received = SDL_WaitEventTimeout(&event, static_cast<int>(IdleWaitTimeout())) != 0;
+    FramePacer::GetInstance()->Resync();
+    if (received) DispatchEvent(event);
+  }
+  while (m_IsRunning && SDL_PollEvent(&event)) {
+    DispatchEvent(event);
+  }
+}
 
-    if (event.type == SDL_KEYDOWN) {
-        switch (event.key.keysym.sym) {
-            case SDLK_m: ToggleMute(); break;
-            case SDLK_PAGEUP: IncreaseVolume(); break; 
-            case SDLK_PAGEDOWN: DecreaseVolume(); break; 
-        }
+void Engine::DispatchEvent(SDL_Event& event) {
+  if (event.type == m_wakeEventType) return; // Réveil seul, voir WakeMainThread
+  if (LatencyTracker::IsTrackedInput(event)) LatencyTracker::GetInstance()->OnInputReceived(event);
+
+  // Partie rendu : traitée ici, sur le thread qui possède le renderer.
+  if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET) {
+    SDL_Log("Engine::Events - Textures cibles perdues, recomposition de tous les calques.");
+    LayerCache::GetInstance()->InvalidateAll();
+  } else if (event.type == SDL_WINDOWEVENT) {
+    switch (event.window.event) {
+      case SDL_WINDOWEVENT_SHOWN:
+      case SDL_WINDOWEVENT_EXPOSED:
+      case SDL_WINDOWEVENT_SIZE_CHANGED:
+      case SDL_WINDOWEVENT_RESTORED:
+      case SDL_WINDOWEVENT_FOCUS_GAINED:
+        m_redrawRequested = true; // Contenu de la fenêtre à représenter
+        break;
     }
+  } else if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F3) {
+    RenderStats::GetInstance()->SetHeatmapEnabled(!RenderStats::GetInstance()->IsHeatmapEnabled());
+    m_renderStatsFrame = 0;
+    m_redrawRequested = true;
+  }
 
-    switch (m_gameState) {
-      case STATE_MAIN_MENU:
-        MainMenu::GetInstance()->HandleEvent(event); 
-        break;
-      case STATE_ABOUT:
-        if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_ESCAPE) {
-          SDL_Log("Engine::Events - STATE_ABOUT: Echap appuye, retour au menu principal.");
-          SetGameState(STATE_MAIN_MENU);
-        }
-        break;
-      case STATE_START_SCREEN:
-        if (event.type == SDL_KEYDOWN && (event.key.keysym.sym == SDLK_RIGHT || event.key.keysym.sym == SDLK_SPACE || event.key.keysym.sym == SDLK_RETURN) ) {
-          SDL_Log("Engine::Events - STATE_START_SCREEN: Touche de demarrage appuyee, passage a STATE_PLAYING.");
-          SetGameState(STATE_PLAYING); 
-        }
-        if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_ESCAPE) {
-            SDL_Log("Engine::Events - STATE_START_SCREEN: Echap appuye, retour au menu principal.");
-            SetGameState(STATE_MAIN_MENU);
-        }
+  if (!m_simThreaded) {
+    HandleEvent(event);
+    return;
+  }
+  // File pleine : la simulation a pris du retard, on attend plutôt que de perdre une entrée.
+  while (!m_simEvents.Push(event) && m_IsRunning) {
+    SDL_Delay(1);
+  }
+}
+
+void Engine::HandleEvent(SDL_Event& event) {
+  if (LatencyTracker::IsTrackedInput(event)) ++m_handledInputs; // Même numérotation que DispatchEvent
+
+  if (event.type == SDL_QUIT) {
+    Quit(); 
+    return; 
+  }
+
+  if (event.type == SDL_WINDOWEVENT) {
+    switch (event.window.event) {
+      case SDL_WINDOWEVENT_MINIMIZED:
+        Suspend("fenetre reduite");
         break;
-      case STATE_PLAYING:
-        if (m_Player && (event.type == SDL_KEYDOWN || event.type == SDL_KEYUP) && event.key.repeat == 0) {
-          m_Player->handleEvent(event);
-        }
-        if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_ESCAPE) {
-          SDL_Log("Engine::Events - STATE_PLAYING: Echap appuye, retour au menu principal.");
-          SetGameState(STATE_MAIN_MENU); 
-        }
+      case SDL_WINDOWEVENT_FOCUS_LOST:
+        if (m_config.pauseOnFocusLoss) Suspend("perte du focus");
         break;
-      case STATE_GAME_OVER:
-      case STATE_WIN:
-        if (event.type == SDL_KEYDOWN) {
-            if (event.key.keysym.sym == SDLK_r || event.key.keysym.sym == SDLK_RETURN || event.key.keysym.sym == SDLK_SPACE) {
-                SDL_Log("Engine::Events - STATE_GAME_OVER/WIN: Touche 'R' (ou Entree/Espace) appuyee, redemarrage.");
-                SetGameState(STATE_START_SCREEN); 
-            } else if (event.key.keysym.sym == SDLK_ESCAPE) {
-                SDL_Log("Engine::Events - STATE_GAME_OVER/WIN: Echap appuye, retour au menu principal.");
-                SetGameState(STATE_MAIN_MENU);
-            }
-        }
+      case SDL_WINDOWEVENT_RESTORED:
+      case SDL_WINDOWEVENT_FOCUS_GAINED:
+        if (!(SDL_GetWindowFlags(m_Window) & SDL_WINDOW_MINIMIZED)) Resume();
         break;
     }
   }
+
+  if (event.type == SDL_KEYDOWN) {
+      switch (event.key.keysym.sym) {
+          case SDLK_m: ToggleMute(); break;
+          case SDLK_PAGEUP: IncreaseVolume(); break; 
+          case SDLK_PAGEDOWN: DecreaseVolume(); break; 
+      }
+  }
+
+  Scene* scene = m_scenes.GetActive();
+  if (scene != nullptr) scene->HandleEvent(event);
 }
 
 bool Engine::Clean() {
   SDL_Log("Engine::Clean() - Nettoyage du moteur...");
+  StopSimulationThread(); // Avant de détruire ce que la simulation utilise
 
-  if (m_returnPromptTexture) {
-    SDL_DestroyTexture(m_returnPromptTexture);
-    m_returnPromptTexture = nullptr;
-    SDL_Log("Engine::Clean() - Texture 'Retour au menu' detruite.");
-  }
-  if (m_distanceTexture != nullptr) {
-    SDL_DestroyTexture(m_distanceTexture);
-    m_distanceTexture = nullptr;
-    SDL_Log("Engine::Clean() - Texture 'Distance' detruite.");
-  }
   m_obstacles.clear();
   m_obstacleTextureIds.clear();
   m_timerTextures.clear(); // Les textures elles-mêmes sont gérées par TextureManager
@@ -799,12 +1187,31 @@ bool Engine::Clean() {
   // MainMenu::GetInstance()->Clean(); // Si MainMenu a une méthode Clean publique
   // delete MainMenu::GetInstance(); // Si vous voulez supprimer l'instance du singleton
 
+  m_scenes.Clean();
+  AssetWatcher::GetInstance()->Stop();
+  TexturePreloader::GetInstance()->Clean(); // Attend les décodages en cours, avant JobSystem
   TextureManager::GetInstance()->Clean(); 
   SDL_Log("Engine::Clean() - TextureManager nettoye.");
 
+  AudioManager::GetInstance()->LogMemoryReport(); // Pic de la session
+  AudioManager::GetInstance()->LogVoiceReport();
   AudioManager::GetInstance()->Clean(); 
   SDL_Log("Engine::Clean() - AudioManager nettoye.");
 
+  if (RenderScaler::GetInstance()->IsActive()) {
+    ScalerStats scalerStats = RenderScaler::GetInstance()->GetStats();
+    SDL_Log("Engine::Clean() - Resolution dynamique: echelle finale %.2f (%dx%d), %d changements, dernier: %s",
+            scalerStats.scale, scalerStats.renderWidth, scalerStats.renderHeight, scalerStats.changeCount, scalerStats.lastChangeReason.c_str());
+  }
+  FrameCapture::GetInstance()->Clean();
+  FramePacer::GetInstance()->Clean();
+  LatencyTracker::GetInstance()->Clean();
+  RenderStats::GetInstance()->Clean();
+  RenderScaler::GetInstance()->Clean();
+  LayerCache::GetInstance()->Clean();
+  SoftRenderer::GetInstance()->Clean();
+  JobSystem::GetInstance()->Clean();
+
   if (m_Renderer) {
     SDL_DestroyRenderer(m_Renderer);
     m_Renderer = nullptr;
@@ -827,6 +1234,53 @@ bool Engine::Clean() {
   return true;
 }
 
+void Engine::StartSimulationThread() {
+  m_wakeEventType = SDL_RegisterEvents(1);
+  if (m_wakeEventType == static_cast<Uint32>(-1)) {
+    SDL_Log("Engine::StartSimulationThread - Attention: plus d'evenement utilisateur libre, simulation sur le thread principal.");
+    m_wakeEventType = 0;
+    return;
+  }
+  m_simThreaded = true;
+  m_simThread = std::thread(&Engine::SimulationLoop, this);
+  SDL_Log("Engine::StartSimulationThread - Simulation sur un thread dedie a %d Hz.", m_config.simHz);
+}
+
+void Engine::StopSimulationThread() {
+  if (!m_simThread.joinable()) return;
+  m_IsRunning = false;
+  m_simThread.join();
+  m_simThreaded = false;
+  SDL_Log("Engine::StopSimulationThread - Thread de simulation arrete.");
+}
+
+void Engine::SimulationLoop() {
+  // Cadence fixe indépendante du rendu : une présentation lente (synchro verticale) ne retarde
+  // plus ni les entrées ni la simulation. Update() prend son pas dans GameClock.
+  const Uint64 frequency = SDL_GetPerformanceFrequency();
+  const Uint64 period = frequency / static_cast<Uint64>(m_config.simHz);
+  Uint64 nextTick = SDL_GetPerformanceCounter();
+
+  while (m_IsRunning) {
+    SDL_Event event;
+    while (m_IsRunning && m_simEvents.Pop(event)) {
+      HandleEvent(event);
+    }
+    if (!m_IsRunning) break;
+    Update(); // Publie l'instantané (rien quand le jeu est suspendu)
+
+    nextTick += period;
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (now >= nextTick) {
+      if (now - nextTick > period * 4) nextTick = now; // Trop de retard : on repart de maintenant
+      continue;
+    }
+    Uint32 remainingMs = static_cast<Uint32>((nextTick - now) * 1000 / frequency);
+    SDL_Delay(m_suspended ? SUSPENDED_SIM_DELAY_MS : (remainingMs > 0 ? remainingMs : 1));
+    if (m_suspended) nextTick = SDL_GetPerformanceCounter();
+  }
+}
+
 void Engine::Quit() {
   m_IsRunning = false; 
   SDL_Log("Engine::Quit() - Moteur marque pour fermeture.");
@@ -1,13 +1,23 @@
 #ifndef ENGINE_H
 #define ENGINE_H
 
+#include <atomic>
 #include <vector>
 #include <string>
 #include <random>
+#include <thread>
 #include "SDL.h"
 #include "SDL_image.h"
 #include "SDL_ttf.h"
 #include "Obstacle.h" // Assurez-vous que ce chemin est correct et que Obstacle.h existe
+#include "Config.h"
+#include "RenderSnapshot.h"
+#include "SpscQueue.h"
+#include "Timeline.h"
+#include "TripleBuffer.h"
+#include "../Audio/AudioManager.h"
+#include "../Graphics/TexturePreloader.h"
+#include "../Scenes/SceneStack.h"
 
 // Dimensions réelles de la fenêtre utilisée dans SDL_CreateWindow
 #define SCREEN_WIDTH 1920
@@ -15,16 +25,18 @@
 #define VOLUME_MAX 128
 #define VOLUME_STEP 8
 
-class Player; // Déclaration anticipée
+// Calques de LayerCache
+#define LAYER_BACKGROUND "background"
+#define LAYER_TRACK "track"
+#define LAYER_HUD_TIMER "hud_timer"
+#define LAYER_SCREEN "screen" // Écrans fixes : menu, à propos, victoire, game over
 
-enum GameState {
-    STATE_MAIN_MENU,
-    STATE_START_SCREEN,
-    STATE_PLAYING,
-    STATE_GAME_OVER,
-    STATE_ABOUT,
-    STATE_WIN
-};
+// Textes générés au lancement ou en jeu, stockés dans TextureManager
+#define RETURN_PROMPT_TEXTURE "return_prompt"
+#define HUD_DISTANCE_TEXTURE "hud_distance"
+#define RENDER_STATS_TEXTURE "render_stats"
+
+class Player; // Déclaration anticipée
 
 class Engine
 {
@@ -37,18 +49,31 @@ public:
         return s_Instance;
     }
 
+    inline void SetConfig(const EngineConfig& config) { m_config = config; } // Avant Init()
+    inline const EngineConfig& GetConfig() const { return m_config; }
+
     bool Init();
     bool Clean();
     void Quit();
+    // Musiques et sons du jeu, avec leurs priorités de voix (aussi pour --bench audio)
+    void LoadAudio();
 
+    // Boucle principale : Events() puis Render() sur le thread qui possède la fenêtre et le
+    // renderer. Update() y est aussi appelé, sauf si la simulation a son propre thread.
     void Update();
     void Render();
     void Events();
+    void HandleEvent(SDL_Event& event); // Thread de simulation
+    inline bool IsSimulationThreaded() const { return m_simThreaded; }
 
     inline bool IsRunning() const { return m_IsRunning; }
     inline SDL_Renderer* GetRenderer() { return m_Renderer; }
-    inline GameState GetGameState() const { return m_gameState; }
+    inline GameState GetGameState() const { return m_gameState; } // Thread de simulation
+    // Transitions de scène (thread de simulation), appliquées dès que les textures de la scène
+    // visée sont préchargées : SetGameState remplace la pile, PushScene/PopScene empilent.
     void SetGameState(GameState newState);
+    void PushScene(GameState state);
+    void PopScene();
 
     void IncreaseVolume();
     void DecreaseVolume();
@@ -57,44 +82,42 @@ public:
     inline int GetMasterVolume() const { return m_currentMasterVolume; }
 
 private:
+    // Les scènes pilotent l'état de la partie et dessinent avec les outils du moteur
+    friend class MenuScene;
+    friend class AboutScene;
+    friend class StartScene;
+    friend class PlayingScene;
+    friend class EndScene;
+
     Engine() :
         m_IsRunning(false),
         m_Window(nullptr),
         m_Renderer(nullptr),
         m_Player(nullptr),
-        m_lastTick(0),
         m_deltaTime(0.0f),
         m_BackgroundScrollX(0.0f),
         m_remainingSeconds(60),
-        m_lastSecondUpdate(0),
         m_gameState(STATE_START_SCREEN),
-        m_gameOverStartTime(0),
         m_showGameOverScreen(false),
         m_obstacleSpawnInterval(2.3f),
-        m_timeSinceLastSpawn(0.0f),
         m_minSpawnInterval(0.55f),
-        m_lastDifficultyIncreaseTime(0),
-        m_difficultyIncreaseInterval(6000),
+        m_difficultyIncreaseInterval(6.0),
         m_spawnIntervalReduction(0.18f),
         m_obstacleTextureWidth(0),
         m_obstacleTextureHeight(0),
         m_rng(std::random_device{}()),
-        m_lastMaxSpeedIncreaseTime(0),
-        m_maxSpeedIncreaseInterval(1000),
+        m_maxSpeedIncreaseInterval(1.0),
         m_maxSpeedIncreaseAmount(20.0f),
         m_absoluteMaxPlayerSpeed(2000.0f),
         m_doubleSpawnChance(40),
         m_totalDistanceTraveled(0.0f),
         m_uiFont(nullptr),
-        m_distanceTexture(nullptr),
         m_lastDisplayedDistance(-1),
         m_lastCountdownSecondPlayed(-1),
         m_currentMasterVolume(VOLUME_MAX / 2),
         m_isMuted(false),
         m_volumeBeforeMute(VOLUME_MAX / 2),
-        m_returnPromptTexture(nullptr),
-        m_showReturnPrompt(false),
-        m_endScreenStartTime(0)
+        m_showReturnPrompt(false)
     {
         m_timerRect = {SCREEN_WIDTH - 120, 20, 100, 50};
     }
@@ -105,58 +128,143 @@ private:
     int m_volumeBeforeMute;
     void ApplyMasterVolume();
 
-    SDL_Texture* m_returnPromptTexture;
-    SDL_Rect m_returnPromptRect;
+    SDL_Rect m_returnPromptRect; // Texture RETURN_PROMPT_TEXTURE du TextureManager
+    SDL_Rect m_aboutPromptRect;
     bool m_showReturnPrompt;
-    Uint32 m_endScreenStartTime;
-    const Uint32 RETURN_PROMPT_DELAY = 1500; 
+    // Délais des écrans de fin, en secondes de GameClock
+    const double RETURN_PROMPT_DELAY = 1.5;
+    const double GAME_OVER_SCREEN_DELAY = 2.0;
 
-    bool m_IsRunning;
+    EngineConfig m_config;
+    std::atomic<bool> m_IsRunning;
     SDL_Window* m_Window;
     SDL_Renderer* m_Renderer;
     static Engine* s_Instance;
     Player* m_Player; 
-    Uint32 m_lastTick;
-    float m_deltaTime;
+    float m_deltaTime; // Pas de GameClock, borné à MAX_FRAME_DELTA pour la physique
+    const float MAX_FRAME_DELTA = 0.05f;
     float m_BackgroundScrollX;
     std::vector<float> m_laneYPositions;
     const float TRACK_Y_POSITION = SCREEN_HEIGHT * 0.6f; 
     const float TRACK_HEIGHT = SCREEN_HEIGHT * 0.3f;   
+    const float BACKGROUND_HEIGHT = SCREEN_HEIGHT * 0.6f;
 
     int m_remainingSeconds;
-    Uint32 m_lastSecondUpdate;
     std::vector<std::string> m_timerTextures; 
     SDL_Rect m_timerRect; 
+    std::string m_hudTimerTextureId; // Texture composée dans le calque LAYER_HUD_TIMER
 
     GameState m_gameState;
-    Uint32 m_gameOverStartTime; // Initialisé dans SetGameState pour GAME_OVER
     bool m_showGameOverScreen;
     std::vector<Obstacle> m_obstacles;
     float m_obstacleSpawnInterval;
-    float m_timeSinceLastSpawn;
     float m_minSpawnInterval;
-    Uint32 m_lastDifficultyIncreaseTime;
-    const Uint32 m_difficultyIncreaseInterval; 
+    double m_difficultyIncreaseInterval;
     float m_spawnIntervalReduction;
     int m_obstacleTextureWidth;
     int m_obstacleTextureHeight;
     std::vector<std::string> m_obstacleTextureIds;
     std::mt19937 m_rng; 
-    Uint32 m_lastMaxSpeedIncreaseTime;
-    const Uint32 m_maxSpeedIncreaseInterval; 
-    const float m_maxSpeedIncreaseAmount;
+    const double m_maxSpeedIncreaseInterval;
+    float m_maxSpeedIncreaseAmount;
     const float m_absoluteMaxPlayerSpeed;
-    const int m_doubleSpawnChance; 
+    const float ENGINE_SOUND_TOP_SPEED = 800.0f; // Vitesse au régime maximal du son moteur (voir EngineSynth)
+    int m_doubleSpawnChance; 
     float m_totalDistanceTraveled;
-    const float WIN_DISTANCE = 40000.0f; 
 
     TTF_Font* m_uiFont;
-    SDL_Rect m_distanceRect = { 15, 15, 0, 0 }; 
-    SDL_Texture* m_distanceTexture;
+    SDL_Rect m_distanceRect = { 15, 15, 0, 0 }; // Texture HUD_DISTANCE_TEXTURE du TextureManager
     int m_lastDisplayedDistance;
     int m_lastCountdownSecondPlayed;
+    SoundHandle m_crashSound = INVALID_SOUND; // Sons joués pendant la course, sans recherche par nom
+    SoundHandle m_countdownSound = INVALID_SOUND;
 
     void SpawnObstacle();
+
+    // Scènes (voir src/Scenes) et textures de la course, préchargées pendant le menu
+    void RegisterScenes();
+    void OnSceneTransition(GameState previous, GameState next);
+    TextureList GetRunTextures() const;
+    bool PrepareRunAssets(); // Joueur, à la première entrée sur l'écran de départ
+    void ResetRun();
+    void UpdateRun(float deltaTime);
+    SceneStack m_scenes;
+    bool m_runAssetsReady = false;
+    const double PRELOAD_BUDGET_MS = 2.0; // Création de textures par image, voir TexturePreloader::Pump
+    const Uint32 PRELOAD_POLL_MS = 5;     // Attente d'événements bornée tant que le préchargement avance
+
+    // Campagne (voir Campaign) : seuls le niveau courant et le suivant gardent leurs textures.
+    // La simulation demande leur chargement, le rendu libère les autres au changement de niveau.
+    void SelectLevel(int index);
+    TexturePreloader::GroupState RequestLevel(int index, bool retryFailed = false);
+    bool IsLevelReady();
+    bool PrepareLevel(); // Obstacles du niveau courant
+    void ApplyLevel();   // Compte à rebours et courbe de difficulté du niveau, course remise à zéro
+    void AdvanceLevel(); // Ligne d'arrivée d'un niveau qui n'est pas le dernier
+    // Rechargement à chaud (--hot-reload, voir AssetWatcher) : sons et tailles mises en cache
+    void ApplyReloadedAssets();
+    const Uint32 HOT_RELOAD_POLL_MS = 100; // Attente d'événements bornée pour voir les fichiers modifiés
+    int m_levelIndex = 0;   // Simulation
+    int m_renderLevel = 0;  // Rendu : niveau dont les calques utilisent les textures
+    bool m_waitingForNextLevel = false;
+
+    // Minuteurs de la scène courante (compte à rebours, difficulté, apparitions, écrans de fin) :
+    // programmés à l'entrée dans la scène et tous annulés à chaque transition.
+    Timeline m_timeline;
+    void StartPlayingTimers();
+    void OnCountdownSecond();
+    void OnDifficultyIncrease();
+    void ScheduleNextSpawn(double delay);
+
+    void RegisterLayers();
+    bool IsStaticScreen(const ScreenView& screen) const; // Tout thread
+    void FillScreen(Uint8 r, Uint8 g, Uint8 b);
+    void ComposeStaticScreen(int originX, int originY);
+    void SetHudTimerTexture(const std::string& textureId);
+    void RenderScene(const RenderSnapshot& snapshot);
+
+    // Échange simulation -> rendu. Sans thread de simulation, Update() publie et Render()
+    // consomme sur le même thread ; avec, les deux côtés ne partagent que ces objets.
+    void PublishSnapshot();                          // Simulation : fin de Update()
+    void ApplyScreenChanges(const ScreenView& screen); // Rendu : invalidations et textes du HUD
+    TripleBuffer<RenderSnapshot> m_snapshots;
+    Uint32 m_snapshotSequence = 0;
+    ScreenView m_publishedScreen; // Simulation : dernier écran publié
+    ScreenView m_appliedScreen;   // Rendu : écran des calques actuels
+    Uint32 m_handledInputs = 0;   // Simulation : entrées suivies par LatencyTracker déjà traitées
+
+    // Thread de simulation (--sim-thread)
+    void StartSimulationThread();
+    void StopSimulationThread();
+    void SimulationLoop();
+    void DispatchEvent(SDL_Event& event); // Thread principal : rendu puis simulation
+    void WakeMainThread();
+    bool m_simThreaded = false;
+    std::thread m_simThread;
+    SpscQueue<SDL_Event, 256> m_simEvents;
+    Uint32 m_wakeEventType = 0; // Événement poussé par la simulation pour réveiller Events()
+    const Uint32 SUSPENDED_SIM_DELAY_MS = 20;
+
+    // Rendu à la demande des écrans fixes et suspension (fenêtre réduite / perte du focus)
+    bool ShouldWaitForEvents() const;
+    Uint32 IdleWaitTimeout() const;
+    void Suspend(const char* reason);
+    void Resume();
+    std::atomic<bool> m_suspended{ false };
+    Uint32 m_suspendStartTime = 0; // SDL_GetTicks, pour le journal seulement
+    std::atomic<bool> m_redrawRequested{ true }; // Fenêtre exposée/redimensionnée, overlay basculé...
+    const Uint32 IDLE_WAIT_MAX_MS = 1000;
+
+    // Overlay de debug (F3) : carte de chaleur des écritures et compteurs de RenderStats
+    void RenderDebugOverlay();
+    int m_renderStatsFrame = 0;
+    SDL_Rect m_renderStatsRect = { 15, 0, 0, 0 };
+
+    // Images de référence (--golden)
+    void UpdateGoldenRun();
+    int m_goldenStep = 0;
+    int m_goldenFrames = 0;
+    std::string m_goldenCapture; // Nom de la capture à faire à la fin de la frame courante (copié dans l'instantané)
 };
 
 #endif // ENGINE_H
\ No newline at end of file
@@ -0,0 +1,189 @@
+#include "FramePacer.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+FramePacer* FramePacer::s_Instance = nullptr;
+
+namespace {
+
+const double MIN_SPIN_MARGIN_MS = 0.5;
+const double MAX_SPIN_MARGIN_MS = 4.0;
+const double MIN_LATE_MARGIN_MS = 1.0;
+const double WORK_DECAY = 0.05; // Redescente de l'estimation du travail (les hausses sont prises aussitôt)
+
+} // namespace
+
+FramePacer::FramePacer() :
+    m_frequency(1),
+    m_periodTicks(0),
+    m_nextDeadline(0),
+    m_lastFrameEnd(0),
+    m_sleepOvershootMs(1.0),
+    m_spinMarginMs(2.0),
+    m_frames(0),
+    m_lateFrames(0),
+    m_intervalSum(0.0),
+    m_intervalSquareSum(0.0),
+    m_maxInterval(0.0),
+    m_refreshTicks(0),
+    m_frameStart(0),
+    m_presentMark(0),
+    m_workEstimateMs(0.0),
+    m_lateMarginMs(2.0),
+    m_lastDelayMs(0.0),
+    m_delaySum(0.0),
+    m_lateStartFrames(0),
+    m_missedVsyncs(0)
+{}
+
+void FramePacer::Init(int targetFps) {
+    m_frequency = SDL_GetPerformanceFrequency();
+    m_periodTicks = targetFps > 0 ? m_frequency / static_cast<Uint64>(targetFps) : 0;
+    m_nextDeadline = 0;
+    m_lastFrameEnd = 0;
+    m_frames = m_lateFrames = 0;
+    m_intervalSum = m_intervalSquareSum = m_maxInterval = 0.0;
+    m_refreshTicks = 0;
+    if (IsActive()) {
+        SDL_Log("FramePacer::Init - Cadence limitee a %d images/s (%.3f ms).", targetFps, TicksToMs(m_periodTicks));
+    }
+}
+
+void FramePacer::Clean() {
+    if (IsActive() && m_frames > 0) {
+        PacerStats stats = GetStats();
+        SDL_Log("FramePacer::Clean - Cible %.3f ms: intervalle moy %.3f ms, ecart-type %.3f ms, max %.3f ms, %d/%d image(s) en retard. Reveil SDL_Delay +%.3f ms, marge active %.3f ms.",
+                stats.targetMs, stats.meanIntervalMs, stats.jitterMs, stats.maxIntervalMs, stats.lateFrames, stats.frames,
+                stats.sleepOvershootMs, stats.spinMarginMs);
+    }
+    if (IsLateStartEnabled() && m_lateStartFrames > 0) {
+        PacerStats stats = GetStats();
+        SDL_Log("FramePacer::Clean - Demarrage tardif: travail estime %.3f ms, marge %.3f ms, attente moy %.3f ms, %d/%d synchro(s) ratee(s).",
+                stats.workEstimateMs, stats.lateMarginMs, stats.meanDelayMs, stats.missedVsyncs, m_lateStartFrames);
+    }
+    m_periodTicks = 0;
+    m_refreshTicks = 0;
+}
+
+void FramePacer::EnableLateStart(int refreshRate) {
+    if (IsActive()) {
+        SDL_Log("FramePacer::EnableLateStart - Ignore: sans synchro verticale la presentation n'attend pas.");
+        return;
+    }
+    if (refreshRate <= 0) refreshRate = 60;
+    m_refreshTicks = m_frequency / static_cast<Uint64>(refreshRate);
+    m_frameStart = SDL_GetPerformanceCounter();
+    m_presentMark = 0;
+    m_lateStartFrames = m_missedVsyncs = 0;
+    m_delaySum = m_lastDelayMs = 0.0;
+    SDL_Log("FramePacer::EnableLateStart - Demarrage tardif des images a %d Hz (%.3f ms).", refreshRate, TicksToMs(m_refreshTicks));
+}
+
+void FramePacer::MarkPresent() {
+    if (IsLateStartEnabled()) m_presentMark = SDL_GetPerformanceCounter();
+}
+
+void FramePacer::Pace() {
+    if (IsLateStartEnabled()) {
+        PaceLateStart();
+        return;
+    }
+    if (!IsActive()) return;
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (m_nextDeadline == 0) {
+        m_nextDeadline = now + m_periodTicks;
+        m_lastFrameEnd = now;
+        return;
+    }
+
+    if (now >= m_nextDeadline) {
+        ++m_lateFrames;
+    } else {
+        SleepUntil(m_nextDeadline);
+    }
+
+    now = SDL_GetPerformanceCounter();
+    double intervalMs = TicksToMs(now - m_lastFrameEnd);
+    m_lastFrameEnd = now;
+    ++m_frames;
+    m_intervalSum += intervalMs;
+    m_intervalSquareSum += intervalMs * intervalMs;
+    m_maxInterval = std::max(m_maxInterval, intervalMs);
+
+    // Échéances absolues ; après un gros retard (chargement...) on repart de maintenant
+    // au lieu d'enchaîner des images sans attente pour rattraper.
+    m_nextDeadline += m_periodTicks;
+    if (now > m_nextDeadline + m_periodTicks) m_nextDeadline = now + m_periodTicks;
+}
+
+void FramePacer::PaceLateStart() {
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (m_presentMark == 0 || m_frameStart == 0 || m_presentMark < m_frameStart) {
+        m_frameStart = now; // Rien présenté (écran fixe inchangé) : pas de synchro à viser
+        return;
+    }
+    // SDL_RenderPresent rend la main à la synchro : "now" en donne la phase.
+    const double periodMs = TicksToMs(m_refreshTicks);
+    double workMs = TicksToMs(m_presentMark - m_frameStart);
+    double blockedMs = TicksToMs(now - m_presentMark);
+    m_presentMark = 0;
+    ++m_lateStartFrames;
+
+    m_workEstimateMs = workMs > m_workEstimateMs ? workMs : m_workEstimateMs + WORK_DECAY * (workMs - m_workEstimateMs);
+    if (m_lastDelayMs > 0.0 && blockedMs > periodMs * 0.5) {
+        // Soumise juste après la synchro visée : la présentation a attendu la suivante.
+        ++m_missedVsyncs;
+        m_lateMarginMs = std::min(m_lateMarginMs * 1.5 + 0.5, periodMs * 0.5);
+    } else {
+        m_lateMarginMs = std::max(m_lateMarginMs - 0.01, MIN_LATE_MARGIN_MS);
+    }
+
+    m_lastDelayMs = periodMs - m_workEstimateMs - m_lateMarginMs;
+    if (m_lastDelayMs > 0.0) {
+        m_delaySum += m_lastDelayMs;
+        SleepUntil(now + static_cast<Uint64>(m_lastDelayMs * m_frequency / 1000.0));
+    } else {
+        m_lastDelayMs = 0.0; // Image trop lourde : on démarre tout de suite
+    }
+    m_frameStart = SDL_GetPerformanceCounter();
+}
+
+void FramePacer::SleepUntil(Uint64 deadline) {
+    // 1. Sommeil pour l'essentiel du temps restant, en gardant une marge pour le retard de réveil.
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (now >= deadline) return;
+    double remainingMs = TicksToMs(deadline - now);
+    if (remainingMs > m_spinMarginMs + 1.0) {
+        Uint32 sleepMs = static_cast<Uint32>(remainingMs - m_spinMarginMs);
+        Uint64 sleepStart = SDL_GetPerformanceCounter();
+        SDL_Delay(sleepMs);
+        double overshootMs = TicksToMs(SDL_GetPerformanceCounter() - sleepStart) - sleepMs;
+        // Moyenne lissée du retard de réveil ; la marge couvre aussi ses pics.
+        m_sleepOvershootMs += 0.1 * (std::max(overshootMs, 0.0) - m_sleepOvershootMs);
+        double target = std::max(m_sleepOvershootMs * 1.5, overshootMs);
+        m_spinMarginMs = std::min(std::max(m_spinMarginMs + 0.2 * (target - m_spinMarginMs), MIN_SPIN_MARGIN_MS), MAX_SPIN_MARGIN_MS);
+    }
+    // 2. Boucle active jusqu'à l'échéance exacte.
+    while (SDL_GetPerformanceCounter() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
+PacerStats FramePacer::GetStats() const {
+    PacerStats stats;
+    stats.targetMs = TicksToMs(m_periodTicks);
+    stats.frames = m_frames;
+    stats.lateFrames = m_lateFrames;
+    stats.meanIntervalMs = m_frames > 0 ? m_intervalSum / m_frames : 0.0;
+    double variance = m_frames > 0 ? m_intervalSquareSum / m_frames - stats.meanIntervalMs * stats.meanIntervalMs : 0.0;
+    stats.jitterMs = std::sqrt(std::max(variance, 0.0));
+    stats.maxIntervalMs = m_maxInterval;
+    stats.sleepOvershootMs = m_sleepOvershootMs;
+    stats.spinMarginMs = m_spinMarginMs;
+    stats.workEstimateMs = m_workEstimateMs;
+    stats.lateMarginMs = m_lateMarginMs;
+    stats.meanDelayMs = m_lateStartFrames > 0 ? m_delaySum / m_lateStartFrames : 0.0;
+    stats.missedVsyncs = m_missedVsyncs;
+    return stats;
+}
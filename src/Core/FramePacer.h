@@ -0,0 +1,88 @@
+#ifndef FRAMEPACER_H
+#define FRAMEPACER_H
+
+#include "SDL.h"
+
+struct PacerStats
+{
+    double targetMs;        // Période visée
+    double meanIntervalMs;  // Intervalle moyen mesuré entre deux images
+    double jitterMs;        // Écart-type de l'intervalle
+    double maxIntervalMs;
+    double sleepOvershootMs; // Retard moyen de réveil de SDL_Delay (lissé)
+    double spinMarginMs;    // Part finale attendue en boucle active
+    int frames;
+    int lateFrames;         // Images rendues après leur échéance
+    // Démarrage tardif (--low-latency)
+    double workEstimateMs;  // Travail CPU prévu d'une image (événements -> soumission)
+    double lateMarginMs;    // Avance gardée sur la synchro verticale
+    double meanDelayMs;     // Attente moyenne avant le début d'une image
+    int missedVsyncs;       // Images soumises trop tard pour la synchro visée
+};
+
+// Limiteur d'images pour les cas où la synchro verticale ne cadence pas la boucle (rendu logiciel,
+// pilote qui l'ignore). Pace() est appelée après chaque image : elle dort la plus grande partie du
+// temps restant avec SDL_Delay puis attend la dernière fraction en boucle active sur le compteur
+// haute résolution. La marge de boucle active suit le retard de réveil mesuré de SDL_Delay.
+// Les échéances sont absolues (pas de dérive) et se recalent après une image très en retard.
+// Avec la synchro verticale, le démarrage tardif (--low-latency) fait l'inverse : juste après la
+// présentation, il attend pour que l'image suivante (lecture des entrées comprise) commence le
+// plus tard possible tout en étant soumise avant la prochaine synchro, d'après le temps de
+// travail mesuré. Une synchro ratée élargit la marge.
+class FramePacer
+{
+public:
+    static FramePacer* GetInstance()
+    {
+        return s_Instance = (s_Instance != nullptr) ? s_Instance : new FramePacer();
+    }
+
+    void Init(int targetFps); // 0 : pas de limite
+    void Clean();             // Logue les statistiques de cadence
+    inline bool IsActive() const { return m_periodTicks > 0; }
+
+    // Synchro verticale seulement (sans limiteur actif), refreshRate en Hz (0 : 60)
+    void EnableLateStart(int refreshRate);
+    inline bool IsLateStartEnabled() const { return m_refreshTicks > 0; }
+    void MarkPresent(); // Juste avant SDL_RenderPresent : fin du travail CPU de l'image
+
+    void Pace();
+    // Oublie l'échéance courante (après une attente d'événements) : la frame suivante repart de maintenant
+    inline void Resync() { m_nextDeadline = 0; m_frameStart = SDL_GetPerformanceCounter(); }
+    PacerStats GetStats() const;
+
+private:
+    FramePacer();
+    static FramePacer* s_Instance;
+
+    double TicksToMs(Uint64 ticks) const { return ticks * 1000.0 / m_frequency; }
+    void SleepUntil(Uint64 deadline); // Sommeil puis boucle active
+    void PaceLateStart();
+
+    Uint64 m_frequency;
+    Uint64 m_periodTicks;
+    Uint64 m_nextDeadline;
+    Uint64 m_lastFrameEnd;
+    double m_sleepOvershootMs;
+    double m_spinMarginMs;
+
+    // Statistiques d'intervalle (somme et somme des carrés pour l'écart-type)
+    int m_frames;
+    int m_lateFrames;
+    double m_intervalSum;
+    double m_intervalSquareSum;
+    double m_maxInterval;
+
+    // Démarrage tardif
+    Uint64 m_refreshTicks;
+    Uint64 m_frameStart;    // Fin de la dernière attente : début du travail de l'image
+    Uint64 m_presentMark;   // MarkPresent de l'image courante, 0 si rien n'a été présenté
+    double m_workEstimateMs;
+    double m_lateMarginMs;
+    double m_lastDelayMs;
+    double m_delaySum;
+    int m_lateStartFrames;
+    int m_missedVsyncs;
+};
+
+#endif // FRAMEPACER_H
@@ -0,0 +1,46 @@
+#include "GameClock.h"
+
+GameClock* GameClock::s_Instance = nullptr;
+
+GameClock::GameClock() :
+    m_frequency(SDL_GetPerformanceFrequency()),
+    m_lastCounter(SDL_GetPerformanceCounter()),
+    m_now(0.0),
+    m_delta(0.0),
+    m_timeScale(1.0),
+    m_fixedStep(0.0),
+    m_paused(false)
+{
+}
+
+void GameClock::Reset() {
+    m_lastCounter = SDL_GetPerformanceCounter();
+    m_now = 0.0;
+    m_delta = 0.0;
+}
+
+double GameClock::Tick() {
+    Uint64 counter = SDL_GetPerformanceCounter();
+    double elapsed = static_cast<double>(counter - m_lastCounter) / m_frequency;
+    m_lastCounter = counter;
+
+    if (m_paused) {
+        m_delta = 0.0;
+    } else if (m_fixedStep > 0.0) {
+        m_delta = m_fixedStep;
+    } else {
+        m_delta = elapsed * m_timeScale;
+    }
+    m_now += m_delta;
+    return m_delta;
+}
+
+void GameClock::SetPaused(bool paused) {
+    if (m_paused == paused) return;
+    m_paused = paused;
+    if (!paused) m_lastCounter = SDL_GetPerformanceCounter(); // Pas de saut à la reprise
+}
+
+void GameClock::SetTimeScale(double scale) {
+    m_timeScale = scale > 0.0 ? scale : 0.0;
+}
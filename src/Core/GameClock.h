@@ -0,0 +1,47 @@
+#ifndef GAMECLOCK_H
+#define GAMECLOCK_H
+
+#include "SDL.h"
+
+// Horloge de jeu unique, en secondes (double) sur le compteur haute résolution : tous les
+// minuteurs de la simulation (compte à rebours, difficulté, pénalité du joueur, délais des
+// écrans de fin) sont des instants Now() comparés à des durées en secondes.
+// Avancée une fois par mise à jour par Tick() ; pendant la pause elle ne bouge pas, ce qui
+// suspend tous les minuteurs d'un coup. Le pas fixe rend le temps déterministe (--golden).
+// Utilisée par le thread qui exécute Engine::Update (principal ou simulation).
+class GameClock
+{
+public:
+    static GameClock* GetInstance()
+    {
+        return s_Instance = (s_Instance != nullptr) ? s_Instance : new GameClock();
+    }
+
+    void Reset();   // Temps de jeu remis à 0, mesuré à partir de maintenant
+    double Tick();  // Avance l'horloge et renvoie le pas écoulé (s), 0 en pause
+
+    inline double Now() const { return m_now; }        // Temps de jeu au dernier Tick (s)
+    inline double GetDelta() const { return m_delta; } // Pas du dernier Tick (s)
+    inline double Since(double timestamp) const { return m_now - timestamp; }
+
+    void SetPaused(bool paused); // La reprise ne compte pas la durée de la pause
+    inline bool IsPaused() const { return m_paused; }
+    void SetTimeScale(double scale); // 1 = temps réel, < 1 ralenti
+    inline double GetTimeScale() const { return m_timeScale; }
+    // > 0 : chaque Tick avance exactement de ce pas, quelle que soit la durée réelle
+    inline void SetFixedStep(double seconds) { m_fixedStep = seconds > 0.0 ? seconds : 0.0; }
+
+private:
+    GameClock();
+    static GameClock* s_Instance;
+
+    Uint64 m_frequency;
+    Uint64 m_lastCounter;
+    double m_now;
+    double m_delta;
+    double m_timeScale;
+    double m_fixedStep;
+    bool m_paused;
+};
+
+#endif // GAMECLOCK_H
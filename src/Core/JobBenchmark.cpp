@@ -0,0 +1,145 @@
+#include "JobBenchmark.h"
+#include <atomic>
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SDL.h"
+#include "JobSystem.h"
+
+namespace {
+
+const int EMPTY_JOBS = 10000;
+const int CHAIN_LENGTH = 1000;
+const int FAN_OUT = 64;
+const int IMAGE_WIDTH = 1920;
+const int IMAGE_HEIGHT = 1080;
+const int LONG_JOBS = 16;         // Tâches longues de la simulation pendant les attentes du rendu
+const double LONG_JOB_MS = 4.0;
+const int RENDER_ROWS = IMAGE_HEIGHT / 8;
+
+double ElapsedNs(Uint64 start) {
+    return (SDL_GetPerformanceCounter() - start) * 1.0e9 / SDL_GetPerformanceFrequency();
+}
+
+// Traitement par ligne assez coûteux pour que le parallélisme compte : assombrissement ARGB.
+void ShadeRows(std::vector<Uint32>& pixels, int begin, int end) {
+    for (int y = begin; y < end; ++y) {
+        Uint32* row = pixels.data() + y * IMAGE_WIDTH;
+        for (int x = 0; x < IMAGE_WIDTH; ++x) {
+            Uint32 p = row[x];
+            Uint32 rb = ((p & 0x00FF00FFu) * 200 >> 8) & 0x00FF00FFu;
+            Uint32 g = ((p & 0x0000FF00u) * 200 >> 8) & 0x0000FF00u;
+            row[x] = (p & 0xFF000000u) | rb | g;
+        }
+    }
+}
+
+void Spin(double ms) {
+    Uint64 end = SDL_GetPerformanceCounter() + static_cast<Uint64>(ms * SDL_GetPerformanceFrequency() / 1000.0);
+    while (SDL_GetPerformanceCounter() < end) {}
+}
+
+void RunSuite(int workers, int rounds) {
+    JobSystem* jobs = JobSystem::GetInstance();
+    jobs->Init(workers);
+
+    std::vector<std::atomic<int>> perThread(JobSystem::MAX_WORKERS + 1);
+    for (auto& count : perThread) count = 0;
+    jobs->SetProfileHook([&perThread](const char*, int threadIndex, Uint64, Uint64) {
+        perThread[threadIndex].fetch_add(1, std::memory_order_relaxed);
+    });
+
+    double emptyNs = 0.0, chainNs = 0.0, fanNs = 0.0, serialMs = 0.0, parallelMs = 0.0, renderWorstMs = 0.0;
+    std::atomic<int> renderTookLong(0);
+    std::vector<Uint32> image(IMAGE_WIDTH * IMAGE_HEIGHT, 0xFF8040C0u);
+    const int grain = IMAGE_HEIGHT / ((jobs->GetWorkerCount() + 1) * 4) + 1; // ~4 tranches par thread
+
+    for (int round = 0; round < rounds; ++round) {
+        std::vector<JobSystem::JobHandle> handles;
+        handles.reserve(EMPTY_JOBS);
+        Uint64 start = SDL_GetPerformanceCounter();
+        for (int i = 0; i < EMPTY_JOBS; ++i) handles.push_back(jobs->Schedule("bench_empty", [] {}));
+        jobs->WaitAll(handles);
+        emptyNs += ElapsedNs(start) / EMPTY_JOBS;
+
+        start = SDL_GetPerformanceCounter();
+        JobSystem::JobHandle previous;
+        for (int i = 0; i < CHAIN_LENGTH; ++i) {
+            previous = jobs->Schedule("bench_chain", [] {}, { previous });
+        }
+        jobs->Wait(previous);
+        chainNs += ElapsedNs(start) / CHAIN_LENGTH;
+
+        start = SDL_GetPerformanceCounter();
+        JobSystem::JobHandle root = jobs->Schedule("bench_root", [] {});
+        std::vector<JobSystem::JobHandle> children;
+        for (int i = 0; i < FAN_OUT; ++i) children.push_back(jobs->Schedule("bench_child", [] {}, { root }));
+        jobs->Wait(jobs->Schedule("bench_join", [] {}, children));
+        fanNs += ElapsedNs(start);
+
+        start = SDL_GetPerformanceCounter();
+        ShadeRows(image, 0, IMAGE_HEIGHT);
+        serialMs += ElapsedNs(start) / 1.0e6;
+
+        start = SDL_GetPerformanceCounter();
+        jobs->ParallelFor("bench_shade", IMAGE_HEIGHT, grain, [&image](int begin, int end) { ShadeRows(image, begin, end); });
+        parallelMs += ElapsedNs(start) / 1.0e6;
+
+        // Rendu qui attend ses bandes alors que la simulation a ensuite mis des tâches longues en
+        // file (file 0 partagée, dépilée en LIFO) : il ne doit exécuter que ses propres bandes.
+        const std::thread::id renderThread = std::this_thread::get_id();
+        std::vector<JobSystem::JobHandle> bands;
+        for (int begin = 0; begin < RENDER_ROWS; begin += grain) {
+            int end = std::min(begin + grain, RENDER_ROWS);
+            bands.push_back(jobs->Schedule("bench_render", [&image, begin, end] { ShadeRows(image, begin, end); }));
+        }
+        std::atomic<bool> longQueued(false);
+        std::thread simulation([&] {
+            std::vector<JobSystem::JobHandle> longJobs;
+            for (int i = 0; i < LONG_JOBS; ++i) {
+                longJobs.push_back(jobs->Schedule("bench_long", [&renderTookLong, renderThread] {
+                    if (std::this_thread::get_id() == renderThread) renderTookLong.fetch_add(1, std::memory_order_relaxed);
+                    Spin(LONG_JOB_MS);
+                }));
+            }
+            longQueued.store(true, std::memory_order_release);
+            jobs->WaitAll(longJobs);
+        });
+        while (!longQueued.load(std::memory_order_acquire)) std::this_thread::yield();
+        start = SDL_GetPerformanceCounter();
+        jobs->WaitAll(bands);
+        renderWorstMs = std::max(renderWorstMs, ElapsedNs(start) / 1.0e6);
+        simulation.join();
+    }
+
+    SDL_Log("  %2d worker(s) : tache vide %7.0f ns, chaine %7.0f ns/maillon, eventail %d %8.0f ns, ParallelFor %6.3f ms (serie %6.3f ms, x%.2f)",
+            jobs->GetWorkerCount(), emptyNs / rounds, chainNs / rounds, FAN_OUT, fanNs / rounds,
+            parallelMs / rounds, serialMs / rounds, parallelMs > 0.0 ? serialMs / parallelMs : 0.0);
+
+    std::string distribution = "principal " + std::to_string(perThread[0].load());
+    for (int i = 1; i <= jobs->GetWorkerCount(); ++i) {
+        distribution += " | w" + std::to_string(i) + " " + std::to_string(perThread[i].load());
+    }
+    JobStats stats = jobs->GetStats();
+    SDL_Log("      taches par thread : %s ; volees %llu", distribution.c_str(), static_cast<unsigned long long>(stats.stolen));
+    SDL_Log("      attente du rendu avec %d taches longues (%.0f ms) en file : pire %.3f ms, %d tache(s) longue(s) prise(s) par le rendu",
+            LONG_JOBS, LONG_JOB_MS, renderWorstMs, renderTookLong.load());
+
+    jobs->SetProfileHook(nullptr);
+    jobs->Clean();
+}
+
+} // namespace
+
+int RunJobBenchmark(int rounds) {
+    if (SDL_Init(0) != 0) {
+        SDL_Log("RunJobBenchmark - ECHEC: initialisation SDL: %s", SDL_GetError());
+        return 1;
+    }
+    SDL_Log("RunJobBenchmark - %d tour(s), %d coeur(s)", rounds, SDL_GetCPUCount());
+    RunSuite(0, rounds);  // Tout sur le thread principal : coût pur de la planification
+    RunSuite(-1, rounds); // Un worker par coeur
+    SDL_Quit();
+    return 0;
+}
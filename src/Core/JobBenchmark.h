@@ -0,0 +1,11 @@
+#ifndef JOBBENCHMARK_H
+#define JOBBENCHMARK_H
+
+// Benchmark du JobSystem (--bench jobs) : coût de planification d'une tâche vide, latence
+// d'une chaîne de dépendances, éventail/jointure, gain de ParallelFor sur un traitement
+// d'image 1920x1080, et pire attente du rendu sur ses bandes pendant qu'un thread de
+// simulation a des tâches longues en file, sans worker puis avec un worker par coeur. Le
+// crochet de profilage donne la répartition des tâches par thread. Renvoie le code de sortie du programme.
+int RunJobBenchmark(int rounds);
+
+#endif // JOBBENCHMARK_H
@@ -0,0 +1,254 @@
+#include "JobSystem.h"
+#include <algorithm>
+
+JobSystem* JobSystem::s_Instance = nullptr;
+const int JobSystem::MAX_WORKERS;
+
+struct JobSystem::Job
+{
+    const char* name;
+    JobFn fn;
+    std::atomic<int> pendingDependencies; // + 1 tant que Schedule() n'a pas fini d'enregistrer
+    std::vector<std::weak_ptr<Job>> dependencies; // Non terminées à Schedule(), écrit avant publication
+    std::atomic<bool> queued;             // Dans une file (Enqueue)
+    std::atomic<bool> started;            // Prise par un thread : l'entrée restée en file est ignorée
+    std::atomic<bool> done;
+    std::mutex mutex;                     // Protège finished et dependents
+    bool finished;
+    std::vector<JobHandle> dependents;    // Tâches qui attendent celle-ci
+
+    Job(const char* jobName, JobFn jobFn) :
+        name(jobName), fn(std::move(jobFn)), pendingDependencies(1), queued(false), started(false), done(false), finished(false) {}
+};
+
+namespace {
+
+thread_local int t_queueIndex = 0; // File du thread courant : 0 pour tout thread qui n'est pas un worker
+
+} // namespace
+
+JobSystem::JobSystem() :
+    m_queuedJobs(0),
+    m_stop(false),
+    m_executed(0),
+    m_stolen(0),
+    m_helped(0)
+{
+    m_queues.emplace_back(new WorkQueue());
+}
+
+void JobSystem::Init(int workers) {
+    Clean();
+    if (workers < 0) workers = std::min(SDL_GetCPUCount() - 1, MAX_WORKERS);
+    workers = std::max(0, std::min(workers, MAX_WORKERS));
+
+    m_queues.clear();
+    for (int i = 0; i <= workers; ++i) m_queues.emplace_back(new WorkQueue());
+    m_stop = false;
+    m_executed = m_stolen = m_helped = 0;
+    for (int i = 1; i <= workers; ++i) {
+        m_workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+    }
+    SDL_Log("JobSystem::Init - %d worker(s) pour %d coeur(s).", workers, SDL_GetCPUCount());
+}
+
+void JobSystem::Clean() {
+    if (!m_workers.empty()) {
+        {
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+            m_stop = true;
+        }
+        m_wakeCondition.notify_all();
+        for (auto& worker : m_workers) worker.join();
+        m_workers.clear();
+
+        JobStats stats = GetStats();
+        SDL_Log("JobSystem::Clean - %llu tache(s) executee(s), %llu volee(s), %llu par des threads en attente.",
+                static_cast<unsigned long long>(stats.executed), static_cast<unsigned long long>(stats.stolen),
+                static_cast<unsigned long long>(stats.helped));
+    }
+    int dropped = 0;
+    for (auto& queue : m_queues) {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        for (const auto& job : queue->jobs) dropped += job->started.load(std::memory_order_relaxed) ? 0 : 1;
+        queue->jobs.clear();
+    }
+    if (dropped > 0) SDL_Log("JobSystem::Clean - Attention: %d tache(s) jamais lancee(s).", dropped);
+    m_queuedJobs = 0;
+}
+
+JobSystem::JobHandle JobSystem::Schedule(const char* name, JobFn fn, const std::vector<JobHandle>& dependencies) {
+    JobHandle job = std::make_shared<Job>(name, std::move(fn));
+    for (const auto& dependency : dependencies) {
+        if (!dependency) continue;
+        std::lock_guard<std::mutex> lock(dependency->mutex);
+        if (!dependency->finished) {
+            job->pendingDependencies.fetch_add(1, std::memory_order_relaxed);
+            job->dependencies.push_back(dependency);
+            dependency->dependents.push_back(job);
+        }
+    }
+    // Retire la garde : la tâche part maintenant, ou à la fin de sa dernière dépendance.
+    if (job->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) Enqueue(job);
+    return job;
+}
+
+bool JobSystem::IsDone(const JobHandle& job) const {
+    return !job || job->done.load(std::memory_order_acquire);
+}
+
+void JobSystem::Wait(const JobHandle& job) {
+    if (t_queueIndex != 0) {
+        while (!IsDone(job)) {
+            if (!RunOne(t_queueIndex)) std::this_thread::yield();
+        }
+        return;
+    }
+    std::vector<WaitStep> path(1, WaitStep{ job, 0 });
+    while (!IsDone(job)) {
+        if (!RunWaited(path)) std::this_thread::yield();
+    }
+}
+
+void JobSystem::WaitAll(const std::vector<JobHandle>& jobs) {
+    for (const auto& job : jobs) Wait(job);
+}
+
+void JobSystem::ParallelFor(const char* name, int count, int grain, const std::function<void(int begin, int end)>& fn) {
+    if (count <= 0) return;
+    grain = std::max(grain, 1);
+    std::vector<JobHandle> jobs;
+    for (int begin = grain; begin < count; begin += grain) {
+        int end = std::min(begin + grain, count);
+        jobs.push_back(Schedule(name, [&fn, begin, end] { fn(begin, end); }));
+    }
+    // Première tranche sur le thread appelant, pendant que les workers prennent les autres.
+    Execute(std::make_shared<Job>(name, [&fn, count, grain] { fn(0, std::min(grain, count)); }), t_queueIndex);
+    WaitAll(jobs);
+}
+
+void JobSystem::SetProfileHook(ProfileFn hook) {
+    m_profileHook = std::move(hook);
+}
+
+JobStats JobSystem::GetStats() const {
+    JobStats stats;
+    stats.workerCount = GetWorkerCount();
+    stats.executed = m_executed.load();
+    stats.stolen = m_stolen.load();
+    stats.helped = m_helped.load();
+    return stats;
+}
+
+void JobSystem::Enqueue(const JobHandle& job) {
+    int index = t_queueIndex < static_cast<int>(m_queues.size()) ? t_queueIndex : 0;
+    job->queued.store(true, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+        m_queues[index]->jobs.push_back(job);
+    }
+    m_queuedJobs.fetch_add(1, std::memory_order_release);
+    {
+        // Un worker qui vient de vérifier m_queuedJobs est forcément déjà en attente ici.
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+    }
+    m_wakeCondition.notify_one();
+}
+
+bool JobSystem::RunOne(int queueIndex) {
+    const int queueCount = static_cast<int>(m_queues.size());
+    for (;;) {
+        JobHandle job;
+        bool stolen = false;
+        {
+            WorkQueue& own = *m_queues[queueIndex];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.jobs.empty()) {
+                job = std::move(own.jobs.back()); // LIFO : la dernière tâche poussée a ses données en cache
+                own.jobs.pop_back();
+            }
+        }
+        for (int offset = 1; !job && offset < queueCount; ++offset) {
+            WorkQueue& victim = *m_queues[(queueIndex + offset) % queueCount];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.jobs.empty()) {
+                job = std::move(victim.jobs.front()); // Vol de la plus ancienne, côté opposé au propriétaire
+                victim.jobs.pop_front();
+                stolen = true;
+            }
+        }
+        if (!job) return false;
+        if (job->started.exchange(true, std::memory_order_acq_rel)) continue; // Déjà exécutée par le thread qui l'attendait
+
+        m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+        if (stolen) m_stolen.fetch_add(1, std::memory_order_relaxed);
+        Execute(job, queueIndex);
+        return true;
+    }
+}
+
+bool JobSystem::RunWaited(std::vector<WaitStep>& path) {
+    while (!path.empty()) {
+        WaitStep& step = path.back();
+        const JobHandle& job = step.job;
+        if (IsDone(job)) {
+            path.pop_back();
+            continue;
+        }
+        // Prise sans la retirer de sa file : le worker qui la dépilera l'ignorera
+        if (job->queued.load(std::memory_order_acquire) && !job->started.exchange(true, std::memory_order_acq_rel)) {
+            m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            m_helped.fetch_add(1, std::memory_order_relaxed);
+            Execute(job, 0);
+            path.pop_back();
+            return true;
+        }
+        // Dépendance suivante pas encore terminée
+        JobHandle dependency;
+        while (!dependency && !job->queued.load(std::memory_order_acquire) && step.next < job->dependencies.size()) {
+            dependency = job->dependencies[step.next++].lock();
+            if (IsDone(dependency)) dependency.reset();
+        }
+        if (dependency) {
+            path.push_back(WaitStep{ dependency, 0 });
+            continue;
+        }
+        // Rien à faire ici (en cours sur un autre thread, ou dépendances en cours) : on remonte, et
+        // arrivé à la tâche attendue, on reprend du début au prochain appel
+        if (path.size() == 1) {
+            step.next = 0;
+            return false;
+        }
+        path.pop_back();
+    }
+    return false;
+}
+
+void JobSystem::Execute(const JobHandle& job, int queueIndex) {
+    Uint64 start = m_profileHook ? SDL_GetPerformanceCounter() : 0;
+    job->fn();
+    if (m_profileHook) m_profileHook(job->name, queueIndex, start, SDL_GetPerformanceCounter());
+    m_executed.fetch_add(1, std::memory_order_relaxed);
+
+    std::vector<JobHandle> dependents;
+    {
+        std::lock_guard<std::mutex> lock(job->mutex);
+        job->finished = true;
+        dependents.swap(job->dependents);
+    }
+    job->fn = nullptr; // Libère les captures au plus tôt
+    job->done.store(true, std::memory_order_release);
+    for (const auto& dependent : dependents) {
+        if (dependent->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) Enqueue(dependent);
+    }
+}
+
+void JobSystem::WorkerLoop(int queueIndex) {
+    t_queueIndex = queueIndex;
+    for (;;) {
+        if (RunOne(queueIndex)) continue;
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_wakeCondition.wait(lock, [&] { return m_stop || m_queuedJobs.load(std::memory_order_acquire) > 0; });
+        if (m_stop) return;
+    }
+}
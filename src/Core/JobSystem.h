@@ -0,0 +1,104 @@
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "SDL.h"
+
+struct JobStats
+{
+    int workerCount;
+    Uint64 executed; // Tâches exécutées (workers + threads en attente)
+    Uint64 stolen;   // Prises dans la file d'un autre thread
+    Uint64 helped;   // Exécutées par un thread externe pendant Wait() (tâche attendue ou ses dépendances)
+};
+
+// Planificateur de tâches partagé par le moteur (décodage des assets, bandes du rendu
+// logiciel...) pour éviter que chaque sous-système lance ses propres threads.
+// Un worker par coeur, chacun avec sa file : il dépile ses tâches en LIFO (cache chaud) et,
+// à vide, vole les plus anciennes des autres files. Les threads externes (thread principal,
+// simulation) partagent la file 0 ; pendant Wait(), au lieu de bloquer, ils n'exécutent que la
+// tâche attendue ou ses dépendances encore en file, jamais la longue tâche d'un autre thread
+// (le rendu qui attend ses bandes ne prend pas un décodage de la simulation). Sans worker, une
+// tâche s'exécute donc dans le Wait() qui l'attend.
+// Une tâche ne démarre qu'une fois toutes ses dépendances terminées.
+class JobSystem
+{
+public:
+    struct Job;
+    typedef std::shared_ptr<Job> JobHandle;
+    typedef std::function<void()> JobFn;
+    // Appelé après chaque tâche, sur le thread qui l'a exécutée : nom, thread (0 = externe,
+    // 1..N = workers), début/fin en SDL_GetPerformanceCounter
+    typedef std::function<void(const char* name, int threadIndex, Uint64 start, Uint64 end)> ProfileFn;
+
+    static JobSystem* GetInstance()
+    {
+        return s_Instance = (s_Instance != nullptr) ? s_Instance : new JobSystem();
+    }
+
+    // workers < 0 : un par coeur moins le thread appelant (max MAX_WORKERS), 0 : aucun
+    void Init(int workers);
+    void Clean(); // Logue les statistiques ; les tâches jamais lancées sont abandonnées
+    inline int GetWorkerCount() const { return static_cast<int>(m_workers.size()); }
+
+    // name doit rester valide jusqu'à la fin de la tâche (littéral en pratique)
+    JobHandle Schedule(const char* name, JobFn fn, const std::vector<JobHandle>& dependencies = {});
+    bool IsDone(const JobHandle& job) const;
+    void Wait(const JobHandle& job);
+    void WaitAll(const std::vector<JobHandle>& jobs);
+
+    // Découpe [0, count) en tranches d'au plus grain éléments, appelle fn(début, fin) pour
+    // chacune (le thread appelant en prend une) et attend la fin de toutes.
+    void ParallelFor(const char* name, int count, int grain, const std::function<void(int begin, int end)>& fn);
+
+    void SetProfileHook(ProfileFn hook); // Sans tâche en cours (ex: avant un benchmark)
+    JobStats GetStats() const;
+
+    static const int MAX_WORKERS = 15;
+
+private:
+    JobSystem();
+    static JobSystem* s_Instance;
+
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<JobHandle> jobs;
+    };
+
+    // Parcours de Wait() sur un thread externe : tâche et prochaine dépendance à visiter
+    struct WaitStep
+    {
+        JobHandle job;
+        size_t next;
+    };
+
+    void Enqueue(const JobHandle& job);
+    bool RunOne(int queueIndex); // Worker : sa file, sinon vol
+    // Thread externe : exécute la tâche attendue (path[0]) ou une de ses dépendances en file.
+    // path est repris d'un appel à l'autre : une chaîne se parcourt une seule fois.
+    bool RunWaited(std::vector<WaitStep>& path);
+    void Execute(const JobHandle& job, int queueIndex);
+    void WorkerLoop(int queueIndex);
+
+    std::vector<std::thread> m_workers;
+    std::vector<std::unique_ptr<WorkQueue>> m_queues; // [0] : threads externes, [i] : worker i
+    std::atomic<int> m_queuedJobs;
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCondition;
+    bool m_stop; // Protégé par m_wakeMutex
+
+    ProfileFn m_profileHook;
+    std::atomic<Uint64> m_executed;
+    std::atomic<Uint64> m_stolen;
+    std::atomic<Uint64> m_helped;
+};
+
+#endif // JOBSYSTEM_H
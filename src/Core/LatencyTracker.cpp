@@ -0,0 +1,120 @@
+#include "LatencyTracker.h"
+#include <algorithm>
+#include <cstdio>
+
+LatencyTracker* LatencyTracker::s_Instance = nullptr;
+const int LatencyTracker::MAX_PENDING;
+
+namespace {
+
+const double BUCKET_MS = 0.25;
+const int BUCKET_COUNT = 1200; // 300 ms
+
+} // namespace
+
+LatencyTracker::LatencyTracker() :
+    m_frequency(SDL_GetPerformanceFrequency()),
+    m_pending(MAX_PENDING),
+    m_receivedSequence(0),
+    m_resolvedSequence(0),
+    m_histogram(BUCKET_COUNT + 1, 0),
+    m_samples(0),
+    m_withoutEffect(0),
+    m_totalSum(0.0),
+    m_maxMs(0.0),
+    m_queueSum(0.0),
+    m_simulationSum(0.0),
+    m_displaySum(0.0)
+{}
+
+void LatencyTracker::Clean() {
+    if (m_samples > 0) {
+        LatencyStats stats = GetStats();
+        SDL_Log("LatencyTracker::Clean - %d entree(s): moy %.2f ms, p50 %.2f ms, p95 %.2f ms, p99 %.2f ms, max %.2f ms (file %.2f + simulation %.2f + affichage %.2f ms). %d sans effet visible.",
+                stats.samples, stats.meanMs, stats.p50Ms, stats.p95Ms, stats.p99Ms, stats.maxMs,
+                stats.queueMs, stats.simulationMs, stats.displayMs, stats.withoutEffect);
+    }
+}
+
+bool LatencyTracker::IsTrackedInput(const SDL_Event& event) {
+    return (event.type == SDL_KEYDOWN && event.key.repeat == 0) || event.type == SDL_MOUSEBUTTONDOWN;
+}
+
+void LatencyTracker::OnInputReceived(const SDL_Event& event) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    // Âge de l'événement dans la file SDL (horodatage SDL_GetTicks de sa création)
+    Uint32 ageMs = SDL_GetTicks() - event.common.timestamp;
+    Uint64 age = std::min<Uint64>(static_cast<Uint64>(ageMs) * m_frequency / 1000, now);
+
+    PendingInput& input = m_pending[++m_receivedSequence % MAX_PENDING];
+    input.sequence = m_receivedSequence;
+    input.arrival = now - age;
+    input.received = now;
+}
+
+void LatencyTracker::OnFramePresented(Uint32 inputSequence, Uint64 publishCounter) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    for (; m_resolvedSequence < inputSequence; ) {
+        const PendingInput& input = m_pending[++m_resolvedSequence % MAX_PENDING];
+        if (input.sequence != m_resolvedSequence) continue; // Écrasée : plus de MAX_PENDING en attente
+
+        double totalMs = TicksToMs(now - input.arrival);
+        ++m_samples;
+        m_totalSum += totalMs;
+        m_maxMs = std::max(m_maxMs, totalMs);
+        m_queueSum += TicksToMs(input.received - input.arrival);
+        // L'instantané affiché peut avoir été publié après un premier instantané déjà porteur
+        // de l'entrée (mais jamais présenté) : sa part est comptée en simulation.
+        Uint64 published = std::max(publishCounter, input.received);
+        m_simulationSum += TicksToMs(published - input.received);
+        m_displaySum += TicksToMs(now - published);
+        ++m_histogram[std::min(static_cast<int>(totalMs / BUCKET_MS), BUCKET_COUNT)];
+    }
+}
+
+void LatencyTracker::OnFrameSkipped(Uint32 inputSequence) {
+    if (inputSequence > m_resolvedSequence) {
+        m_withoutEffect += static_cast<int>(inputSequence - m_resolvedSequence);
+        m_resolvedSequence = inputSequence;
+    }
+}
+
+void LatencyTracker::DropPending() {
+    m_withoutEffect += static_cast<int>(m_receivedSequence - m_resolvedSequence);
+    m_resolvedSequence = m_receivedSequence;
+}
+
+double LatencyTracker::Percentile(double fraction) const {
+    if (m_samples == 0) return 0.0;
+    Uint32 rank = static_cast<Uint32>(fraction * (m_samples - 1)) + 1;
+    Uint32 seen = 0;
+    for (int i = 0; i <= BUCKET_COUNT; ++i) {
+        seen += m_histogram[i];
+        if (seen >= rank) return std::min((i + 1) * BUCKET_MS, m_maxMs); // Borne haute de la case
+    }
+    return m_maxMs;
+}
+
+LatencyStats LatencyTracker::GetStats() const {
+    LatencyStats stats;
+    stats.samples = m_samples;
+    stats.withoutEffect = m_withoutEffect;
+    double count = m_samples > 0 ? static_cast<double>(m_samples) : 1.0;
+    stats.meanMs = m_totalSum / count;
+    stats.p50Ms = Percentile(0.50);
+    stats.p95Ms = Percentile(0.95);
+    stats.p99Ms = Percentile(0.99);
+    stats.maxMs = m_maxMs;
+    stats.queueMs = m_queueSum / count;
+    stats.simulationMs = m_simulationSum / count;
+    stats.displayMs = m_displaySum / count;
+    return stats;
+}
+
+std::string LatencyTracker::Describe() const {
+    if (m_samples == 0) return "latence: -";
+    LatencyStats stats = GetStats();
+    char buffer[96];
+    std::snprintf(buffer, sizeof(buffer), "latence p50 %.1f / p95 %.1f ms (%d)", stats.p50Ms, stats.p95Ms, stats.samples);
+    return buffer;
+}
@@ -0,0 +1,82 @@
+#ifndef LATENCYTRACKER_H
+#define LATENCYTRACKER_H
+
+#include <string>
+#include <vector>
+#include "SDL.h"
+
+struct LatencyStats
+{
+    int samples;          // Entrées suivies jusqu'à une image présentée
+    int withoutEffect;    // Entrées traitées sans image redessinée (écran fixe inchangé, pause)
+    double meanMs;
+    double p50Ms;
+    double p95Ms;
+    double p99Ms;
+    double maxMs;
+    // Moyennes par étape : file d'événements SDL, simulation (jusqu'à la publication de
+    // l'instantané), rendu et présentation
+    double queueMs;
+    double simulationMs;
+    double displayMs;
+};
+
+// Latence entrée -> image : chaque entrée (touche ou clic) est horodatée à sa réception par
+// Engine::DispatchEvent, suivie jusqu'à l'instantané qui l'a prise en compte puis jusqu'au
+// retour de SDL_RenderPresent de l'image qui le dessine. L'instant d'arrivée est estimé avec
+// l'horodatage SDL de l'événement (à la milliseconde). Les entrées sont numérotées dans le même
+// ordre des deux côtés (réception ici, traitement dans Engine::HandleEvent) : seul le numéro de
+// la dernière entrée traitée voyage dans l'instantané. Thread principal uniquement.
+class LatencyTracker
+{
+public:
+    static LatencyTracker* GetInstance()
+    {
+        return s_Instance = (s_Instance != nullptr) ? s_Instance : new LatencyTracker();
+    }
+
+    void Clean(); // Logue la distribution
+
+    static bool IsTrackedInput(const SDL_Event& event);
+    void OnInputReceived(const SDL_Event& event);
+    // Image présentée avec l'instantané qui a traité les entrées jusqu'à inputSequence
+    void OnFramePresented(Uint32 inputSequence, Uint64 publishCounter);
+    void OnFrameSkipped(Uint32 inputSequence); // Rien redessiné : ces entrées n'ont pas d'effet visible
+    void DropPending();                        // Jeu suspendu
+
+    LatencyStats GetStats() const;
+    std::string Describe() const; // Résumé court pour l'overlay de debug
+
+    static const int MAX_PENDING = 256;
+
+private:
+    LatencyTracker();
+    static LatencyTracker* s_Instance;
+
+    struct PendingInput
+    {
+        Uint32 sequence;
+        Uint64 arrival;  // Estimée depuis event.common.timestamp
+        Uint64 received; // Réception par DispatchEvent
+    };
+
+    double TicksToMs(Uint64 ticks) const { return ticks * 1000.0 / m_frequency; }
+    double Percentile(double fraction) const;
+
+    Uint64 m_frequency;
+    std::vector<PendingInput> m_pending; // Anneau indexé par numéro d'entrée
+    Uint32 m_receivedSequence;
+    Uint32 m_resolvedSequence;
+
+    // Histogramme de la latence totale par pas de BUCKET_MS, dernière case : au-delà
+    std::vector<Uint32> m_histogram;
+    int m_samples;
+    int m_withoutEffect;
+    double m_totalSum;
+    double m_maxMs;
+    double m_queueSum;
+    double m_simulationSum;
+    double m_displaySum;
+};
+
+#endif // LATENCYTRACKER_H
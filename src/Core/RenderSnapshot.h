@@ -0,0 +1,62 @@
+#ifndef RENDERSNAPSHOT_H
+#define RENDERSNAPSHOT_H
+
+#include <string>
+#include <vector>
+#include "SDL.h"
+#include "../Menu/MainMenu.h"
+
+enum GameState {
+    STATE_MAIN_MENU,
+    STATE_START_SCREEN,
+    STATE_PLAYING,
+    STATE_GAME_OVER,
+    STATE_ABOUT,
+    STATE_WIN
+};
+
+// Une image à dessiner : texture du TextureManager et rectangle écran
+struct SpriteView
+{
+    std::string textureId;
+    SDL_Rect rect = { 0, 0, 0, 0 };
+};
+
+// Partie de l'instantané qui décide du contenu des calques et des textes du HUD :
+// le rendu la compare à celle de l'image précédente pour savoir quoi invalider.
+struct ScreenView
+{
+    GameState state = STATE_START_SCREEN;
+    int level = 0; // Niveau de la campagne
+    bool showGameOverScreen = false;
+    bool showReturnPrompt = false;
+    int remainingSeconds = 60;
+    int displayedDistance = -1; // En mètres affichés, -1 : pas de texte
+    MenuView menu;
+
+    bool operator==(const ScreenView& other) const
+    {
+        return state == other.state && level == other.level && showGameOverScreen == other.showGameOverScreen &&
+               showReturnPrompt == other.showReturnPrompt && remainingSeconds == other.remainingSeconds &&
+               displayedDistance == other.displayedDistance && menu == other.menu;
+    }
+    bool operator!=(const ScreenView& other) const { return !(*this == other); }
+};
+
+// État du jeu figé à la fin d'une mise à jour : tout ce que Engine::Render lit.
+// Produit par la simulation, consommé par le rendu via un TripleBuffer (voir Engine).
+struct RenderSnapshot
+{
+    Uint32 sequence = 0;
+    ScreenView screen;
+    float backgroundScrollX = 0.0f;
+    bool hasPlayer = false;
+    SpriteView player;
+    std::vector<SpriteView> obstacles;
+    std::string goldenCapture; // Capture de référence demandée pour cette image (--golden)
+    // Suivi de latence (voir LatencyTracker) : dernière entrée traitée et instant de publication
+    Uint32 inputSequence = 0;
+    Uint64 publishCounter = 0;
+};
+
+#endif // RENDERSNAPSHOT_H
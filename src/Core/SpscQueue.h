@@ -0,0 +1,46 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+// File circulaire bornée sans verrou, un seul producteur et un seul consommateur.
+// Capacity doit être une puissance de deux. Push() échoue si la file est pleine : c'est à
+// l'appelant de décider s'il attend ou s'il abandonne l'élément.
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscQueue: Capacity doit etre une puissance de deux");
+
+public:
+    SpscQueue() : m_head(0), m_tail(0) {}
+
+    // Producteur
+    bool Push(const T& item)
+    {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) >= Capacity) return false;
+        m_items[tail & (Capacity - 1)] = item;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consommateur
+    bool Pop(T& item)
+    {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) return false;
+        item = m_items[head & (Capacity - 1)];
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    inline size_t Size() const { return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire); }
+
+private:
+    T m_items[Capacity];
+    alignas(64) std::atomic<size_t> m_head; // Index lu par le consommateur
+    alignas(64) std::atomic<size_t> m_tail; // Index écrit par le producteur
+};
+
+#endif // SPSCQUEUE_H
@@ -0,0 +1,72 @@
+#include "Timeline.h"
+#include <algorithm>
+#include "GameClock.h"
+
+Timeline::TimerId Timeline::After(double delay, Callback fn) {
+    return Add(GameClock::GetInstance()->Now() + std::max(delay, 0.0), 0.0, std::move(fn));
+}
+
+Timeline::TimerId Timeline::Every(double interval, Callback fn) {
+    interval = std::max(interval, MIN_INTERVAL); // Un intervalle nul bouclerait dans Update()
+    return Add(GameClock::GetInstance()->Now() + interval, interval, std::move(fn));
+}
+
+bool Timeline::Cancel(TimerId id) {
+    // L'entrée du tas reste : elle sera ignorée quand elle arrivera en tête.
+    bool cancelled = m_timers.erase(id) != 0;
+    DropCancelled();
+    return cancelled;
+}
+
+void Timeline::CancelAll() {
+    m_timers.clear();
+    m_queue.clear();
+}
+
+void Timeline::Update() {
+    const double now = GameClock::GetInstance()->Now();
+    DropCancelled();
+    while (!m_queue.empty() && m_queue.front().due <= now) {
+        std::pop_heap(m_queue.begin(), m_queue.end(), std::greater<Entry>());
+        Entry entry = m_queue.back();
+        m_queue.pop_back();
+
+        auto it = m_timers.find(entry.id);
+        if (it == m_timers.end()) continue;
+        const double interval = it->second.interval;
+        // Copie : le rappel peut s'annuler lui-même ou vider la Timeline.
+        Callback fn = it->second.fn;
+        if (interval <= 0.0) m_timers.erase(it);
+
+        fn();
+
+        // Rattrapage d'un retard : la prochaine échéance part de l'échéance prévue, pas de now.
+        if (interval > 0.0 && m_timers.count(entry.id) != 0) Push(entry.due + interval, entry.id);
+        DropCancelled();
+    }
+}
+
+double Timeline::NextDue() const {
+    return m_queue.empty() ? -1.0 : m_queue.front().due;
+}
+
+Timeline::TimerId Timeline::Add(double due, double interval, Callback fn) {
+    TimerId id = m_nextId++;
+    if (m_nextId == 0) m_nextId = 1;
+    m_timers[id] = Timer{ std::move(fn), interval };
+    Push(due, id);
+    return id;
+}
+
+void Timeline::Push(double due, TimerId id) {
+    m_queue.push_back(Entry{ due, m_nextOrder++, id });
+    std::push_heap(m_queue.begin(), m_queue.end(), std::greater<Entry>());
+}
+
+void Timeline::DropCancelled() {
+    // Garde en tête une entrée active, pour que NextDue() et Update() n'en voient pas d'autres.
+    while (!m_queue.empty() && m_timers.count(m_queue.front().id) == 0) {
+        std::pop_heap(m_queue.begin(), m_queue.end(), std::greater<Entry>());
+        m_queue.pop_back();
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include "SDL.h"
+
+// Événements programmés sur le temps de GameClock : au lieu de comparer chaque minuteur à
+// l'horloge à chaque image, on enregistre un rappel et Update() ne déclenche que ceux qui
+// sont échus. Tas-min sur l'échéance : Update() ne coûte qu'une comparaison quand rien n'est dû,
+// quel que soit le nombre de minuteurs. La pause et l'échelle de temps viennent de GameClock.
+// Un rappel peut programmer ou annuler d'autres minuteurs, y compris CancelAll().
+class Timeline
+{
+public:
+    typedef Uint32 TimerId; // 0 : aucun minuteur
+    typedef std::function<void()> Callback;
+
+    Timeline() = default;
+
+    TimerId After(double delay, Callback fn);    // Une fois, dans delay secondes de jeu
+    TimerId Every(double interval, Callback fn); // Toutes les interval secondes, sans dérive
+    bool Cancel(TimerId id);
+    void CancelAll();
+
+    void Update(); // Déclenche dans l'ordre des échéances tout ce qui est dû à GameClock::Now()
+
+    inline bool IsPending(TimerId id) const { return m_timers.count(id) != 0; }
+    inline bool IsEmpty() const { return m_timers.empty(); }
+    double NextDue() const; // Échéance la plus proche (temps GameClock), -1 si rien n'est programmé
+
+    static constexpr double MIN_INTERVAL = 0.001;
+
+private:
+    struct Timer
+    {
+        Callback fn;
+        double interval; // 0 : une seule fois
+    };
+    struct Entry
+    {
+        double due;
+        Uint32 order; // Départage les échéances égales dans l'ordre de programmation
+        TimerId id;
+        bool operator>(const Entry& other) const
+        {
+            return due != other.due ? due > other.due : order > other.order;
+        }
+    };
+
+    TimerId Add(double due, double interval, Callback fn);
+    void Push(double due, TimerId id);
+    void DropCancelled();
+
+    std::unordered_map<TimerId, Timer> m_timers; // Minuteurs actifs
+    std::vector<Entry> m_queue;                  // Tas-min ; entrées annulées retirées en tête
+    TimerId m_nextId = 1;
+    Uint32 m_nextOrder = 0;
+};
+
+#endif // TIMELINE_H
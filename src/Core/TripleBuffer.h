@@ -0,0 +1,44 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <atomic>
+
+// Échange sans verrou entre un producteur et un consommateur (threads différents) :
+// le producteur remplit WriteBuffer() puis Publish(), le consommateur appelle Consume()
+// et lit Read(). Trois exemplaires de T : celui en écriture, celui en lecture et le dernier
+// publié. Le consommateur obtient toujours la dernière valeur complète, les intermédiaires
+// non lues sont écrasées (jamais d'attente ni de file qui grossit).
+// Les exemplaires sont réutilisés : les vecteurs/chaînes de T gardent leur capacité.
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() : m_writeIndex(1), m_readIndex(0), m_middle(2) {}
+
+    // Producteur
+    inline T& WriteBuffer() { return m_slots[m_writeIndex]; }
+    void Publish()
+    {
+        m_writeIndex = m_middle.exchange(m_writeIndex | FRESH_BIT, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    // Consommateur : vrai si une nouvelle valeur est devenue lisible
+    bool Consume()
+    {
+        if ((m_middle.load(std::memory_order_relaxed) & FRESH_BIT) == 0) return false;
+        m_readIndex = m_middle.exchange(m_readIndex, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+    inline const T& Read() const { return m_slots[m_readIndex]; }
+
+private:
+    static const unsigned INDEX_MASK = 3;
+    static const unsigned FRESH_BIT = 4; // Exemplaire du milieu publié et pas encore consommé
+
+    T m_slots[3];
+    unsigned m_writeIndex;          // Producteur uniquement
+    unsigned m_readIndex;           // Consommateur uniquement
+    std::atomic<unsigned> m_middle; // Index de l'exemplaire échangé + FRESH_BIT
+};
+
+#endif // TRIPLEBUFFER_H
@@ -0,0 +1,217 @@
+#include "FrameCapture.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include "SDL_image.h"
+#include "SoftRenderer.h"
+
+FrameCapture* FrameCapture::s_Instance = nullptr;
+
+FrameCapture::FrameCapture() :
+    m_renderer(nullptr),
+    m_format(FORMAT_PNG),
+    m_width(0),
+    m_height(0),
+    m_frameIndex(0),
+    m_every(0),
+    m_first(-1),
+    m_last(-1),
+    m_stopWriter(false),
+    m_stats()
+{}
+
+bool FrameCapture::Init(SDL_Renderer* renderer, const std::string& directory, Format format, int bufferCount) {
+    Clean(); // Nouvel Init : l'écrivain précédent vide sa file et s'arrête avant d'être remplacé
+    m_renderer = renderer;
+    m_directory = directory;
+    m_format = format;
+
+    SDL_Surface* framebuffer = SoftRenderer::GetInstance()->GetFramebuffer();
+    if (SoftRenderer::GetInstance()->IsActive()) {
+        m_width = framebuffer->w;
+        m_height = framebuffer->h;
+    } else if (SDL_GetRendererOutputSize(renderer, &m_width, &m_height) != 0) {
+        SDL_Log("FrameCapture::Init - ECHEC: taille de sortie du renderer: %s", SDL_GetError());
+        m_width = m_height = 0;
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec) {
+        SDL_Log("FrameCapture::Init - ECHEC: creation du dossier '%s': %s", directory.c_str(), ec.message().c_str());
+        m_width = m_height = 0;
+        return false;
+    }
+
+    // Tous les tampons sont alloués ici : aucune allocation d'image pendant la partie.
+    bufferCount = std::max(bufferCount, 1);
+    m_slots.assign(bufferCount, Slot());
+    m_freeSlots.clear();
+    m_pendingSlots.clear();
+    for (int i = 0; i < bufferCount; ++i) {
+        m_slots[i].pixels.assign(static_cast<size_t>(m_width) * m_height, 0);
+        m_freeSlots.push_back(i);
+    }
+    m_stats = CaptureStats();
+    m_frameIndex = 0;
+    m_stopWriter = false;
+    m_writer = std::thread(&FrameCapture::WriterLoop, this);
+
+    SDL_Log("FrameCapture::Init - Capture %dx%d (%s) dans '%s', %d tampon(s).", m_width, m_height,
+            format == FORMAT_PNG ? "PNG" : "brut ARGB8888", directory.c_str(), bufferCount);
+    return true;
+}
+
+void FrameCapture::Clean() {
+    if (!IsActive()) return;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopWriter = true;
+    }
+    m_pendingReady.notify_all();
+    if (m_writer.joinable()) m_writer.join(); // Le thread vide la file avant de s'arrêter
+
+    CaptureStats stats = GetStats();
+    SDL_Log("FrameCapture::Clean - %d image(s) capturee(s), %d ecrite(s), %d perdue(s). Lecture: moy %.2f ms, max %.2f ms. Ecriture: moy %.2f ms.",
+            stats.captured, stats.written, stats.dropped,
+            stats.captured > 0 ? stats.readbackMs / stats.captured : 0.0, stats.maxReadbackMs,
+            stats.written > 0 ? stats.writeMs / stats.written : 0.0);
+
+    m_slots.clear();
+    m_freeSlots.clear();
+    m_pendingSlots.clear();
+    m_width = m_height = 0;
+    m_renderer = nullptr;
+}
+
+void FrameCapture::SetSchedule(int every, int first, int last) {
+    m_every = every;
+    m_first = first;
+    m_last = last;
+}
+
+bool FrameCapture::IsScheduled(Uint64 frame) const {
+    if (m_every <= 0 && m_first < 0) return false;
+    const Uint64 first = m_first > 0 ? static_cast<Uint64>(m_first) : 0;
+    if (frame < first) return false;
+    if (m_last >= 0 && frame > static_cast<Uint64>(m_last)) return false;
+    const Uint64 step = m_every > 0 ? static_cast<Uint64>(m_every) : 1;
+    return (frame - first) % step == 0;
+}
+
+void FrameCapture::EndFrame(const char* name) {
+    if (!IsActive()) return;
+    if (name != nullptr) {
+        Capture(name, true);
+    }
+    if (IsScheduled(m_frameIndex)) {
+        char fileName[32];
+        std::snprintf(fileName, sizeof(fileName), "frame_%06llu", static_cast<unsigned long long>(m_frameIndex));
+        Capture(fileName, false);
+    }
+    ++m_frameIndex;
+}
+
+bool FrameCapture::Capture(const std::string& fileName, bool waitForSlot) {
+    int slotIndex = -1;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_freeSlots.empty()) {
+            if (!waitForSlot) {
+                ++m_stats.dropped; // Ne jamais bloquer la boucle de jeu pour une image planifiée
+                return false;
+            }
+            m_slotFreed.wait(lock, [this] { return !m_freeSlots.empty(); });
+        }
+        slotIndex = m_freeSlots.front();
+        m_freeSlots.pop_front();
+    }
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    Slot& slot = m_slots[slotIndex];
+    slot.fileName = fileName;
+    bool ok = true;
+    SoftRenderer* soft = SoftRenderer::GetInstance();
+    if (soft->IsActive()) {
+        SDL_Surface* framebuffer = soft->GetFramebuffer();
+        for (int y = 0; y < m_height; ++y) {
+            std::memcpy(slot.pixels.data() + static_cast<size_t>(y) * m_width,
+                        static_cast<const Uint8*>(framebuffer->pixels) + static_cast<size_t>(y) * framebuffer->pitch,
+                        m_width * sizeof(Uint32));
+        }
+    } else if (SDL_RenderReadPixels(m_renderer, nullptr, SDL_PIXELFORMAT_ARGB8888, slot.pixels.data(), m_width * 4) != 0) {
+        SDL_Log("FrameCapture::Capture - Echec lecture de l'image '%s': %s", fileName.c_str(), SDL_GetError());
+        ok = false;
+    }
+    double elapsedMs = (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (ok) {
+            ++m_stats.captured;
+            m_stats.readbackMs += elapsedMs;
+            m_stats.maxReadbackMs = std::max(m_stats.maxReadbackMs, elapsedMs);
+            m_pendingSlots.push_back(slotIndex);
+        } else {
+            m_freeSlots.push_back(slotIndex);
+        }
+    }
+    if (ok) m_pendingReady.notify_one();
+    return ok;
+}
+
+void FrameCapture::WriteSlot(const Slot& slot) {
+    std::string path = m_directory + "/" + slot.fileName;
+    if (m_format == FORMAT_PNG) {
+        path += ".png";
+        SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormatFrom(const_cast<Uint32*>(slot.pixels.data()), m_width, m_height,
+                                                                  32, m_width * 4, SDL_PIXELFORMAT_ARGB8888);
+        if (surface == nullptr || IMG_SavePNG(surface, path.c_str()) != 0) {
+            SDL_Log("FrameCapture - Echec ecriture '%s': %s", path.c_str(), SDL_GetError());
+        }
+        if (surface) SDL_FreeSurface(surface);
+        return;
+    }
+
+    // Brut : pixels ARGB8888 sans en-tête, dimensions dans le nom (ex: ffmpeg -f rawvideo -pixel_format bgra)
+    char suffix[32];
+    std::snprintf(suffix, sizeof(suffix), "_%dx%d.argb", m_width, m_height);
+    path += suffix;
+    SDL_RWops* file = SDL_RWFromFile(path.c_str(), "wb");
+    if (file == nullptr || SDL_RWwrite(file, slot.pixels.data(), slot.pixels.size() * sizeof(Uint32), 1) != 1) {
+        SDL_Log("FrameCapture - Echec ecriture '%s': %s", path.c_str(), SDL_GetError());
+    }
+    if (file) SDL_RWclose(file);
+}
+
+void FrameCapture::WriterLoop() {
+    for (;;) {
+        int slotIndex;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_pendingReady.wait(lock, [this] { return m_stopWriter || !m_pendingSlots.empty(); });
+            if (m_pendingSlots.empty()) return; // Arrêt demandé et file vide
+            slotIndex = m_pendingSlots.front();
+            m_pendingSlots.pop_front();
+        }
+
+        Uint64 start = SDL_GetPerformanceCounter();
+        WriteSlot(m_slots[slotIndex]);
+        double elapsedMs = (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_stats.written;
+            m_stats.writeMs += elapsedMs;
+            m_freeSlots.push_back(slotIndex);
+        }
+        m_slotFreed.notify_one();
+    }
+}
+
+CaptureStats FrameCapture::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
@@ -0,0 +1,89 @@
+#ifndef FRAMECAPTURE_H
+#define FRAMECAPTURE_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SDL.h"
+
+struct CaptureStats
+{
+    int captured;         // Images lues dans l'anneau
+    int written;          // Images encodées et écrites sur le disque
+    int dropped;          // Images planifiées perdues faute de tampon libre (écriture en retard)
+    double readbackMs;    // Coût total côté boucle de jeu (lecture + copie dans l'anneau)
+    double maxReadbackMs;
+    double writeMs;       // Coût total côté thread d'écriture (encodage + disque)
+};
+
+// Capture d'images rendues sans bloquer la boucle de jeu : chaque image sélectionnée est lue
+// dans un anneau de tampons préalloués, puis encodée (PNG ou brut ARGB8888) et écrite par un
+// thread dédié. Si l'écriture prend du retard et qu'aucun tampon n'est libre, l'image est
+// comptée comme perdue au lieu d'attendre. Seules les captures nommées (images de référence,
+// voir Engine --golden) attendent un tampon libre.
+//
+// La lecture se fait dans le framebuffer de SoftRenderer s'il est actif, sinon via
+// SDL_RenderReadPixels avant SDL_RenderPresent (seule étape synchrone avec le GPU).
+class FrameCapture
+{
+public:
+    enum Format { FORMAT_PNG, FORMAT_RAW };
+
+    static FrameCapture* GetInstance()
+    {
+        return s_Instance = (s_Instance != nullptr) ? s_Instance : new FrameCapture();
+    }
+
+    bool Init(SDL_Renderer* renderer, const std::string& directory, Format format, int bufferCount);
+    void Clean(); // Termine les écritures en attente puis logue les statistiques
+    inline bool IsActive() const { return m_width > 0; }
+
+    // Sélection des images : une sur 'every' dans [first, last] (first < 0 : aucune, last < 0 : sans fin).
+    void SetSchedule(int every, int first, int last);
+
+    // À appeler une fois par image, image finale rendue mais pas encore présentée.
+    // name != nullptr : capture nommée (name.png), en plus de la planification.
+    void EndFrame(const char* name = nullptr);
+
+    CaptureStats GetStats() const;
+
+private:
+    FrameCapture();
+    static FrameCapture* s_Instance;
+
+    struct Slot
+    {
+        std::vector<Uint32> pixels;
+        std::string fileName; // Sans extension
+    };
+
+    bool IsScheduled(Uint64 frame) const;
+    bool Capture(const std::string& fileName, bool waitForSlot);
+    void WriteSlot(const Slot& slot);
+    void WriterLoop();
+
+    SDL_Renderer* m_renderer;
+    std::string m_directory;
+    Format m_format;
+    int m_width;
+    int m_height;
+    Uint64 m_frameIndex;
+    int m_every;
+    int m_first;
+    int m_last;
+
+    std::vector<Slot> m_slots;
+    std::deque<int> m_freeSlots;
+    std::deque<int> m_pendingSlots;
+    std::thread m_writer;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_pendingReady;
+    std::condition_variable m_slotFreed;
+    bool m_stopWriter;
+    CaptureStats m_stats;
+};
+
+#endif // FRAMECAPTURE_H
@@ -0,0 +1,228 @@
+#include "LayerCache.h"
+#include "SoftRenderer.h"
+#include "TextureManager.h"
+#include "RenderStats.h"
+
+LayerCache* LayerCache::s_Instance = nullptr;
+
+bool LayerCache::Init(SDL_Renderer* renderer) {
+    m_renderer = renderer;
+    m_soft = SoftRenderer::GetInstance()->IsActive();
+    if (m_soft) {
+        m_supported = true;
+        SDL_Log("LayerCache::Init - Cache de calques actif (surfaces du rendu logiciel).");
+        return true;
+    }
+    SDL_RendererInfo info;
+    m_supported = SDL_GetRendererInfo(renderer, &info) == 0 && (info.flags & SDL_RENDERER_TARGETTEXTURE);
+    SDL_Log("LayerCache::Init - Cache de calques %s.", m_supported ? "actif" : "desactive (pas de textures cibles)");
+    return m_supported;
+}
+
+void LayerCache::Clean() {
+    for (auto& pair : m_layers) {
+        if (pair.second.texture) SDL_DestroyTexture(pair.second.texture);
+        if (pair.second.surface) SDL_FreeSurface(pair.second.surface);
+    }
+    m_layers.clear();
+    m_renderer = nullptr;
+    m_supported = false;
+    m_soft = false;
+}
+
+bool LayerCache::Register(const std::string& id, int width, int height, ComposeFn compose, SDL_BlendMode blendMode) {
+    if (blendMode == SDL_BLENDMODE_BLEND && TextureManager::GetInstance()->IsPremultiplyingAlpha()) {
+        // Composé à partir de textures prémultipliées : le contenu du calque l'est aussi.
+        blendMode = TextureManager::PremultipliedBlendMode();
+    }
+    auto it = m_layers.find(id);
+    if (it != m_layers.end() && it->second.width == width && it->second.height == height) {
+        // Même taille : on garde la texture, seule la composition change.
+        it->second.compose = compose;
+        it->second.fullyDirty = true;
+        it->second.dirtyRects.clear();
+        it->second.blendMode = blendMode;
+        if (it->second.texture) SDL_SetTextureBlendMode(it->second.texture, blendMode);
+        return true;
+    }
+    if (it != m_layers.end()) {
+        if (it->second.texture) SDL_DestroyTexture(it->second.texture);
+        if (it->second.surface) SDL_FreeSurface(it->second.surface);
+        m_layers.erase(it);
+    }
+
+    Layer layer;
+    layer.texture = nullptr;
+    layer.surface = nullptr;
+    layer.blendMode = blendMode;
+    layer.width = width;
+    layer.height = height;
+    layer.compose = compose;
+    layer.fullyDirty = true;
+    if (m_soft) {
+        layer.surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888);
+        if (layer.surface == nullptr) {
+            SDL_Log("LayerCache::Register - Echec creation calque '%s' (%dx%d): %s. Rendu direct.", id.c_str(), width, height, SDL_GetError());
+        }
+        m_layers[id] = layer;
+        return layer.surface != nullptr;
+    }
+    if (m_supported) {
+        layer.texture = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, width, height);
+        if (layer.texture == nullptr) {
+            SDL_Log("LayerCache::Register - Echec creation calque '%s' (%dx%d): %s. Rendu direct.", id.c_str(), width, height, SDL_GetError());
+        } else {
+            SDL_SetTextureBlendMode(layer.texture, blendMode);
+        }
+    }
+    m_layers[id] = layer;
+    return layer.texture != nullptr;
+}
+
+void LayerCache::Invalidate(const std::string& id) {
+    auto it = m_layers.find(id);
+    if (it == m_layers.end()) return;
+    it->second.fullyDirty = true;
+    it->second.dirtyRects.clear();
+}
+
+void LayerCache::InvalidateRect(const std::string& id, const SDL_Rect& rect) {
+    auto it = m_layers.find(id);
+    if (it == m_layers.end() || it->second.fullyDirty) return;
+    Layer& layer = it->second;
+
+    SDL_Rect bounds = { 0, 0, layer.width, layer.height };
+    SDL_Rect clipped;
+    if (!SDL_IntersectRect(&rect, &bounds, &clipped)) return;
+
+    // Fusionner avec un rectangle sale qui chevauche, pour ne pas recomposer deux fois la même zone.
+    for (auto& dirty : layer.dirtyRects) {
+        if (SDL_HasIntersection(&dirty, &clipped)) {
+            SDL_UnionRect(&dirty, &clipped, &dirty);
+            return;
+        }
+    }
+    layer.dirtyRects.push_back(clipped);
+    if (layer.dirtyRects.size() > MAX_DIRTY_RECTS) {
+        SDL_Rect merged = layer.dirtyRects[0];
+        for (const auto& dirty : layer.dirtyRects) SDL_UnionRect(&merged, &dirty, &merged);
+        layer.dirtyRects.assign(1, merged);
+    }
+}
+
+void LayerCache::InvalidateAll() {
+    for (auto& pair : m_layers) {
+        pair.second.fullyDirty = true;
+        pair.second.dirtyRects.clear();
+    }
+}
+
+void LayerCache::ClearRegion(const Layer& layer, const SDL_Rect* rect) {
+    // SDL_RenderClear ignore le rectangle de clipping : on remplit en mode NONE pour
+    // remettre la zone à transparent sans mélange.
+    SDL_BlendMode previousMode;
+    SDL_GetRenderDrawBlendMode(m_renderer, &previousMode);
+    SDL_SetRenderDrawBlendMode(m_renderer, SDL_BLENDMODE_NONE);
+    SDL_SetRenderDrawColor(m_renderer, 0, 0, 0, 0);
+    SDL_Rect full = { 0, 0, layer.width, layer.height };
+    RenderStats::GetInstance()->RecordFill(rect ? *rect : full, false);
+    SDL_RenderFillRect(m_renderer, rect ? rect : &full);
+    SDL_SetRenderDrawBlendMode(m_renderer, previousMode);
+}
+
+void LayerCache::Refresh(Layer& layer) {
+    // Sauvegarder la cible courante (et son échelle, remise à 1 par SDL_SetRenderTarget).
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(m_renderer);
+    float scaleX = 1.0f, scaleY = 1.0f;
+    SDL_RenderGetScale(m_renderer, &scaleX, &scaleY);
+
+    SDL_SetRenderTarget(m_renderer, layer.texture);
+    m_composing = true;
+    if (layer.fullyDirty) {
+        ClearRegion(layer, nullptr);
+        layer.compose(0, 0);
+    } else {
+        for (const auto& dirty : layer.dirtyRects) {
+            SDL_RenderSetClipRect(m_renderer, &dirty);
+            RenderStats::GetInstance()->SetClipRect(&dirty);
+            ClearRegion(layer, &dirty);
+            layer.compose(0, 0);
+        }
+        SDL_RenderSetClipRect(m_renderer, nullptr);
+        RenderStats::GetInstance()->SetClipRect(nullptr);
+    }
+    m_composing = false;
+    layer.fullyDirty = false;
+    layer.dirtyRects.clear();
+
+    SDL_SetRenderTarget(m_renderer, previousTarget);
+    SDL_RenderSetScale(m_renderer, scaleX, scaleY);
+}
+
+void LayerCache::RefreshSoft(Layer& layer) {
+    SoftRenderer* soft = SoftRenderer::GetInstance();
+    SDL_Surface* previousTarget = soft->GetTarget();
+
+    soft->SetTarget(layer.surface);
+    m_composing = true;
+    if (layer.fullyDirty) {
+        RenderStats::GetInstance()->RecordFill(SDL_Rect{ 0, 0, layer.width, layer.height }, false);
+        soft->Fill(nullptr, 0, 0, 0, 0, SDL_BLENDMODE_NONE);
+        layer.compose(0, 0);
+    } else {
+        for (const auto& dirty : layer.dirtyRects) {
+            soft->SetClipRect(&dirty);
+            RenderStats::GetInstance()->SetClipRect(&dirty);
+            RenderStats::GetInstance()->RecordFill(dirty, false);
+            soft->Fill(&dirty, 0, 0, 0, 0, SDL_BLENDMODE_NONE);
+            layer.compose(0, 0);
+        }
+        soft->SetClipRect(nullptr);
+        RenderStats::GetInstance()->SetClipRect(nullptr);
+    }
+    m_composing = false;
+    layer.fullyDirty = false;
+    layer.dirtyRects.clear();
+
+    soft->SetTarget(previousTarget); // Exécute les commandes du calque
+}
+
+void LayerCache::Draw(const std::string& id, int x, int y) {
+    auto it = m_layers.find(id);
+    if (it == m_layers.end()) {
+        SDL_Log("LayerCache::Draw - Calque '%s' inconnu.", id.c_str());
+        return;
+    }
+    Layer& layer = it->second;
+
+    if (layer.surface != nullptr) {
+        if (layer.fullyDirty || !layer.dirtyRects.empty()) {
+            RefreshSoft(layer);
+        }
+        SDL_Rect dstRect = { x, y, layer.width, layer.height };
+        RenderStats::GetInstance()->RecordDraw(layer.surface, dstRect, layer.blendMode != SDL_BLENDMODE_NONE);
+        SoftRenderer::GetInstance()->Blit(layer.surface, nullptr, dstRect, layer.blendMode);
+        return;
+    }
+
+    if (layer.texture == nullptr) {
+        // Repli : rendu direct, le calque est composé à sa position finale.
+        layer.compose(x, y);
+        layer.fullyDirty = false;
+        layer.dirtyRects.clear();
+        return;
+    }
+
+    if (layer.fullyDirty || !layer.dirtyRects.empty()) {
+        Refresh(layer);
+    }
+    SDL_Rect dstRect = { x, y, layer.width, layer.height };
+    RenderStats::GetInstance()->RecordDraw(layer.texture, dstRect, layer.blendMode != SDL_BLENDMODE_NONE);
+    SDL_RenderCopy(m_renderer, layer.texture, nullptr, &dstRect);
+}
+
+bool LayerCache::IsDirty(const std::string& id) const {
+    auto it = m_layers.find(id);
+    if (it == m_layers.end()) return false;
+    return it->second.fullyDirty || !it->second.dirtyRects.empty();
+}
@@ -0,0 +1,76 @@
+#ifndef LAYERCACHE_H
+#define LAYERCACHE_H
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+#include "SDL.h"
+
+// Cache de calques : un calque est une texture cible dans laquelle on compose une fois
+// des éléments statiques ou lents (piste, fond mis à l'échelle, minuteur, écrans de menu),
+// puis qu'on recopie à chaque frame. Le calque n'est recomposé que s'il a été invalidé,
+// et seulement dans les rectangles sales quand l'invalidation est partielle.
+// Sans support des textures cibles, Draw() appelle simplement la fonction de composition
+// dans la cible courante (comportement d'origine). Avec le rendu logiciel (SoftRenderer),
+// les calques sont des surfaces ARGB8888 composées par SoftRenderer.
+class LayerCache
+{
+public:
+    // Dessine le contenu du calque avec son coin en (originX, originY) :
+    // (0, 0) dans la texture du calque, la position finale en rendu direct.
+    typedef std::function<void(int originX, int originY)> ComposeFn;
+
+    static LayerCache* GetInstance()
+    {
+        return s_Instance = (s_Instance != nullptr) ? s_Instance : new LayerCache();
+    }
+
+    bool Init(SDL_Renderer* renderer);
+    void Clean();
+
+    // Un calque opaque (SDL_BLENDMODE_NONE) doit être entièrement couvert par sa composition.
+    bool Register(const std::string& id, int width, int height, ComposeFn compose, SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND);
+    void Invalidate(const std::string& id);
+    void InvalidateRect(const std::string& id, const SDL_Rect& rect);
+    void InvalidateAll(); // Ex: SDL_RENDER_TARGETS_RESET, contenu des textures cibles perdu
+
+    // Recompose si nécessaire puis copie le calque 1:1 en (x, y).
+    void Draw(const std::string& id, int x, int y);
+    // Vrai si le calque a été invalidé depuis son dernier Draw (il changera à l'écran).
+    bool IsDirty(const std::string& id) const;
+
+    inline bool IsSupported() const { return m_supported; }
+    // Vrai pendant une recomposition dans une texture de calque (voir TextureManager::DrawCopy).
+    inline bool IsComposing() const { return m_composing; }
+
+private:
+    LayerCache() : m_renderer(nullptr), m_supported(false), m_soft(false), m_composing(false) {}
+    static LayerCache* s_Instance;
+
+    struct Layer
+    {
+        SDL_Texture* texture;
+        SDL_Surface* surface; // Rendu logiciel uniquement
+        SDL_BlendMode blendMode;
+        int width;
+        int height;
+        ComposeFn compose;
+        bool fullyDirty;
+        std::vector<SDL_Rect> dirtyRects;
+    };
+
+    void Refresh(Layer& layer);
+    void ClearRegion(const Layer& layer, const SDL_Rect* rect);
+    void RefreshSoft(Layer& layer);
+
+    SDL_Renderer* m_renderer;
+    bool m_supported;
+    bool m_soft;
+    bool m_composing;
+    std::map<std::string, Layer> m_layers;
+
+    const size_t MAX_DIRTY_RECTS = 8; // Au-delà, on fusionne tout en un seul rectangle englobant
+};
+
+#endif // LAYERCACHE_H
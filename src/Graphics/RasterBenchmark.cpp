@@ -0,0 +1,159 @@
+#include "RasterBenchmark.h"
+#include <vector>
+#include "SDL.h"
+#include "SDL_image.h"
+#include "SoftRenderer.h"
+#include "../Core/AssetPack.h"
+#include "../Core/Engine.h"
+#include "../Core/JobSystem.h"
+
+namespace {
+
+struct BenchSprite
+{
+    const char* path;
+    SDL_Surface* surface; // ARGB8888
+};
+
+struct BenchDraw
+{
+    int sprite;
+    SDL_Rect dst;
+    SDL_BlendMode mode;
+};
+
+SDL_Surface* LoadSurface(const char* path) {
+    SDL_RWops* rw = AssetPack::GetInstance()->Open(path);
+    if (rw == nullptr) return nullptr;
+    SDL_Surface* loaded = IMG_Load_RW(rw, 1);
+    if (loaded == nullptr) return nullptr;
+    SDL_Surface* converted = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_ARGB8888, 0);
+    SDL_FreeSurface(loaded);
+    return converted;
+}
+
+// Même découpage que Engine::RenderScene, avec le voile du menu par-dessus pour charger le mélange.
+std::vector<BenchDraw> BuildScene(int frame) {
+    const int backgroundHeight = static_cast<int>(SCREEN_HEIGHT * 0.6f);
+    const int trackY = static_cast<int>(SCREEN_HEIGHT * 0.6f);
+    const int trackHeight = static_cast<int>(SCREEN_HEIGHT * 0.3f);
+    const int scroll = -((frame * 12) % SCREEN_WIDTH);
+
+    std::vector<BenchDraw> draws;
+    draws.push_back({ 0, { scroll, 0, SCREEN_WIDTH, backgroundHeight }, SDL_BLENDMODE_NONE });
+    draws.push_back({ 0, { scroll + SCREEN_WIDTH, 0, SCREEN_WIDTH, backgroundHeight }, SDL_BLENDMODE_NONE });
+    draws.push_back({ 1, { 0, trackY, SCREEN_WIDTH, trackHeight }, SDL_BLENDMODE_BLEND });
+    for (int i = 0; i < 6; ++i) {
+        int x = SCREEN_WIDTH - ((frame * 9 + i * 330) % (SCREEN_WIDTH + 200));
+        draws.push_back({ 3 + (i % 4), { x, trackY + (i % 3) * 90, 150, 100 }, SDL_BLENDMODE_BLEND });
+    }
+    draws.push_back({ 2, { 100, trackY + 90, 250, 150 }, SDL_BLENDMODE_BLEND });
+    draws.push_back({ 7, { 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT }, SDL_BLENDMODE_BLEND });
+    return draws;
+}
+
+double BenchSdlSoftware(const std::vector<BenchSprite>& sprites, int frames) {
+    SDL_Surface* target = SDL_CreateRGBSurfaceWithFormat(0, SCREEN_WIDTH, SCREEN_HEIGHT, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Renderer* renderer = target ? SDL_CreateSoftwareRenderer(target) : nullptr;
+    if (renderer == nullptr) {
+        SDL_Log("RunRasterBenchmark - ECHEC: renderer logiciel SDL: %s", SDL_GetError());
+        if (target) SDL_FreeSurface(target);
+        return -1.0;
+    }
+    std::vector<SDL_Texture*> textures;
+    for (const auto& sprite : sprites) textures.push_back(SDL_CreateTextureFromSurface(renderer, sprite.surface));
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int frame = 0; frame < frames; ++frame) {
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+        SDL_RenderClear(renderer);
+        for (const auto& draw : BuildScene(frame)) {
+            SDL_SetTextureBlendMode(textures[draw.sprite], draw.mode);
+            SDL_RenderCopy(renderer, textures[draw.sprite], nullptr, &draw.dst);
+        }
+        SDL_RenderFlush(renderer); // Les commandes sont exécutées ici, pas au RenderCopy
+    }
+    double ms = (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency() / frames;
+
+    for (auto* texture : textures) SDL_DestroyTexture(texture);
+    SDL_DestroyRenderer(renderer);
+    SDL_FreeSurface(target);
+    return ms;
+}
+
+// Renvoie -1 si le noyau demandé n'est pas disponible sur ce CPU.
+double BenchSoftRenderer(const std::vector<BenchSprite>& sprites, int frames, SoftRenderer::KernelLevel level, int threads, int* threadCount) {
+    SoftRenderer* soft = SoftRenderer::GetInstance();
+    if (!soft->Init(nullptr, SCREEN_WIDTH, SCREEN_HEIGHT, threads)) return -1.0;
+    soft->SetKernelLevel(level);
+    *threadCount = soft->GetThreadCount();
+    if (soft->GetKernelLevel() != level) {
+        soft->Clean();
+        return -1.0;
+    }
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int frame = 0; frame < frames; ++frame) {
+        soft->Fill(nullptr, 0, 0, 0, 255, SDL_BLENDMODE_NONE);
+        for (const auto& draw : BuildScene(frame)) {
+            soft->Blit(sprites[draw.sprite].surface, nullptr, draw.dst, draw.mode);
+        }
+        soft->Present();
+    }
+    double ms = (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency() / frames;
+
+    soft->Clean();
+    return ms;
+}
+
+} // namespace
+
+int RunRasterBenchmark(int frames) {
+    if (SDL_Init(0) != 0 || !(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) {
+        SDL_Log("RunRasterBenchmark - ECHEC: initialisation SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    std::vector<BenchSprite> sprites = {
+        { "assets/Background1.png", nullptr }, { "assets/Track.png", nullptr },
+        { "assets/player_bike.png", nullptr }, { "assets/obstacle1.png", nullptr },
+        { "assets/obstacle2.png", nullptr }, { "assets/obstacle3.png", nullptr },
+        { "assets/obstacle4.png", nullptr }, { "assets/Menu/menu_background.png", nullptr }
+    };
+    bool loaded = true;
+    for (auto& sprite : sprites) {
+        sprite.surface = LoadSurface(sprite.path);
+        if (sprite.surface == nullptr) {
+            SDL_Log("RunRasterBenchmark - ECHEC: chargement de %s: %s", sprite.path, SDL_GetError());
+            loaded = false;
+        }
+    }
+
+    JobSystem::GetInstance()->Init(-1); // Bandes parallèles de SoftRenderer
+    if (loaded) {
+        SDL_Log("RunRasterBenchmark - %d images %dx%d, %d coeur(s)", frames, SCREEN_WIDTH, SCREEN_HEIGHT, SDL_GetCPUCount());
+        double reference = BenchSdlSoftware(sprites, frames);
+        SDL_Log("  SDL_RENDERER_SOFTWARE           : %7.2f ms/image", reference);
+
+        const char* kernelNames[] = { "scalaire", "SSE2", "AVX2" };
+        const SoftRenderer::KernelLevel levels[] = { SoftRenderer::KERNEL_SCALAR, SoftRenderer::KERNEL_SSE2, SoftRenderer::KERNEL_AVX2 };
+        const int threadCounts[] = { 1, 0 }; // 0 = une bande par worker du JobSystem + thread appelant
+        for (SoftRenderer::KernelLevel level : levels) {
+            for (int threads : threadCounts) {
+                int threadCount = 0;
+                double ms = BenchSoftRenderer(sprites, frames, level, threads, &threadCount);
+                if (ms < 0.0) continue;
+                SDL_Log("  SoftRenderer %-8s %d thread(s) : %7.2f ms/image (x%.2f)", kernelNames[level], threadCount, ms,
+                        reference > 0.0 ? reference / ms : 0.0);
+            }
+        }
+    }
+
+    for (auto& sprite : sprites) {
+        if (sprite.surface) SDL_FreeSurface(sprite.surface);
+    }
+    JobSystem::GetInstance()->Clean();
+    IMG_Quit();
+    SDL_Quit();
+    return loaded ? 0 : 1;
+}
@@ -0,0 +1,10 @@
+#ifndef RASTERBENCHMARK_H
+#define RASTERBENCHMARK_H
+
+// Benchmark hors écran (--bench raster) : compose une scène de jeu 1920x1080 (fond en deux
+// moitiés mises à l'échelle, piste, obstacles, joueur, voile plein écran en alpha) avec
+// SDL_RENDERER_SOFTWARE puis avec SoftRenderer pour chaque noyau et nombre de threads,
+// et affiche le temps moyen par image. Renvoie le code de sortie du programme.
+int RunRasterBenchmark(int frames);
+
+#endif // RASTERBENCHMARK_H
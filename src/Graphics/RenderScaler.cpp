@@ -0,0 +1,137 @@
+#include "RenderScaler.h"
+#include <cmath>
+#include <cstdio>
+
+RenderScaler* RenderScaler::s_Instance = nullptr;
+
+RenderScaler::RenderScaler() :
+    m_renderer(nullptr),
+    m_target(nullptr),
+    m_logicalWidth(0),
+    m_logicalHeight(0),
+    m_scale(1.0f),
+    m_minScale(0.5f),
+    m_targetFrameMs(16.6f),
+    m_smoothedRenderMs(0.0f),
+    m_frameStartCounter(0),
+    m_framesOverBudget(0),
+    m_framesUnderBudget(0),
+    m_cooldownFrames(0),
+    m_changeCount(0),
+    m_lastChangeReason("initial")
+{}
+
+bool RenderScaler::Init(SDL_Renderer* renderer, int logicalWidth, int logicalHeight, float targetFrameMs, float minScale) {
+    m_renderer = renderer;
+    m_logicalWidth = logicalWidth;
+    m_logicalHeight = logicalHeight;
+    m_targetFrameMs = targetFrameMs;
+    m_minScale = minScale;
+    m_scale = 1.0f;
+
+    SDL_RendererInfo info;
+    if (SDL_GetRendererInfo(renderer, &info) != 0 || !(info.flags & SDL_RENDERER_TARGETTEXTURE)) {
+        SDL_Log("RenderScaler::Init - Textures cibles non supportees, resolution dynamique desactivee.");
+        return false;
+    }
+
+    m_target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, logicalWidth, logicalHeight);
+    if (m_target == nullptr) {
+        SDL_Log("RenderScaler::Init - Echec creation de la cible interne: %s", SDL_GetError());
+        return false;
+    }
+    // L'agrandissement final vers la fenêtre est filtré, les copies internes restent telles quelles.
+    SDL_SetTextureScaleMode(m_target, SDL_ScaleModeLinear);
+    SDL_SetTextureBlendMode(m_target, SDL_BLENDMODE_NONE);
+    SDL_Log("RenderScaler::Init - Resolution dynamique active (cible %.1f ms, echelle min %.2f).", m_targetFrameMs, m_minScale);
+    return true;
+}
+
+void RenderScaler::Clean() {
+    if (m_target) {
+        SDL_DestroyTexture(m_target);
+        m_target = nullptr;
+    }
+    m_renderer = nullptr;
+}
+
+void RenderScaler::BindFrameTarget() {
+    if (!m_target) return;
+    // SDL_SetRenderTarget remet l'échelle à 1 : il faut la réappliquer à chaque sélection.
+    SDL_SetRenderTarget(m_renderer, m_target);
+    SDL_RenderSetScale(m_renderer, m_scale, m_scale);
+}
+
+void RenderScaler::BeginFrame() {
+    m_frameStartCounter = SDL_GetPerformanceCounter();
+    BindFrameTarget();
+}
+
+void RenderScaler::EndFrame() {
+    if (!m_target) return;
+
+    SDL_SetRenderTarget(m_renderer, nullptr);
+    SDL_Rect srcRect = { 0, 0, static_cast<int>(m_logicalWidth * m_scale), static_cast<int>(m_logicalHeight * m_scale) };
+    SDL_RenderCopy(m_renderer, m_target, &srcRect, nullptr);
+
+    // Temps de soumission du rendu, sans l'attente vsync de SDL_RenderPresent.
+    // Avec le renderer logiciel c'est directement le coût de remplissage.
+    Uint64 elapsed = SDL_GetPerformanceCounter() - m_frameStartCounter;
+    float renderMs = static_cast<float>(elapsed * 1000.0 / SDL_GetPerformanceFrequency());
+    Adapt(renderMs);
+}
+
+void RenderScaler::Adapt(float renderMs) {
+    m_smoothedRenderMs = (m_smoothedRenderMs == 0.0f) ? renderMs : m_smoothedRenderMs * 0.9f + renderMs * 0.1f;
+
+    if (m_cooldownFrames > 0) {
+        --m_cooldownFrames;
+        return;
+    }
+
+    if (m_smoothedRenderMs > m_targetFrameMs) {
+        m_framesUnderBudget = 0;
+        if (++m_framesOverBudget >= FRAMES_BEFORE_DOWN && m_scale > m_minScale) {
+            char reason[128];
+            std::snprintf(reason, sizeof(reason), "rendu %.2f ms > cible %.2f ms", m_smoothedRenderMs, m_targetFrameMs);
+            SetScale(std::fmax(m_minScale, m_scale - SCALE_STEP), reason);
+        }
+    } else if (m_smoothedRenderMs < m_targetFrameMs * SCALE_UP_MARGIN) {
+        m_framesOverBudget = 0;
+        if (++m_framesUnderBudget >= FRAMES_BEFORE_UP && m_scale < 1.0f) {
+            char reason[128];
+            std::snprintf(reason, sizeof(reason), "rendu %.2f ms < %.0f%% de la cible %.2f ms",
+                          m_smoothedRenderMs, SCALE_UP_MARGIN * 100.0f, m_targetFrameMs);
+            SetScale(std::fmin(1.0f, m_scale + SCALE_STEP), reason);
+        }
+    } else {
+        m_framesOverBudget = 0;
+        m_framesUnderBudget = 0;
+    }
+}
+
+void RenderScaler::SetScale(float scale, const std::string& reason) {
+    // Arrondi au pas pour éviter l'accumulation d'erreurs flottantes (0.7999...)
+    scale = std::round(scale / SCALE_STEP) * SCALE_STEP;
+    scale = std::fmax(m_minScale, std::fmin(1.0f, scale));
+    if (scale == m_scale) return;
+    SDL_Log("RenderScaler - Echelle %.2f -> %.2f (%dx%d): %s", m_scale, scale,
+            static_cast<int>(m_logicalWidth * scale), static_cast<int>(m_logicalHeight * scale), reason.c_str());
+    m_scale = scale;
+    m_lastChangeReason = reason;
+    ++m_changeCount;
+    m_framesOverBudget = 0;
+    m_framesUnderBudget = 0;
+    m_cooldownFrames = COOLDOWN_FRAMES;
+}
+
+ScalerStats RenderScaler::GetStats() const {
+    ScalerStats stats;
+    stats.scale = m_scale;
+    stats.renderWidth = static_cast<int>(m_logicalWidth * m_scale);
+    stats.renderHeight = static_cast<int>(m_logicalHeight * m_scale);
+    stats.smoothedRenderMs = m_smoothedRenderMs;
+    stats.changeCount = m_changeCount;
+    stats.lastChangeReason = m_lastChangeReason;
+    return stats;
+}
@@ -0,0 +1,72 @@
+#ifndef RENDERSCALER_H
+#define RENDERSCALER_H
+
+#include <string>
+#include "SDL.h"
+
+struct ScalerStats
+{
+    float scale;              // Echelle courante de la cible interne (1.0 = pleine résolution)
+    int renderWidth;          // Résolution interne effective
+    int renderHeight;
+    float smoothedRenderMs;   // Temps de rendu lissé (BeginFrame -> EndFrame)
+    int changeCount;
+    std::string lastChangeReason;
+};
+
+// Rendu dans une cible interne dont la résolution suit le temps de rendu mesuré.
+// Les coordonnées logiques (SCREEN_WIDTH x SCREEN_HEIGHT) sont conservées via SDL_RenderSetScale :
+// le gameplay et l'UI ne voient aucune différence. La texture est allouée une seule fois à pleine
+// taille, seule la zone [0, W*scale] x [0, H*scale] est utilisée puis étirée vers la fenêtre
+// en une seule copie dans EndFrame().
+class RenderScaler
+{
+public:
+    static RenderScaler* GetInstance()
+    {
+        return s_Instance = (s_Instance != nullptr) ? s_Instance : new RenderScaler();
+    }
+
+    bool Init(SDL_Renderer* renderer, int logicalWidth, int logicalHeight, float targetFrameMs, float minScale);
+    void Clean();
+
+    void BeginFrame();
+    void EndFrame();
+
+    // Re-sélectionne la cible de la frame (après un rendu dans une autre texture cible).
+    void BindFrameTarget();
+
+    inline bool IsActive() const { return m_target != nullptr; }
+    inline float GetScale() const { return m_scale; }
+    ScalerStats GetStats() const;
+
+private:
+    RenderScaler();
+    static RenderScaler* s_Instance;
+
+    void Adapt(float renderMs);
+    void SetScale(float scale, const std::string& reason);
+
+    SDL_Renderer* m_renderer;
+    SDL_Texture* m_target;
+    int m_logicalWidth;
+    int m_logicalHeight;
+    float m_scale;
+    float m_minScale;
+    float m_targetFrameMs;
+    float m_smoothedRenderMs;
+    Uint64 m_frameStartCounter;
+    int m_framesOverBudget;
+    int m_framesUnderBudget;
+    int m_cooldownFrames;
+    int m_changeCount;
+    std::string m_lastChangeReason;
+
+    const float SCALE_STEP = 0.1f;
+    const float SCALE_UP_MARGIN = 0.7f;  // Remonter seulement si le rendu tient sous 70% de la cible
+    const int FRAMES_BEFORE_DOWN = 10;
+    const int FRAMES_BEFORE_UP = 90;     // Remonter lentement pour éviter les oscillations
+    const int COOLDOWN_FRAMES = 30;      // Laisser la mesure se stabiliser après un changement
+};
+
+#endif // RENDERSCALER_H
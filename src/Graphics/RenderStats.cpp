@@ -0,0 +1,181 @@
+#include "RenderStats.h"
+#include <algorithm>
+#include <cstdio>
+#include "LayerCache.h"
+#include "SoftRenderer.h"
+
+RenderStats* RenderStats::s_Instance = nullptr;
+
+namespace {
+
+// 1 écriture : bleu, 2 : vert, 3 : jaune, 4 : orange, 5 et plus : rouge.
+Uint32 HeatColor(Uint8 count) {
+    static const Uint32 ramp[] = { 0x00000000u, 0x700040FFu, 0x7800C040u, 0x80E0E000u, 0x88FF8000u, 0x90FF0000u };
+    return ramp[count < 5 ? count : 5];
+}
+
+} // namespace
+
+RenderStats::RenderStats() :
+    m_renderer(nullptr),
+    m_width(0),
+    m_height(0),
+    m_recording(false),
+    m_lastSource(nullptr),
+    m_clipRect{ 0, 0, 0, 0 },
+    m_clipEnabled(false),
+    m_frame(),
+    m_lastFrame(),
+    m_heatmapEnabled(false),
+    m_heatTexture(nullptr),
+    m_heatSurface(nullptr)
+{}
+
+bool RenderStats::Init(SDL_Renderer* renderer, int width, int height) {
+    m_renderer = renderer;
+    m_width = width;
+    m_height = height;
+    m_stateTotals.clear();
+    return true;
+}
+
+void RenderStats::Clean() {
+    for (const auto& pair : m_stateTotals) {
+        if (pair.second.frames == 0) continue;
+        SDL_Log("RenderStats - %-12s %6llu images, moyenne: %s", pair.first.c_str(),
+                static_cast<unsigned long long>(pair.second.frames),
+                Describe(pair.second.totals, static_cast<int>(pair.second.frames)).c_str());
+    }
+    m_stateTotals.clear();
+    SetHeatmapEnabled(false);
+    m_renderer = nullptr;
+}
+
+std::string RenderStats::Describe(const FrameRenderStats& stats, int frames) const {
+    frames = std::max(frames, 1);
+    double pixels = static_cast<double>(stats.opaquePixels + stats.blendedPixels) / frames;
+    double screen = static_cast<double>(m_width) * m_height;
+    char text[160];
+    std::snprintf(text, sizeof(text), "%.1f copies, %.1f changements de texture, %.1f remplissages, %.2f Mpx (x%.2f ecran), %.0f%% melanges",
+                  static_cast<double>(stats.drawCalls) / frames, static_cast<double>(stats.textureSwitches) / frames,
+                  static_cast<double>(stats.fills) / frames, pixels / 1e6, screen > 0.0 ? pixels / screen : 0.0,
+                  pixels > 0.0 ? 100.0 * stats.blendedPixels / frames / pixels : 0.0);
+    return text;
+}
+
+void RenderStats::BeginFrame(const char* stateName) {
+    m_frame = FrameRenderStats();
+    m_stateName = stateName;
+    m_lastSource = nullptr;
+    m_recording = true;
+    if (m_heatmapEnabled) std::fill(m_heat.begin(), m_heat.end(), 0);
+}
+
+void RenderStats::EndFrame() {
+    m_recording = false;
+    m_lastFrame = m_frame;
+    StateTotals& state = m_stateTotals[m_stateName];
+    state.totals.drawCalls += m_frame.drawCalls;
+    state.totals.textureSwitches += m_frame.textureSwitches;
+    state.totals.fills += m_frame.fills;
+    state.totals.opaquePixels += m_frame.opaquePixels;
+    state.totals.blendedPixels += m_frame.blendedPixels;
+    ++state.frames;
+}
+
+void RenderStats::SetClipRect(const SDL_Rect* rect) {
+    m_clipEnabled = rect != nullptr;
+    if (rect) m_clipRect = *rect;
+}
+
+bool RenderStats::ClipToTarget(const SDL_Rect& rect, SDL_Rect* clipped) const {
+    // Les calques sont au plus grands comme l'écran : ses bornes servent aussi pendant la composition.
+    SDL_Rect bounds = { 0, 0, m_width, m_height };
+    if (!SDL_IntersectRect(&rect, &bounds, clipped)) return false;
+    return !m_clipEnabled || SDL_IntersectRect(clipped, &m_clipRect, clipped);
+}
+
+void RenderStats::AccumulateHeat(const SDL_Rect& rect) {
+    // Seules les écritures dans l'écran comptent (pas la composition des calques, en coordonnées locales).
+    if (!m_heatmapEnabled || LayerCache::GetInstance()->IsComposing()) return;
+    for (int y = rect.y; y < rect.y + rect.h; ++y) {
+        Uint8* row = m_heat.data() + static_cast<size_t>(y) * m_width;
+        for (int x = rect.x; x < rect.x + rect.w; ++x) {
+            if (row[x] < 255) ++row[x];
+        }
+    }
+}
+
+void RenderStats::RecordDraw(const void* source, const SDL_Rect& dstRect, bool blended) {
+    if (!m_recording) return;
+    ++m_frame.drawCalls;
+    if (source != m_lastSource) {
+        if (m_lastSource != nullptr) ++m_frame.textureSwitches;
+        m_lastSource = source;
+    }
+    SDL_Rect clipped;
+    if (!ClipToTarget(dstRect, &clipped)) return;
+    Uint64 pixels = static_cast<Uint64>(clipped.w) * clipped.h;
+    if (blended) m_frame.blendedPixels += pixels; else m_frame.opaquePixels += pixels;
+    AccumulateHeat(clipped);
+}
+
+void RenderStats::RecordFill(const SDL_Rect& rect, bool blended) {
+    if (!m_recording) return;
+    ++m_frame.fills;
+    SDL_Rect clipped;
+    if (!ClipToTarget(rect, &clipped)) return;
+    Uint64 pixels = static_cast<Uint64>(clipped.w) * clipped.h;
+    if (blended) m_frame.blendedPixels += pixels; else m_frame.opaquePixels += pixels;
+    AccumulateHeat(clipped);
+}
+
+void RenderStats::SetHeatmapEnabled(bool enabled) {
+    if (enabled == m_heatmapEnabled) return;
+    m_heatmapEnabled = enabled;
+    if (enabled) {
+        m_heat.assign(static_cast<size_t>(m_width) * m_height, 0);
+        m_heatPixels.assign(static_cast<size_t>(m_width) * m_height, 0);
+        return;
+    }
+    m_heat.clear();
+    m_heat.shrink_to_fit();
+    m_heatPixels.clear();
+    m_heatPixels.shrink_to_fit();
+    if (m_heatTexture) {
+        SDL_DestroyTexture(m_heatTexture);
+        m_heatTexture = nullptr;
+    }
+    if (m_heatSurface) {
+        SoftRenderer::GetInstance()->Flush();
+        SDL_FreeSurface(m_heatSurface);
+        m_heatSurface = nullptr;
+    }
+}
+
+void RenderStats::RenderHeatmap() {
+    if (!m_heatmapEnabled) return;
+    for (size_t i = 0; i < m_heat.size(); ++i) m_heatPixels[i] = HeatColor(m_heat[i]);
+
+    SDL_Rect full = { 0, 0, m_width, m_height };
+    SoftRenderer* soft = SoftRenderer::GetInstance();
+    if (soft->IsActive()) {
+        if (m_heatSurface == nullptr) {
+            m_heatSurface = SDL_CreateRGBSurfaceWithFormatFrom(m_heatPixels.data(), m_width, m_height, 32, m_width * 4, SDL_PIXELFORMAT_ARGB8888);
+        }
+        if (m_heatSurface) soft->Blit(m_heatSurface, nullptr, full, SDL_BLENDMODE_BLEND);
+        return;
+    }
+
+    if (m_heatTexture == nullptr) {
+        m_heatTexture = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, m_width, m_height);
+        if (m_heatTexture == nullptr) {
+            SDL_Log("RenderStats::RenderHeatmap - Echec creation texture: %s", SDL_GetError());
+            SetHeatmapEnabled(false);
+            return;
+        }
+        SDL_SetTextureBlendMode(m_heatTexture, SDL_BLENDMODE_BLEND);
+    }
+    SDL_UpdateTexture(m_heatTexture, nullptr, m_heatPixels.data(), m_width * 4);
+    SDL_RenderCopy(m_renderer, m_heatTexture, nullptr, &full);
+}
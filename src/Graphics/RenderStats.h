@@ -0,0 +1,80 @@
+#ifndef RENDERSTATS_H
+#define RENDERSTATS_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include "SDL.h"
+
+struct FrameRenderStats
+{
+    int drawCalls;         // Copies de textures / surfaces (calques compris)
+    int textureSwitches;   // Changements de texture source entre deux copies
+    int fills;             // Remplissages de rectangles (effacements)
+    Uint64 opaquePixels;   // Pixels écrits sans mélange
+    Uint64 blendedPixels;  // Pixels écrits avec mélange alpha
+};
+
+// Instrumentation du chemin de dessin (TextureManager, LayerCache) : compteurs par image et
+// cumuls par état du jeu, logués à la fermeture. Les pixels comptent aussi les compositions dans
+// les calques de LayerCache (travail réel de remplissage). En mode debug, le nombre d'écritures
+// de chaque pixel de l'écran est accumulé puis affiché en carte de chaleur par-dessus l'image.
+class RenderStats
+{
+public:
+    static RenderStats* GetInstance()
+    {
+        return s_Instance = (s_Instance != nullptr) ? s_Instance : new RenderStats();
+    }
+
+    bool Init(SDL_Renderer* renderer, int width, int height);
+    void Clean(); // Logue le résumé par état
+
+    // Seuls les appels entre BeginFrame et EndFrame sont comptés (pas les overlays de debug).
+    void BeginFrame(const char* stateName);
+    void EndFrame();
+
+    void RecordDraw(const void* source, const SDL_Rect& dstRect, bool blended);
+    void RecordFill(const SDL_Rect& rect, bool blended);
+    void SetClipRect(const SDL_Rect* rect); // Clipping de la cible courante (recomposition partielle)
+
+    void SetHeatmapEnabled(bool enabled);
+    inline bool IsHeatmapEnabled() const { return m_heatmapEnabled; }
+    void RenderHeatmap(); // Overlay de la dernière image, dans la cible courante
+
+    inline const FrameRenderStats& GetLastFrame() const { return m_lastFrame; }
+    std::string Describe(const FrameRenderStats& stats, int frames = 1) const;
+
+private:
+    RenderStats();
+    static RenderStats* s_Instance;
+
+    struct StateTotals
+    {
+        FrameRenderStats totals;
+        Uint64 frames;
+    };
+
+    bool ClipToTarget(const SDL_Rect& rect, SDL_Rect* clipped) const;
+    void AccumulateHeat(const SDL_Rect& rect);
+
+    SDL_Renderer* m_renderer;
+    int m_width;
+    int m_height;
+    bool m_recording;
+    const void* m_lastSource;
+    SDL_Rect m_clipRect;
+    bool m_clipEnabled;
+    FrameRenderStats m_frame;
+    FrameRenderStats m_lastFrame;
+    std::string m_stateName;
+    std::map<std::string, StateTotals> m_stateTotals;
+
+    bool m_heatmapEnabled;
+    std::vector<Uint8> m_heat;       // Écritures par pixel de l'image en cours (saturé à 255)
+    std::vector<Uint32> m_heatPixels; // Image ARGB de l'overlay
+    SDL_Texture* m_heatTexture;
+    SDL_Surface* m_heatSurface;      // Rendu logiciel
+};
+
+#endif // RENDERSTATS_H
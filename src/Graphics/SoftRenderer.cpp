@@ -0,0 +1,361 @@
+#include "SoftRenderer.h"
+#include <algorithm>
+#include <cstring>
+#include "../Core/JobSystem.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SOFTRENDERER_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+SoftRenderer* SoftRenderer::s_Instance = nullptr;
+
+namespace {
+
+// Division par 255 arrondie, exacte pour x <= 255*255 + 128.
+inline Uint32 Div255(Uint32 x) {
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+// Mélange SDL_BLENDMODE_BLEND en alpha non prémultiplié :
+// dstRGB = srcRGB*a + dstRGB*(1-a), dstA = a + dstA*(1-a)
+inline Uint32 BlendPixel(Uint32 dst, Uint32 src) {
+    Uint32 a = src >> 24;
+    if (a == 255) return src;
+    if (a == 0) return dst;
+    Uint32 inv = 255 - a;
+    Uint32 r = Div255(((src >> 16) & 0xFF) * a + ((dst >> 16) & 0xFF) * inv);
+    Uint32 g = Div255(((src >> 8) & 0xFF) * a + ((dst >> 8) & 0xFF) * inv);
+    Uint32 b = Div255((src & 0xFF) * a + (dst & 0xFF) * inv);
+    Uint32 outA = Div255(255 * a + (dst >> 24) * inv);
+    return (outA << 24) | (r << 16) | (g << 8) | b;
+}
+
+void BlendRowScalar(Uint32* dst, const Uint32* src, int count) {
+    for (int i = 0; i < count; ++i) {
+        dst[i] = BlendPixel(dst[i], src[i]);
+    }
+}
+
+#ifdef SOFTRENDERER_X86_KERNELS
+// 4 pixels par itération. Le canal alpha de la source est forcé à 255 avant la multiplication
+// pour que la même formule donne a + dstA*(1-a) sur ce canal.
+__attribute__((target("sse2")))
+void BlendRowSSE2(Uint32* dst, const Uint32* src, int count) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+    const __m128i opaqueAlpha = _mm_set1_epi32(255);
+    const __m128i c255 = _mm_set1_epi16(255);
+    const __m128i c128 = _mm_set1_epi16(128);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i alphas = _mm_srli_epi32(s, 24);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(alphas, opaqueAlpha)) == 0xFFFF) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), s);
+            continue;
+        }
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(alphas, zero)) == 0xFFFF) {
+            continue;
+        }
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i sa = _mm_or_si128(s, alphaMask);
+
+        __m128i aLo = _mm_unpacklo_epi8(s, zero);
+        aLo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(aLo, 0xFF), 0xFF);
+        __m128i aHi = _mm_unpackhi_epi8(s, zero);
+        aHi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(aHi, 0xFF), 0xFF);
+
+        __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(sa, zero), aLo),
+                                   _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), _mm_sub_epi16(c255, aLo)));
+        __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(sa, zero), aHi),
+                                   _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), _mm_sub_epi16(c255, aHi)));
+        lo = _mm_add_epi16(lo, c128);
+        hi = _mm_add_epi16(hi, c128);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+    }
+    for (; i < count; ++i) {
+        dst[i] = BlendPixel(dst[i], src[i]);
+    }
+}
+
+// Même noyau sur 8 pixels (les unpack/pack AVX2 travaillent par demi-registre, l'ordre est conservé).
+__attribute__((target("avx2")))
+void BlendRowAVX2(Uint32* dst, const Uint32* src, int count) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+    const __m256i opaqueAlpha = _mm256_set1_epi32(255);
+    const __m256i c255 = _mm256_set1_epi16(255);
+    const __m256i c128 = _mm256_set1_epi16(128);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        __m256i alphas = _mm256_srli_epi32(s, 24);
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(alphas, opaqueAlpha)) == -1) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), s);
+            continue;
+        }
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(alphas, zero)) == -1) {
+            continue;
+        }
+        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        __m256i sa = _mm256_or_si256(s, alphaMask);
+
+        __m256i aLo = _mm256_unpacklo_epi8(s, zero);
+        aLo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(aLo, 0xFF), 0xFF);
+        __m256i aHi = _mm256_unpackhi_epi8(s, zero);
+        aHi = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(aHi, 0xFF), 0xFF);
+
+        __m256i lo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(sa, zero), aLo),
+                                      _mm256_mullo_epi16(_mm256_unpacklo_epi8(d, zero), _mm256_sub_epi16(c255, aLo)));
+        __m256i hi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(sa, zero), aHi),
+                                      _mm256_mullo_epi16(_mm256_unpackhi_epi8(d, zero), _mm256_sub_epi16(c255, aHi)));
+        lo = _mm256_add_epi16(lo, c128);
+        hi = _mm256_add_epi16(hi, c128);
+        lo = _mm256_srli_epi16(_mm256_add_epi16(lo, _mm256_srli_epi16(lo, 8)), 8);
+        hi = _mm256_srli_epi16(_mm256_add_epi16(hi, _mm256_srli_epi16(hi, 8)), 8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_packus_epi16(lo, hi));
+    }
+    if (i < count) {
+        BlendRowSSE2(dst + i, src + i, count - i);
+    }
+}
+#endif
+
+// Échantillonnage plus proche voisin d'une ligne source, position en virgule fixe 16.16.
+void SampleRow(Uint32* out, const Uint32* srcRow, Uint64 fx, Uint64 stepX, int count) {
+    for (int i = 0; i < count; ++i) {
+        out[i] = srcRow[fx >> 16];
+        fx += stepX;
+    }
+}
+
+// Même échantillonnage, de droite à gauche (miroir horizontal)
+void SampleRowMirrored(Uint32* out, const Uint32* srcRow, Uint64 fx, Uint64 stepX, int count) {
+    for (int i = 0; i < count; ++i) {
+        out[i] = srcRow[fx >> 16];
+        fx -= stepX;
+    }
+}
+
+} // namespace
+
+SoftRenderer::SoftRenderer() :
+    m_renderer(nullptr),
+    m_presentTexture(nullptr),
+    m_framebuffer(nullptr),
+    m_target(nullptr),
+    m_clipRect({0, 0, 0, 0}),
+    m_clipEnabled(false),
+    m_kernelLevel(KERNEL_SCALAR),
+    m_maxKernelLevel(KERNEL_SCALAR),
+    m_blendRow(BlendRowScalar),
+    m_threadCount(1)
+{}
+
+bool SoftRenderer::Init(SDL_Renderer* renderer, int width, int height, int threads) {
+    m_renderer = renderer;
+    m_framebuffer = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (m_framebuffer == nullptr) {
+        SDL_Log("SoftRenderer::Init - Echec creation du framebuffer: %s", SDL_GetError());
+        return false;
+    }
+    SDL_FillRect(m_framebuffer, nullptr, 0xFF000000u);
+
+    if (renderer != nullptr) {
+        m_presentTexture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, width, height);
+        if (m_presentTexture == nullptr) {
+            SDL_Log("SoftRenderer::Init - Echec creation de la texture de presentation: %s", SDL_GetError());
+            SDL_FreeSurface(m_framebuffer);
+            m_framebuffer = nullptr;
+            return false;
+        }
+        SDL_SetTextureBlendMode(m_presentTexture, SDL_BLENDMODE_NONE);
+    }
+
+#ifdef SOFTRENDERER_X86_KERNELS
+    if (SDL_HasAVX2()) m_maxKernelLevel = KERNEL_AVX2;
+    else if (SDL_HasSSE2()) m_maxKernelLevel = KERNEL_SSE2;
+#endif
+    SetKernelLevel(m_maxKernelLevel);
+
+    m_threadCount = threads > 0 ? threads : std::min(JobSystem::GetInstance()->GetWorkerCount() + 1, 8);
+    if (m_threadCount < 1) m_threadCount = 1;
+    m_rowScratch.assign(m_threadCount, std::vector<Uint32>(width));
+
+    SDL_Log("SoftRenderer::Init - Rendu logiciel %dx%d, noyau %s, %d thread(s).", width, height, GetKernelName(), m_threadCount);
+    return true;
+}
+
+void SoftRenderer::Clean() {
+    m_commands.clear();
+    m_rowScratch.clear();
+    if (m_presentTexture) {
+        SDL_DestroyTexture(m_presentTexture);
+        m_presentTexture = nullptr;
+    }
+    if (m_framebuffer) {
+        SDL_FreeSurface(m_framebuffer);
+        m_framebuffer = nullptr;
+    }
+    m_target = nullptr;
+    m_renderer = nullptr;
+}
+
+void SoftRenderer::SetKernelLevel(KernelLevel level) {
+    m_kernelLevel = std::min(level, m_maxKernelLevel);
+    switch (m_kernelLevel) {
+#ifdef SOFTRENDERER_X86_KERNELS
+        case KERNEL_AVX2: m_blendRow = BlendRowAVX2; break;
+        case KERNEL_SSE2: m_blendRow = BlendRowSSE2; break;
+#endif
+        default: m_blendRow = BlendRowScalar; m_kernelLevel = KERNEL_SCALAR; break;
+    }
+}
+
+const char* SoftRenderer::GetKernelName() const {
+    switch (m_kernelLevel) {
+        case KERNEL_AVX2: return "AVX2";
+        case KERNEL_SSE2: return "SSE2";
+        default: return "scalaire";
+    }
+}
+
+void SoftRenderer::SetTarget(SDL_Surface* target) {
+    if (target == m_target) return;
+    Flush();
+    m_target = target;
+    m_clipEnabled = false;
+}
+
+void SoftRenderer::SetClipRect(const SDL_Rect* rect) {
+    // Le clipping est figé dans chaque commande à l'enregistrement : pas besoin de vider la file.
+    m_clipEnabled = rect != nullptr;
+    if (rect) m_clipRect = *rect;
+}
+
+void SoftRenderer::Fill(const SDL_Rect* rect, Uint8 r, Uint8 g, Uint8 b, Uint8 a, SDL_BlendMode mode) {
+    SDL_Surface* target = m_target ? m_target : m_framebuffer;
+    if (!target) return;
+
+    Command cmd;
+    cmd.source = nullptr;
+    cmd.srcRect = { 0, 0, 0, 0 };
+    cmd.dstRect = rect ? *rect : SDL_Rect{ 0, 0, target->w, target->h };
+    SDL_Rect bounds = { 0, 0, target->w, target->h };
+    if (!SDL_IntersectRect(&cmd.dstRect, &bounds, &cmd.clipped)) return;
+    if (m_clipEnabled && !SDL_IntersectRect(&cmd.clipped, &m_clipRect, &cmd.clipped)) return;
+    cmd.color = (static_cast<Uint32>(a) << 24) | (static_cast<Uint32>(r) << 16) | (static_cast<Uint32>(g) << 8) | b;
+    cmd.mode = (mode == SDL_BLENDMODE_BLEND && a == 255) ? SDL_BLENDMODE_NONE : mode;
+    cmd.flip = SDL_FLIP_NONE;
+    m_commands.push_back(cmd);
+}
+
+void SoftRenderer::Blit(SDL_Surface* source, const SDL_Rect* srcRect, const SDL_Rect& dstRect, SDL_BlendMode mode, SDL_RendererFlip flip) {
+    SDL_Surface* target = m_target ? m_target : m_framebuffer;
+    if (!target || !source || dstRect.w <= 0 || dstRect.h <= 0) return;
+
+    Command cmd;
+    cmd.source = source;
+    cmd.srcRect = srcRect ? *srcRect : SDL_Rect{ 0, 0, source->w, source->h };
+    if (cmd.srcRect.w <= 0 || cmd.srcRect.h <= 0) return;
+    cmd.dstRect = dstRect;
+    SDL_Rect bounds = { 0, 0, target->w, target->h };
+    if (!SDL_IntersectRect(&cmd.dstRect, &bounds, &cmd.clipped)) return;
+    if (m_clipEnabled && !SDL_IntersectRect(&cmd.clipped, &m_clipRect, &cmd.clipped)) return;
+    cmd.color = 0;
+    cmd.mode = mode;
+    cmd.flip = flip;
+    m_commands.push_back(cmd);
+}
+
+void SoftRenderer::ExecuteBand(int bandTop, int bandBottom, int bandIndex) {
+    SDL_Surface* target = m_target ? m_target : m_framebuffer;
+    Uint32* pixels = static_cast<Uint32*>(target->pixels);
+    const int stride = target->pitch / 4;
+    std::vector<Uint32>& scratch = m_rowScratch[bandIndex];
+
+    for (const Command& cmd : m_commands) {
+        const int y0 = std::max(cmd.clipped.y, bandTop);
+        const int y1 = std::min(cmd.clipped.y + cmd.clipped.h, bandBottom);
+        if (y0 >= y1) continue;
+        const int x0 = cmd.clipped.x;
+        const int width = cmd.clipped.w;
+        if (static_cast<int>(scratch.size()) < width) scratch.resize(width);
+
+        if (cmd.source == nullptr) {
+            if (cmd.mode == SDL_BLENDMODE_NONE) {
+                for (int y = y0; y < y1; ++y) std::fill_n(pixels + y * stride + x0, width, cmd.color);
+            } else {
+                std::fill_n(scratch.data(), width, cmd.color);
+                for (int y = y0; y < y1; ++y) m_blendRow(pixels + y * stride + x0, scratch.data(), width);
+            }
+            continue;
+        }
+
+        const Uint32* srcPixels = static_cast<const Uint32*>(cmd.source->pixels);
+        const int srcStride = cmd.source->pitch / 4;
+        const SDL_Rect& src = cmd.srcRect;
+        const SDL_Rect& dst = cmd.dstRect;
+        const bool mirrorX = (cmd.flip & SDL_FLIP_HORIZONTAL) != 0;
+        const bool mirrorY = (cmd.flip & SDL_FLIP_VERTICAL) != 0;
+        const bool scaledX = src.w != dst.w;
+        const Uint64 stepX = (static_cast<Uint64>(src.w) << 16) / dst.w;
+        // Échantillon au centre du pixel destination ; en miroir, colonne symétrique dans dst
+        const int column = mirrorX ? dst.w - 1 - (x0 - dst.x) : x0 - dst.x;
+        const Uint64 fx0 = static_cast<Uint64>(column) * stepX + (stepX >> 1);
+
+        for (int y = y0; y < y1; ++y) {
+            const int row = mirrorY ? dst.h - 1 - (y - dst.y) : y - dst.y;
+            int srcY = src.y + static_cast<int>((static_cast<Sint64>(2 * row + 1) * src.h) / (2 * dst.h));
+            const Uint32* srcRow = srcPixels + srcY * srcStride + src.x;
+            const Uint32* rowData = srcRow + (x0 - dst.x);
+            if (mirrorX) {
+                SampleRowMirrored(scratch.data(), srcRow, fx0, stepX, width);
+                rowData = scratch.data();
+            } else if (scaledX) {
+                SampleRow(scratch.data(), srcRow, fx0, stepX, width);
+                rowData = scratch.data();
+            }
+            Uint32* dstRow = pixels + y * stride + x0;
+            if (cmd.mode == SDL_BLENDMODE_NONE) {
+                std::memcpy(dstRow, rowData, width * sizeof(Uint32));
+            } else {
+                m_blendRow(dstRow, rowData, width);
+            }
+        }
+    }
+}
+
+void SoftRenderer::Flush() {
+    if (m_commands.empty()) return;
+    SDL_Surface* target = m_target ? m_target : m_framebuffer;
+
+    // Petites cibles (calques du HUD...) : le coût de synchronisation dépasse le gain.
+    if (m_threadCount == 1 || target->h < 64 * m_threadCount) {
+        ExecuteBand(0, target->h, 0);
+    } else {
+        // Une tâche par bande ; chaque bande a sa ligne de travail dans m_rowScratch.
+        const int bandHeight = (target->h + m_threadCount - 1) / m_threadCount;
+        JobSystem::GetInstance()->ParallelFor("soft_raster_band", m_threadCount, 1, [&](int begin, int end) {
+            for (int band = begin; band < end; ++band) {
+                const int bandTop = band * bandHeight;
+                if (bandTop < target->h) ExecuteBand(bandTop, std::min(bandTop + bandHeight, target->h), band);
+            }
+        });
+    }
+    m_commands.clear();
+}
+
+void SoftRenderer::Present() {
+    SetTarget(nullptr);
+    Flush();
+    if (m_renderer == nullptr || m_presentTexture == nullptr) return;
+    SDL_UpdateTexture(m_presentTexture, nullptr, m_framebuffer->pixels, m_framebuffer->pitch);
+    SDL_RenderCopy(m_renderer, m_presentTexture, nullptr, nullptr);
+}
@@ -0,0 +1,87 @@
+#ifndef SOFTRENDERER_H
+#define SOFTRENDERER_H
+
+#include <vector>
+#include "SDL.h"
+
+// Backend de rendu logiciel pour les machines sans GPU (--soft-raster).
+// Il possède un framebuffer ARGB8888 à la résolution logique et remplace le chemin
+// générique de SDL_RENDERER_SOFTWARE pour les opérations du jeu : copie opaque, blit mis à
+// l'échelle (plus proche voisin) et mélange alpha, avec des noyaux scalaire/SSE2/AVX2
+// choisis à l'exécution. Les commandes d'une cible sont enregistrées puis exécutées en
+// bandes horizontales, réparties sur les workers du JobSystem. L'image est présentée via
+// une seule texture streaming.
+//
+// Toutes les surfaces manipulées sont en SDL_PIXELFORMAT_ARGB8888 (voir TextureManager).
+class SoftRenderer
+{
+public:
+    enum KernelLevel { KERNEL_SCALAR, KERNEL_SSE2, KERNEL_AVX2 };
+
+    static SoftRenderer* GetInstance()
+    {
+        return s_Instance = (s_Instance != nullptr) ? s_Instance : new SoftRenderer();
+    }
+
+    // renderer peut être nullptr (benchmark hors écran) : Present() ne fait alors que Flush().
+    // threads : nombre de bandes exécutées en parallèle, 0 = workers du JobSystem + thread appelant (max 8).
+    bool Init(SDL_Renderer* renderer, int width, int height, int threads);
+    void Clean();
+    inline bool IsActive() const { return m_framebuffer != nullptr; }
+
+    // nullptr = framebuffer. Exécute les commandes en attente de la cible précédente.
+    void SetTarget(SDL_Surface* target);
+    inline SDL_Surface* GetTarget() const { return m_target; }
+    void SetClipRect(const SDL_Rect* rect);
+
+    void Fill(const SDL_Rect* rect, Uint8 r, Uint8 g, Uint8 b, Uint8 a, SDL_BlendMode mode);
+    // flip : miroir de la source dans dstRect, comme SDL_RenderCopyEx
+    void Blit(SDL_Surface* source, const SDL_Rect* srcRect, const SDL_Rect& dstRect, SDL_BlendMode mode,
+              SDL_RendererFlip flip = SDL_FLIP_NONE);
+
+    void Flush();
+    void Present(); // Flush + envoi du framebuffer dans la texture streaming + copie vers la fenêtre
+
+    void SetKernelLevel(KernelLevel level); // Forcer un niveau (benchmark), borné par le CPU
+    inline KernelLevel GetKernelLevel() const { return m_kernelLevel; }
+    const char* GetKernelName() const;
+    inline int GetThreadCount() const { return m_threadCount; }
+    inline SDL_Surface* GetFramebuffer() const { return m_framebuffer; }
+
+private:
+    SoftRenderer();
+    static SoftRenderer* s_Instance;
+
+    struct Command
+    {
+        SDL_Surface* source; // nullptr pour un remplissage
+        SDL_Rect srcRect;
+        SDL_Rect dstRect;    // Destination complète (sert au calcul de l'échelle)
+        SDL_Rect clipped;    // Destination après clipping (cible + rectangle de clip)
+        Uint32 color;
+        SDL_BlendMode mode;
+        SDL_RendererFlip flip;
+    };
+
+    typedef void (*BlendRowFn)(Uint32* dst, const Uint32* src, int count);
+
+    void ExecuteBand(int bandTop, int bandBottom, int bandIndex);
+
+    SDL_Renderer* m_renderer;
+    SDL_Texture* m_presentTexture;
+    SDL_Surface* m_framebuffer;
+    SDL_Surface* m_target;
+    SDL_Rect m_clipRect;
+    bool m_clipEnabled;
+    std::vector<Command> m_commands;
+
+    KernelLevel m_kernelLevel;
+    KernelLevel m_maxKernelLevel;
+    BlendRowFn m_blendRow;
+
+    // Bandes parallèles (JobSystem::ParallelFor) : le thread appelant traite la bande 0.
+    int m_threadCount;
+    std::vector<std::vector<Uint32>> m_rowScratch; // Une ligne source échantillonnée par bande
+};
+
+#endif // SOFTRENDERER_H
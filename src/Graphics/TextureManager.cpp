@@ -1,68 +1,426 @@
 #include "TextureManager.h"
 #include "../Core/Engine.h"
+#include "../Core/AssetPack.h"
+#include "../Core/JobSystem.h"
+#include "SoftRenderer.h"
+#include "RenderStats.h"
 #include <SDL_image.h>
 
 TextureManager* TextureManager::s_Instance = nullptr;
 
+namespace {
+
+// Parcourt le canal alpha d'une surface ARGB8888. Renvoie vrai si elle est entièrement opaque ;
+// bounds reçoit le rectangle englobant des pixels non transparents (w = 0 si aucun).
+bool AnalyzeAlpha(SDL_Surface* surface, SDL_Rect* bounds) {
+    const Uint32* pixels = static_cast<const Uint32*>(surface->pixels);
+    const int stride = surface->pitch / 4;
+    bool opaque = true;
+    int minX = surface->w, minY = surface->h, maxX = -1, maxY = -1;
+    for (int y = 0; y < surface->h; ++y) {
+        const Uint32* row = pixels + y * stride;
+        int first = -1, last = -1;
+        for (int x = 0; x < surface->w; ++x) {
+            Uint32 alpha = row[x] >> 24;
+            if (alpha != 255) opaque = false;
+            if (alpha != 0) {
+                if (first < 0) first = x;
+                last = x;
+            }
+        }
+        if (first >= 0) {
+            if (first < minX) minX = first;
+            if (last > maxX) maxX = last;
+            if (minY > y) minY = y;
+            maxY = y;
+        }
+    }
+    *bounds = (maxX < 0) ? SDL_Rect{ 0, 0, 0, 0 } : SDL_Rect{ minX, minY, maxX - minX + 1, maxY - minY + 1 };
+    return opaque;
+}
+
+void PremultiplySurface(SDL_Surface* surface) {
+    Uint32* pixels = static_cast<Uint32*>(surface->pixels);
+    const int stride = surface->pitch / 4;
+    for (int y = 0; y < surface->h; ++y) {
+        Uint32* row = pixels + y * stride;
+        for (int x = 0; x < surface->w; ++x) {
+            Uint32 a = row[x] >> 24;
+            if (a == 255) continue;
+            Uint32 r = (((row[x] >> 16) & 0xFF) * a + 127) / 255;
+            Uint32 g = (((row[x] >> 8) & 0xFF) * a + 127) / 255;
+            Uint32 b = ((row[x] & 0xFF) * a + 127) / 255;
+            row[x] = (a << 24) | (r << 16) | (g << 8) | b;
+        }
+    }
+}
+
+} // namespace
+
+SDL_BlendMode TextureManager::PremultipliedBlendMode()
+{
+    // dst = src + dst * (1 - srcA), sur les couleurs comme sur l'alpha
+    return SDL_ComposeCustomBlendMode(SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+                                      SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+}
+
+void TextureManager::SetPremultiplyAlpha(bool enabled)
+{
+    m_premultiplyAlpha = false;
+    if (!enabled) return;
+    if (SoftRenderer::GetInstance()->IsActive()) {
+        SDL_Log("TextureManager - Alpha premultiplie ignore avec le rendu logiciel.");
+        return;
+    }
+    // Tous les renderers n'acceptent pas les modes composés (ex: SDL_RENDERER_SOFTWARE) : on teste.
+    SDL_Texture* probe = SDL_CreateTexture(Engine::GetInstance()->GetRenderer(), SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, 1, 1);
+    if (probe != nullptr) {
+        m_premultiplyAlpha = SDL_SetTextureBlendMode(probe, PremultipliedBlendMode()) == 0;
+        SDL_DestroyTexture(probe);
+    }
+    SDL_Log("TextureManager - Alpha premultiplie %s.", m_premultiplyAlpha ? "actif" : "non supporte par le renderer");
+}
+
 bool TextureManager::Load(std::string id, std::string filename)
 {
-    if (m_TextureMap.count(id)) {
+    if (IsTextureLoaded(id)) {
         SDL_Log("Texture '%s' (ID: %s) already loaded.", filename.c_str(), id.c_str());
         return true;
     }
 
-    SDL_Surface* surface = IMG_Load(filename.c_str());
+    SDL_RWops* rw = AssetPack::GetInstance()->Open(filename);
+    if(rw == nullptr)
+    {
+        SDL_Log("Failed to open texture file: %s, Error: %s", filename.c_str(), SDL_GetError());
+        return false;
+    }
+
+    SDL_Surface* surface = IMG_Load_RW(rw, 1);
     if(surface == nullptr)
     {
         SDL_Log("Failed to load texture file: %s, Error: %s", filename.c_str(), IMG_GetError());
         return false;
     }
 
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(Engine::GetInstance()->GetRenderer(), surface);
+    bool created = CreateFromSurface(id, surface);
     SDL_FreeSurface(surface);
-    if(texture == nullptr)
+    if(!created)
     {
         SDL_Log("Failed to create texture from surface for file %s: Error: %s", filename.c_str(), SDL_GetError());
         return false;
     }
+    m_TextureSource[id] = filename;
+    LogLoaded(id, filename);
+    return true;
+}
+
+bool TextureManager::LoadBatch(const std::vector<std::pair<std::string, std::string>>& files)
+{
+    const int count = static_cast<int>(files.size());
+    std::vector<bool> skipped(count);
+    for (int i = 0; i < count; ++i) skipped[i] = IsTextureLoaded(files[i].first);
+
+    // Le décodage PNG/JPG et la préparation ne touchent ni au renderer ni aux maps : ils
+    // tournent sur les workers, seule la création des textures reste sur ce thread.
+    std::vector<SDL_Surface*> surfaces(count, nullptr);
+    std::vector<TextureInfo> infos(count);
+    std::vector<std::string> errors(count);
+    JobSystem::GetInstance()->ParallelFor("texture_decode", count, 1, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            if (!skipped[i]) surfaces[i] = LoadPrepared(files[i].second, &infos[i], &errors[i]);
+        }
+    });
+
+    bool success = true;
+    for (int i = 0; i < count; ++i) {
+        const std::string& id = files[i].first;
+        const std::string& filename = files[i].second;
+        if (skipped[i]) {
+            SDL_Log("Texture '%s' (ID: %s) already loaded.", filename.c_str(), id.c_str());
+            continue;
+        }
+        if (surfaces[i] == nullptr) {
+            SDL_Log("Failed to load texture file: %s, Error: %s", filename.c_str(), errors[i].c_str());
+            success = false;
+            continue;
+        }
+        if (!AddPrepared(id, filename, surfaces[i], infos[i])) success = false;
+    }
+    return success;
+}
+
+SDL_Surface* TextureManager::LoadPrepared(const std::string& filename, TextureInfo* info, std::string* error) const
+{
+    // SDL_GetError est propre à chaque thread : le message est recopié pour l'appelant.
+    SDL_RWops* rw = AssetPack::GetInstance()->Open(filename);
+    if (rw == nullptr) {
+        *error = SDL_GetError();
+        return nullptr;
+    }
+    SDL_Surface* surface = IMG_Load_RW(rw, 1);
+    if (surface == nullptr) {
+        *error = IMG_GetError();
+        return nullptr;
+    }
+    SDL_Surface* prepared = PrepareSurface(surface, info);
+    SDL_FreeSurface(surface);
+    if (prepared == nullptr) *error = SDL_GetError();
+    return prepared;
+}
 
-    m_TextureMap[id] = texture;
-    SDL_Log("Loaded Texture: %s as ID: %s", filename.c_str(), id.c_str());
+bool TextureManager::AddPrepared(const std::string& id, const std::string& filename, SDL_Surface* prepared, const TextureInfo& info)
+{
+    if (!CreateFromPrepared(id, prepared, info)) {
+        SDL_Log("Failed to create texture from surface for file %s: Error: %s", filename.c_str(), SDL_GetError());
+        return false;
+    }
+    m_TextureSource[id] = filename;
+    LogLoaded(id, filename);
     return true;
 }
 
+void TextureManager::LogLoaded(const std::string& id, const std::string& filename) const
+{
+    const TextureInfo& info = m_TextureInfo.at(id);
+    if (info.opaque) {
+        SDL_Log("Loaded Texture: %s as ID: %s (opaque)", filename.c_str(), id.c_str());
+    } else if (info.trim.w != info.width || info.trim.h != info.height) {
+        SDL_Log("Loaded Texture: %s as ID: %s (trimmed %dx%d -> %dx%d)", filename.c_str(), id.c_str(),
+                info.width, info.height, info.trim.w, info.trim.h);
+    } else {
+        SDL_Log("Loaded Texture: %s as ID: %s", filename.c_str(), id.c_str());
+    }
+}
+
+bool TextureManager::LoadFromSurface(const std::string& id, SDL_Surface* surface)
+{
+    if (IsTextureLoaded(id)) {
+        // Remplacement silencieux : le HUD régénère ses textes régulièrement.
+        auto it = m_TextureMap.find(id);
+        if (it != m_TextureMap.end()) { SDL_DestroyTexture(it->second); m_TextureMap.erase(it); }
+        auto its = m_SurfaceMap.find(id);
+        if (its != m_SurfaceMap.end()) {
+            SoftRenderer::GetInstance()->Flush(); // Des commandes peuvent encore lire l'ancienne surface
+            SDL_FreeSurface(its->second);
+            m_SurfaceMap.erase(its);
+        }
+    }
+    return CreateFromSurface(id, surface);
+}
+
+bool TextureManager::CreateFromSurface(const std::string& id, SDL_Surface* surface)
+{
+    TextureInfo info;
+    SDL_Surface* prepared = PrepareSurface(surface, &info);
+    return prepared != nullptr && CreateFromPrepared(id, prepared, info);
+}
+
+SDL_Surface* TextureManager::PrepareSurface(SDL_Surface* surface, TextureInfo* infoOut) const
+{
+    // Import : tout passe en ARGB8888 pour analyser le canal alpha (couleur transparente comprise).
+    SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_ARGB8888, 0);
+    if (converted == nullptr) return nullptr;
+
+    TextureInfo info;
+    info.width = converted->w;
+    info.height = converted->h;
+    info.opaque = AnalyzeAlpha(converted, &info.trim);
+    if (info.trim.w == 0 || info.opaque) {
+        info.trim = { 0, 0, info.width, info.height };
+    } else if (info.trim.w != info.width || info.trim.h != info.height) {
+        // Les bords entièrement transparents ne sont ni stockés ni mélangés.
+        SDL_Surface* trimmed = SDL_CreateRGBSurfaceWithFormat(0, info.trim.w, info.trim.h, 32, SDL_PIXELFORMAT_ARGB8888);
+        if (trimmed != nullptr) {
+            SDL_SetSurfaceBlendMode(converted, SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(converted, &info.trim, trimmed, nullptr);
+            SDL_FreeSurface(converted);
+            converted = trimmed;
+        } else {
+            info.trim = { 0, 0, info.width, info.height };
+        }
+    }
+    info.premultiplied = !info.opaque && m_premultiplyAlpha;
+    if (info.premultiplied) PremultiplySurface(converted);
+    *infoOut = info;
+    return converted;
+}
+
+bool TextureManager::CreateFromPrepared(const std::string& id, SDL_Surface* prepared, const TextureInfo& info)
+{
+    SDL_BlendMode mode = info.opaque ? SDL_BLENDMODE_NONE : (info.premultiplied ? PremultipliedBlendMode() : SDL_BLENDMODE_BLEND);
+
+    if (SoftRenderer::GetInstance()->IsActive()) {
+        SDL_SetSurfaceBlendMode(prepared, mode);
+        m_SurfaceMap[id] = prepared;
+    } else {
+        SDL_Texture* texture = SDL_CreateTextureFromSurface(Engine::GetInstance()->GetRenderer(), prepared);
+        SDL_FreeSurface(prepared);
+        if (texture == nullptr) return false;
+        SDL_SetTextureBlendMode(texture, mode);
+        m_TextureMap[id] = texture;
+    }
+    m_TextureInfo[id] = info;
+    return true;
+}
+
+SDL_Rect TextureManager::TrimmedDestination(const std::string& id, int x, int y, int width, int height, SDL_RendererFlip flip) const
+{
+    auto it = m_TextureInfo.find(id);
+    if (it == m_TextureInfo.end()) return SDL_Rect{ x, y, width, height };
+    const TextureInfo& info = it->second;
+    if (info.trim.w == info.width && info.trim.h == info.height) return SDL_Rect{ x, y, width, height };
+
+    // Position de la zone conservée dans le rectangle logique, miroir compris.
+    int left = (flip & SDL_FLIP_HORIZONTAL) ? info.width - (info.trim.x + info.trim.w) : info.trim.x;
+    int top = (flip & SDL_FLIP_VERTICAL) ? info.height - (info.trim.y + info.trim.h) : info.trim.y;
+    int x0 = x + left * width / info.width;
+    int x1 = x + (left + info.trim.w) * width / info.width;
+    int y0 = y + top * height / info.height;
+    int y1 = y + (top + info.trim.h) * height / info.height;
+    return SDL_Rect{ x0, y0, x1 - x0, y1 - y0 };
+}
+
 void TextureManager::Draw(std::string id, int x, int y, int width, int height, SDL_RendererFlip flip)
 {
-    SDL_Rect dstRect = {x, y, width, height};
+    SDL_Rect dstRect = TrimmedDestination(id, x, y, width, height, flip);
+
+    if (SoftRenderer::GetInstance()->IsActive()) {
+        auto its = m_SurfaceMap.find(id);
+        if (its == m_SurfaceMap.end()) {
+            SDL_Log("Warning: Attempted to draw non-existent texture ID: %s", id.c_str());
+            return;
+        }
+        SDL_BlendMode mode;
+        SDL_GetSurfaceBlendMode(its->second, &mode);
+        RenderStats::GetInstance()->RecordDraw(its->second, dstRect, mode != SDL_BLENDMODE_NONE);
+        SoftRenderer::GetInstance()->Blit(its->second, nullptr, dstRect, mode, flip);
+        return;
+    }
 
     auto it = m_TextureMap.find(id);
     if (it != m_TextureMap.end()) {
+       SDL_BlendMode mode;
+       SDL_GetTextureBlendMode(it->second, &mode);
+       RenderStats::GetInstance()->RecordDraw(it->second, dstRect, mode != SDL_BLENDMODE_NONE);
        SDL_RenderCopyEx(Engine::GetInstance()->GetRenderer(), it->second, NULL, &dstRect, 0, nullptr, flip);
     } else {
         SDL_Log("Warning: Attempted to draw non-existent texture ID: %s", id.c_str());
     }
 }
 
-bool TextureManager::QueryTexture(const std::string& id, int* width, int* height) {
+void TextureManager::DrawCopy(const std::string& id, int x, int y, int width, int height)
+{
+    if (SoftRenderer::GetInstance()->IsActive()) {
+        auto its = m_SurfaceMap.find(id);
+        if (its == m_SurfaceMap.end()) {
+            SDL_Log("Warning: Attempted to copy non-existent texture ID: %s", id.c_str());
+            return;
+        }
+        SDL_Rect dstRect = TrimmedDestination(id, x, y, width, height, SDL_FLIP_NONE);
+        RenderStats::GetInstance()->RecordDraw(its->second, dstRect, false);
+        SoftRenderer::GetInstance()->Blit(its->second, nullptr, dstRect, SDL_BLENDMODE_NONE);
+        return;
+    }
+
     auto it = m_TextureMap.find(id);
     if (it == m_TextureMap.end()) {
+        SDL_Log("Warning: Attempted to copy non-existent texture ID: %s", id.c_str());
+        return;
+    }
+    SDL_BlendMode previousMode;
+    SDL_GetTextureBlendMode(it->second, &previousMode);
+    SDL_SetTextureBlendMode(it->second, SDL_BLENDMODE_NONE);
+    SDL_Rect dstRect = TrimmedDestination(id, x, y, width, height, SDL_FLIP_NONE);
+    RenderStats::GetInstance()->RecordDraw(it->second, dstRect, false);
+    SDL_RenderCopy(Engine::GetInstance()->GetRenderer(), it->second, NULL, &dstRect);
+    SDL_SetTextureBlendMode(it->second, previousMode);
+}
+
+void TextureManager::FillRect(const SDL_Rect& rect, Uint8 r, Uint8 g, Uint8 b)
+{
+    RenderStats::GetInstance()->RecordFill(rect, false);
+    if (SoftRenderer::GetInstance()->IsActive()) {
+        SoftRenderer::GetInstance()->Fill(&rect, r, g, b, 255, SDL_BLENDMODE_NONE);
+        return;
+    }
+    SDL_Renderer* renderer = Engine::GetInstance()->GetRenderer();
+    SDL_SetRenderDrawColor(renderer, r, g, b, 255);
+    SDL_RenderFillRect(renderer, &rect);
+}
+
+bool TextureManager::IsTextureLoaded(const std::string& id) const {
+    auto it = m_TextureMap.find(id);
+    if (it != m_TextureMap.end() && it->second != nullptr) return true;
+    auto its = m_SurfaceMap.find(id);
+    return its != m_SurfaceMap.end() && its->second != nullptr;
+}
+
+bool TextureManager::QueryTexture(const std::string& id, int* width, int* height) {
+    // Taille logique : celle de l'image d'origine, avant découpe des bords transparents.
+    auto it = m_TextureInfo.find(id);
+    if (it == m_TextureInfo.end()) {
         SDL_Log("Texture ID '%s' not found in QueryTexture.", id.c_str());
         if (width) *width = 0;
         if (height) *height = 0;
         return false;
     }
+    if (width) *width = it->second.width;
+    if (height) *height = it->second.height;
+    return true;
+}
 
-    if (SDL_QueryTexture(it->second, nullptr, nullptr, width, height) != 0) {
-         SDL_Log("Failed to query texture '%s': %s", id.c_str(), SDL_GetError());
-         if (width) *width = 0;
-         if (height) *height = 0;
-         return false;
+const TextureInfo* TextureManager::GetTextureInfo(const std::string& id) const {
+    auto it = m_TextureInfo.find(id);
+    return it != m_TextureInfo.end() ? &it->second : nullptr;
+}
+
+bool TextureManager::Replace(const std::string& id, SDL_Surface* prepared, const TextureInfo& info)
+{
+    if (!IsTextureLoaded(id)) {
+        SDL_Log("Warning: Tried to replace non-existent texture ID: %s", id.c_str());
+        SDL_FreeSurface(prepared);
+        return false;
+    }
+    auto it = m_TextureMap.find(id);
+    if (it != m_TextureMap.end()) { SDL_DestroyTexture(it->second); m_TextureMap.erase(it); }
+    auto its = m_SurfaceMap.find(id);
+    if (its != m_SurfaceMap.end()) {
+        SoftRenderer::GetInstance()->Flush(); // Des commandes peuvent encore lire l'ancienne surface
+        SDL_FreeSurface(its->second);
+        m_SurfaceMap.erase(its);
     }
+    m_TextureInfo.erase(id);
+    if (!CreateFromPrepared(id, prepared, info)) {
+        SDL_Log("Failed to recreate texture ID: %s, Error: %s", id.c_str(), SDL_GetError());
+        m_TextureSource.erase(id);
+        return false;
+    }
+    SDL_Log("Reloaded Texture: %s as ID: %s (%dx%d)", m_TextureSource[id].c_str(), id.c_str(), info.width, info.height);
     return true;
 }
 
+std::vector<std::string> TextureManager::GetIdsForFile(const std::string& filename) const
+{
+    std::vector<std::string> ids;
+    for (const auto& pair : m_TextureSource) {
+        if (pair.second == filename) ids.push_back(pair.first);
+    }
+    return ids;
+}
+
 void TextureManager::Drop(std::string id)
 {
+    m_TextureInfo.erase(id);
+    m_TextureSource.erase(id);
+    auto its = m_SurfaceMap.find(id);
+    if (its != m_SurfaceMap.end()) {
+        SoftRenderer::GetInstance()->Flush();
+        SDL_FreeSurface(its->second);
+        m_SurfaceMap.erase(its);
+        SDL_Log("Dropped texture ID: %s", id.c_str());
+        return;
+    }
+
     auto it = m_TextureMap.find(id);
     if (it != m_TextureMap.end()) {
         if (it->second != nullptr) {
@@ -85,5 +443,12 @@ void TextureManager::Clean()
         }
     }
     m_TextureMap.clear();
+    if (!m_SurfaceMap.empty()) SoftRenderer::GetInstance()->Flush();
+    for (auto& pair : m_SurfaceMap) {
+        SDL_FreeSurface(pair.second);
+    }
+    m_SurfaceMap.clear();
+    m_TextureInfo.clear();
+    m_TextureSource.clear();
     SDL_Log("Texture map cleaned!");
 }
@@ -2,9 +2,23 @@
 #define TEXTUREMANAGER_H
 
 #include <string>
+#include <utility>
+#include <vector>
 #include "SDL.h"
 #include <map>
 
+// Informations d'import calculées au chargement (analyse du canal alpha).
+// Les appels Draw/QueryTexture travaillent toujours sur la taille logique de l'image d'origine ;
+// seule la zone non transparente 'trim' est conservée dans la texture.
+struct TextureInfo
+{
+    int width;          // Taille logique (image d'origine)
+    int height;
+    SDL_Rect trim;      // Zone conservée, dans l'image d'origine
+    bool opaque;        // Aucun pixel transparent : dessinée en SDL_BLENDMODE_NONE
+    bool premultiplied; // Couleurs prémultipliées par l'alpha (voir SetPremultiplyAlpha)
+};
+
 class TextureManager
 {
 public:
@@ -13,17 +27,56 @@ public:
         return s_Instance = (s_Instance != nullptr)? s_Instance : new TextureManager();
     }
 
+    // À appeler avant les Load() : les textures semi-transparentes chargées ensuite sont
+    // prémultipliées si le renderer accepte le mode de mélange correspondant.
+    void SetPremultiplyAlpha(bool enabled);
+    inline bool IsPremultiplyingAlpha() const { return m_premultiplyAlpha; }
+    static SDL_BlendMode PremultipliedBlendMode();
+
     bool Load(std::string id, std::string filename);
+    // Plusieurs fichiers { id, chemin } : décodage en parallèle sur le JobSystem, puis création des
+    // textures sur le thread appelant, dans l'ordre. Faux si au moins un fichier a échoué.
+    bool LoadBatch(const std::vector<std::pair<std::string, std::string>>& files);
+    // Crée (ou remplace) la texture 'id' à partir d'une surface (texte du HUD...). Ne libère pas surface.
+    bool LoadFromSurface(const std::string& id, SDL_Surface* surface);
+
+    // Chargement en deux temps (voir TexturePreloader). LoadPrepared décode et prépare un fichier
+    // (ARGB8888, analyse alpha, rognage, prémultiplication) sans toucher au renderer ni aux maps :
+    // appelable depuis un worker. nullptr en cas d'échec, avec le message dans error.
+    SDL_Surface* LoadPrepared(const std::string& filename, TextureInfo* info, std::string* error) const;
+    // Thread de rendu : crée la texture 'id' à partir d'une surface de LoadPrepared, qui est libérée.
+    bool AddPrepared(const std::string& id, const std::string& filename, SDL_Surface* prepared, const TextureInfo& info);
+    // Remplace la texture 'id' déjà chargée (rechargement à chaud, voir AssetWatcher). Thread de
+    // rendu ; prepared est reprise dans tous les cas.
+    bool Replace(const std::string& id, SDL_Surface* prepared, const TextureInfo& info);
+    // Identifiants des textures chargées depuis ce fichier (Load, LoadBatch, AddPrepared)
+    std::vector<std::string> GetIdsForFile(const std::string& filename) const;
     void Drop(std::string id);
     void Clean();
 
     void Draw(std::string id, int x, int y, int width, int height, SDL_RendererFlip flip = SDL_FLIP_NONE);
+    // Copie sans mélange (alpha compris), pour composer une texture seule dans un calque de LayerCache.
+    void DrawCopy(const std::string& id, int x, int y, int width, int height);
+    void FillRect(const SDL_Rect& rect, Uint8 r, Uint8 g, Uint8 b);
 
     bool QueryTexture(const std::string& id, int* width, int* height);
+    bool IsTextureLoaded(const std::string& id) const;
+    const TextureInfo* GetTextureInfo(const std::string& id) const;
 
 private:
-    TextureManager() {}
+    TextureManager() : m_premultiplyAlpha(false) {}
+    bool CreateFromSurface(const std::string& id, SDL_Surface* surface);
+    SDL_Surface* PrepareSurface(SDL_Surface* surface, TextureInfo* info) const;
+    bool CreateFromPrepared(const std::string& id, SDL_Surface* prepared, const TextureInfo& info);
+    void LogLoaded(const std::string& id, const std::string& filename) const;
+    SDL_Rect TrimmedDestination(const std::string& id, int x, int y, int width, int height, SDL_RendererFlip flip) const;
+
     std::map<std::string, SDL_Texture*> m_TextureMap;
+    // Avec le rendu logiciel (SoftRenderer), les textures restent des surfaces ARGB8888 en mémoire.
+    std::map<std::string, SDL_Surface*> m_SurfaceMap;
+    std::map<std::string, TextureInfo> m_TextureInfo;
+    std::map<std::string, std::string> m_TextureSource; // Fichier d'origine de chaque texture
+    bool m_premultiplyAlpha;
     static TextureManager* s_Instance;
 };
 
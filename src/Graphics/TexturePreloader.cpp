@@ -0,0 +1,234 @@
+#include "TexturePreloader.h"
+
+TexturePreloader* TexturePreloader::s_Instance = nullptr;
+
+void TexturePreloader::Request(const std::string& group, const TextureList& textures) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto existing = m_groups.find(group);
+    if (existing != m_groups.end()) {
+        if (existing->second.state != GROUP_FAILED) return;
+        // Échec peut-être passager (fichier en cours d'écriture, voir AssetWatcher) : les textures
+        // en échec sont redécodées
+        Group& failed = existing->second;
+        failed.state = GROUP_LOADING;
+        failed.requested = SDL_GetPerformanceCounter();
+        for (const auto& member : failed.members) {
+            if (member.item->state == ITEM_FAILED) Decode(member.item);
+        }
+        SDL_Log("TexturePreloader::Request - Groupe '%s' : nouvelle tentative.", group.c_str());
+        RefreshGroups();
+        return;
+    }
+
+    Group& entry = m_groups[group];
+    entry.requested = SDL_GetPerformanceCounter();
+    for (const auto& texture : textures) {
+        ItemPtr& item = m_items[texture.id];
+        if (!item) {
+            item = std::make_shared<Item>();
+            item->request = texture;
+            Decode(item);
+        } else if (item->state == ITEM_FAILED) {
+            Decode(item); // En échec pour un autre groupe
+        }
+        entry.members.push_back({ item, texture.optional });
+    }
+    SDL_Log("TexturePreloader::Request - Groupe '%s' : %d texture(s).", group.c_str(), static_cast<int>(textures.size()));
+    RefreshGroups();
+}
+
+void TexturePreloader::Decode(const ItemPtr& item) {
+    item->state = ITEM_DECODING;
+    item->error.clear();
+    ++m_pending;
+    // Le job ne garde qu'un pointeur brut : Clean attend les décodages avant de tout libérer.
+    Item* raw = item.get();
+    item->job = JobSystem::GetInstance()->Schedule("texture_preload", [this, raw] {
+        TextureInfo info;
+        std::string error;
+        SDL_Surface* surface = TextureManager::GetInstance()->LoadPrepared(raw->request.path, &info, &error);
+        std::lock_guard<std::mutex> jobLock(m_mutex);
+        raw->surface = surface;
+        raw->info = info;
+        raw->error = error;
+        raw->state = ITEM_DECODED;
+    });
+}
+
+TexturePreloader::GroupState TexturePreloader::GetState(const std::string& group) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_groups.find(group);
+    return it != m_groups.end() ? it->second.state : GROUP_UNKNOWN;
+}
+
+bool TexturePreloader::GetSize(const std::string& id, int* width, int* height) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_items.find(id);
+    if (it == m_items.end()) return false;
+    const Item& item = *it->second;
+    bool decoded = item.state == ITEM_CREATED || (item.state == ITEM_DECODED && item.surface != nullptr);
+    if (!decoded) return false;
+    *width = item.info.width;
+    *height = item.info.height;
+    return true;
+}
+
+void TexturePreloader::UpdateSize(const std::string& id, const TextureInfo& info) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_items.find(id);
+    if (it != m_items.end() && it->second->state == ITEM_CREATED) it->second->info = info;
+}
+
+bool TexturePreloader::HasWork() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_pending > 0 || !m_released.empty();
+}
+
+void TexturePreloader::Pump(double budgetMs) {
+    const Uint64 start = SDL_GetPerformanceCounter();
+    const Uint64 budget = static_cast<Uint64>(budgetMs * SDL_GetPerformanceFrequency() / 1000.0);
+    JobSystem* jobs = JobSystem::GetInstance();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto it = m_released.begin(); it != m_released.end(); ) {
+            if ((*it)->state == ITEM_DECODING) {
+                ++it;
+                continue;
+            }
+            if ((*it)->surface != nullptr) SDL_FreeSurface((*it)->surface);
+            it = m_released.erase(it);
+        }
+    }
+
+    for (;;) {
+        ItemPtr next;
+        JobSystem::JobHandle decoding;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_pending == 0) return;
+            for (const auto& entry : m_items) {
+                if (entry.second->state == ITEM_DECODED) {
+                    next = entry.second;
+                    break;
+                }
+                if (entry.second->state == ITEM_DECODING && !decoding) decoding = entry.second->job;
+            }
+        }
+
+        if (!next) {
+            // Sans worker, un décodage ne progresse que dans Wait() : on en fait un par tranche.
+            if (jobs->GetWorkerCount() > 0 || !decoding) return;
+            jobs->Wait(decoding);
+        } else {
+            // Seul ce thread touche un item décodé : la surface peut être utilisée hors verrou.
+            const TextureRequest& request = next->request;
+            TextureManager* textures = TextureManager::GetInstance();
+            bool created = false, owned = false;
+            if (next->surface == nullptr) {
+                SDL_Log("TexturePreloader::Pump - ECHEC: %s (%s) : %s", request.id.c_str(), request.path.c_str(), next->error.c_str());
+            } else if (textures->IsTextureLoaded(request.id)) {
+                SDL_FreeSurface(next->surface); // Déjà chargée par ailleurs (menu...)
+                created = true;
+            } else {
+                created = textures->AddPrepared(request.id, request.path, next->surface, next->info);
+                owned = created;
+            }
+            std::lock_guard<std::mutex> lock(m_mutex);
+            next->surface = nullptr;
+            next->owned = owned;
+            Finish(next, created);
+            RefreshGroups();
+        }
+        if (SDL_GetPerformanceCounter() - start >= budget) return;
+    }
+}
+
+TexturePreloader::GroupState TexturePreloader::LoadNow(const std::string& group, const TextureList& textures) {
+    Request(group, textures);
+    std::vector<JobSystem::JobHandle> jobs;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& member : m_groups[group].members) jobs.push_back(member.item->job);
+    }
+    JobSystem::GetInstance()->WaitAll(jobs);
+    GroupState state;
+    while ((state = GetState(group)) == GROUP_LOADING) Pump(1000.0);
+    return state;
+}
+
+void TexturePreloader::Release(const std::string& group) {
+    std::vector<std::string> dropped;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto found = m_groups.find(group);
+        if (found == m_groups.end()) return;
+        std::vector<Member> members = std::move(found->second.members);
+        m_groups.erase(found);
+
+        for (const auto& member : members) {
+            const ItemPtr& item = member.item;
+            bool shared = false;
+            for (const auto& entry : m_groups) {
+                for (const auto& other : entry.second.members) shared = shared || other.item == item;
+            }
+            if (shared) continue;
+
+            m_items.erase(item->request.id);
+            if (item->state == ITEM_CREATED) {
+                if (item->owned) dropped.push_back(item->request.id);
+            } else if (item->state == ITEM_DECODING || item->state == ITEM_DECODED) {
+                --m_pending;
+                m_released.push_back(item);
+            }
+        }
+    }
+    for (const auto& id : dropped) TextureManager::GetInstance()->Drop(id);
+    SDL_Log("TexturePreloader::Release - Groupe '%s' libere, %d texture(s) detruite(s).", group.c_str(), static_cast<int>(dropped.size()));
+}
+
+void TexturePreloader::Clean() {
+    std::vector<JobSystem::JobHandle> jobs;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& entry : m_items) jobs.push_back(entry.second->job);
+        for (const auto& item : m_released) jobs.push_back(item->job);
+    }
+    JobSystem::GetInstance()->WaitAll(jobs);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& entry : m_items) {
+        if (entry.second->surface != nullptr) SDL_FreeSurface(entry.second->surface);
+    }
+    for (const auto& item : m_released) {
+        if (item->surface != nullptr) SDL_FreeSurface(item->surface);
+    }
+    m_items.clear();
+    m_groups.clear();
+    m_released.clear();
+    m_pending = 0;
+}
+
+void TexturePreloader::Finish(const ItemPtr& item, bool created) {
+    item->state = created ? ITEM_CREATED : ITEM_FAILED;
+    --m_pending;
+}
+
+void TexturePreloader::RefreshGroups() {
+    for (auto& entry : m_groups) {
+        Group& group = entry.second;
+        if (group.state != GROUP_LOADING) continue;
+
+        bool done = true, failed = false;
+        for (const auto& member : group.members) {
+            ItemState state = member.item->state;
+            if (state != ITEM_CREATED && state != ITEM_FAILED) done = false;
+            if (state == ITEM_FAILED && !member.optional) failed = true;
+        }
+        if (!done) continue;
+
+        group.state = failed ? GROUP_FAILED : GROUP_READY;
+        double elapsedMs = (SDL_GetPerformanceCounter() - group.requested) * 1000.0 / SDL_GetPerformanceFrequency();
+        SDL_Log("TexturePreloader - Groupe '%s' %s en %.1f ms.", entry.first.c_str(), failed ? "en ECHEC" : "pret", elapsedMs);
+    }
+}
@@ -0,0 +1,111 @@
+#ifndef TEXTUREPRELOADER_H
+#define TEXTUREPRELOADER_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "SDL.h"
+#include "TextureManager.h"
+#include "../Core/JobSystem.h"
+
+// Une texture à précharger. optional : son échec n'empêche pas le groupe d'être prêt.
+struct TextureRequest
+{
+    std::string id;
+    std::string path;
+    bool optional = false;
+};
+typedef std::vector<TextureRequest> TextureList;
+
+// Préchargement des textures d'une scène pendant qu'une autre tourne (voir SceneStack).
+// Un groupe nommé réunit les textures d'une scène ; le décodage et la préparation passent par
+// le JobSystem, et Pump crée les textures sur le thread de rendu par tranches de quelques
+// millisecondes pour ne jamais faire sauter une image. Une texture partagée par plusieurs
+// groupes n'est décodée qu'une fois.
+// Request, GetState et GetSize sont appelables depuis n'importe quel thread (simulation) ;
+// Pump, LoadNow, Release et Clean uniquement depuis le thread de rendu.
+class TexturePreloader
+{
+public:
+    enum GroupState {
+        GROUP_UNKNOWN,  // Jamais demandé
+        GROUP_LOADING,
+        GROUP_READY,    // Toutes les textures sont créées (ou optionnelles et en échec)
+        GROUP_FAILED    // Une texture obligatoire manque
+    };
+
+    static TexturePreloader* GetInstance()
+    {
+        return s_Instance = (s_Instance != nullptr) ? s_Instance : new TexturePreloader();
+    }
+
+    // Lance le décodage du groupe s'il n'a jamais été demandé, sans attendre. Groupe en échec :
+    // ses textures en échec sont redécodées.
+    void Request(const std::string& group, const TextureList& textures);
+    GroupState GetState(const std::string& group) const;
+    // Taille logique d'une texture décodée avec succès (avant rognage)
+    bool GetSize(const std::string& id, int* width, int* height) const;
+    bool HasWork() const; // Décodages ou créations en attente
+    // Thread de rendu : texture créée puis remplacée (voir AssetWatcher), GetSize suit
+    void UpdateSize(const std::string& id, const TextureInfo& info);
+
+    // Crée les textures décodées, en s'arrêtant dès que budgetMs est dépassé
+    void Pump(double budgetMs);
+    // Request puis attente et création de tout le groupe (--golden : résultat déterministe)
+    GroupState LoadNow(const std::string& group, const TextureList& textures);
+    // Oublie le groupe et détruit les textures qu'il a créées et qu'aucun autre groupe n'utilise
+    // (une texture déjà chargée par ailleurs reste à son propriétaire). Un Request
+    // ultérieur le recharge entièrement.
+    void Release(const std::string& group);
+    void Clean(); // Attend les décodages en cours et libère les surfaces jamais créées
+
+private:
+    TexturePreloader() {}
+    static TexturePreloader* s_Instance;
+
+    enum ItemState {
+        ITEM_DECODING,
+        ITEM_DECODED,   // Surface prête (ou échec), en attente de Pump
+        ITEM_CREATED,
+        ITEM_FAILED
+    };
+
+    struct Item
+    {
+        TextureRequest request;
+        ItemState state = ITEM_DECODING;
+        SDL_Surface* surface = nullptr; // Possédée jusqu'à la création de la texture
+        TextureInfo info;
+        std::string error;
+        JobSystem::JobHandle job;
+        bool owned = false; // Texture créée par Pump, et non déjà chargée par ailleurs : Release la détruit
+    };
+    typedef std::shared_ptr<Item> ItemPtr;
+
+    struct Member
+    {
+        ItemPtr item;
+        bool optional;
+    };
+
+    struct Group
+    {
+        std::vector<Member> members;
+        GroupState state = GROUP_LOADING;
+        Uint64 requested = 0; // SDL_GetPerformanceCounter, pour le log
+    };
+
+    void Decode(const ItemPtr& item);               // m_mutex tenu
+    void Finish(const ItemPtr& item, bool created); // m_mutex tenu
+    void RefreshGroups();                           // m_mutex tenu
+
+    mutable std::mutex m_mutex; // Protège tout ce qui suit, et les champs des Item
+    std::map<std::string, ItemPtr> m_items;
+    std::map<std::string, Group> m_groups;
+    std::vector<ItemPtr> m_released; // Libérés pendant leur décodage : surface jetée par Pump
+    int m_pending = 0; // Items pas encore créés ni en échec
+};
+
+#endif // TEXTUREPRELOADER_H
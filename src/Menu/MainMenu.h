@@ -2,6 +2,7 @@
 #define MAINMENU_H
 
 #include "SDL.h"
+#include "WidgetPanel.h"
 // Pas besoin d'inclure Engine.h ici si SCREEN_WIDTH/HEIGHT sont des defines globaux
 // ou si vous les passez en paramètre. Pour l'instant, on suppose qu'ils sont accessibles
 // via Engine::GetInstance() ou des defines comme dans votre Engine.h.
@@ -25,6 +26,24 @@
 #define MENU_SCREEN_WIDTH 1920
 #define MENU_SCREEN_HEIGHT 1080
 
+// État affiché du menu, copié dans l'instantané de rendu (voir RenderSnapshot)
+struct MenuView
+{
+    WidgetPanelView buttons;
+
+    bool operator==(const MenuView& other) const { return buttons == other.buttons; }
+};
+
+// Boutons du menu, dans l'ordre du tableau MENU_WIDGETS (voir MainMenu.cpp)
+enum MenuButton {
+    MENU_PLAY,
+    MENU_ABOUT,
+    MENU_QUIT,
+    MENU_VOLUME_DOWN,
+    MENU_VOLUME_UP,
+    MENU_MUTE, // Apparence 1 : son coupé (Unmute)
+    MENU_BUTTON_COUNT
+};
 
 class MainMenu {
 public:
@@ -39,41 +58,23 @@ public:
     bool Init();
     void HandleEvent(SDL_Event& event);
     void Update(float deltaTime);
-    void Render();
     void Clean();
 
+    // Côté simulation : état courant des boutons
+    MenuView GetView() const;
+    // Côté rendu : dessin et invalidation du calque écran à partir de l'instantané
+    void Render(const MenuView& view);
+    void InvalidateChanges(const MenuView& previous, const MenuView& current);
+    bool IsAnimating(const MenuView& view) const; // Un bouton n'a pas encore atteint son échelle cible
+
 private:
     MainMenu(); // Constructeur privé
     ~MainMenu(); // Destructeur pour appeler Clean
 
     static MainMenu* s_Instance;
-                
-    // Coordonnées et dimensions des boutons
-    // Il est préférable d'initialiser les valeurs dans le constructeur ou Init()
-    // plutôt que directement dans la déclaration de la classe si elles dépendent de SCREEN_WIDTH/HEIGHT.
-    SDL_Rect m_playButtonRect;
-    SDL_Rect m_aboutButtonRect;
-    SDL_Rect m_quitButtonRect;
-    
-    SDL_Rect m_volDownRect;
-    SDL_Rect m_muteToggleRect;
-    SDL_Rect m_volUpRect;
-
-    // États de survol et d'animation
-    bool m_playHovered, m_aboutHovered, m_quitHovered;
-    // m_playClicked, m_aboutClicked, m_quitClicked; // Semblent non utilisés pour l'état, juste pour l'action
-    float m_playScale;
-    float m_aboutScale;
-    float m_quitScale;
-
-    bool m_volDownHovered, m_volUpHovered, m_muteToggleHovered;
-    float m_volDownScale;
-    float m_volUpScale;
-    float m_muteToggleScale;
 
-    const float m_defaultScale = 1.0f; // Échelle par défaut
-    const float m_hoverScaleFactor = 1.1f; // Facteur d'agrandissement au survol
-    const float m_scaleSpeed = 8.0f; // Vitesse d'animation de l'échelle
+    // Boutons décrits par MENU_WIDGETS : survol, animation et invalidation (voir WidgetPanel)
+    WidgetPanel m_buttons;
 };
 
 #endif // MAINMENU_H
\ No newline at end of file
@@ -0,0 +1,187 @@
+#include "WidgetPanel.h"
+#include "../Core/Engine.h" // LAYER_SCREEN
+#include "../Graphics/LayerCache.h"
+#include "../Graphics/TextureManager.h"
+#include <algorithm>
+#include <cmath>
+
+const float WidgetPanel::DEFAULT_SCALE = 1.0f;
+const float WidgetPanel::HOVER_SCALE = 1.1f;
+const float WidgetPanel::SCALE_SPEED = 8.0f;
+const int WidgetPanel::CELL_SIZE;
+const int WidgetPanelView::MAX_WIDGETS;
+
+WidgetPanel::WidgetPanel() :
+    m_bounds({ 0, 0, 0, 0 }), m_columns(0), m_rows(0), m_hovered(-1), m_version(0)
+{
+}
+
+bool WidgetPanel::Load(const WidgetDef* defs, int count) {
+    if (count > WidgetPanelView::MAX_WIDGETS) {
+        SDL_Log("WidgetPanel::Load - ERREUR: %d widgets, %d au plus.", count, WidgetPanelView::MAX_WIDGETS);
+        return false;
+    }
+    m_rects.clear();
+    m_textureIds.assign(static_cast<size_t>(count) * WIDGET_SKINS * 2, std::string());
+    std::vector<std::pair<std::string, std::string>> files;
+    for (int widget = 0; widget < count; ++widget) {
+        const WidgetDef& def = defs[widget];
+        m_rects.push_back(def.rect);
+        for (int skin = 0; skin < WIDGET_SKINS; ++skin) {
+            const WidgetDef::Skin& source = def.skins[skin].id != nullptr ? def.skins[skin] : def.skins[0];
+            std::string id = source.id;
+            std::string hoverId = source.hoverFile != nullptr ? id + "_hover" : id;
+            m_textureIds[(widget * WIDGET_SKINS + skin) * 2] = id;
+            m_textureIds[(widget * WIDGET_SKINS + skin) * 2 + 1] = hoverId;
+            if (def.skins[skin].id == nullptr) continue;
+            files.push_back({ id, source.file });
+            if (source.hoverFile != nullptr) files.push_back({ hoverId, source.hoverFile });
+        }
+    }
+    if (!TextureManager::GetInstance()->LoadBatch(files)) {
+        SDL_Log("WidgetPanel::Load - ERREUR: textures des widgets incompletes.");
+        return false;
+    }
+
+    // Grille de survol sur la zone couverte par les widgets (statiques : construite une fois)
+    m_bounds = count > 0 ? m_rects[0] : SDL_Rect{ 0, 0, 0, 0 };
+    for (const SDL_Rect& rect : m_rects) SDL_UnionRect(&m_bounds, &rect, &m_bounds);
+    m_columns = (m_bounds.w + CELL_SIZE - 1) / CELL_SIZE;
+    m_rows = (m_bounds.h + CELL_SIZE - 1) / CELL_SIZE;
+    m_cellStart.assign(static_cast<size_t>(m_columns) * m_rows + 1, 0);
+    auto forEachCell = [&](const SDL_Rect& rect, auto&& fn) {
+        int x0 = (rect.x - m_bounds.x) / CELL_SIZE, x1 = (rect.x + rect.w - 1 - m_bounds.x) / CELL_SIZE;
+        int y0 = (rect.y - m_bounds.y) / CELL_SIZE, y1 = (rect.y + rect.h - 1 - m_bounds.y) / CELL_SIZE;
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) fn(y * m_columns + x);
+        }
+    };
+    for (const SDL_Rect& rect : m_rects) forEachCell(rect, [&](int cell) { ++m_cellStart[cell + 1]; });
+    for (size_t cell = 1; cell < m_cellStart.size(); ++cell) m_cellStart[cell] += m_cellStart[cell - 1];
+    m_cellWidgets.assign(m_cellStart.back(), 0);
+    std::vector<int> fill(m_cellStart.begin(), m_cellStart.end() - 1);
+    for (int widget = 0; widget < count; ++widget) {
+        forEachCell(m_rects[widget], [&](int cell) { m_cellWidgets[fill[cell]++] = widget; });
+    }
+
+    m_scales.assign(count, DEFAULT_SCALE);
+    m_targets.assign(count, DEFAULT_SCALE);
+    m_skins.assign(count, 0);
+    m_animating.clear();
+    m_hovered = -1;
+    ++m_version;
+    SDL_Log("WidgetPanel::Load - %d widgets, %zu textures, grille de survol %dx%d.", count, files.size(), m_columns, m_rows);
+    return true;
+}
+
+void WidgetPanel::Drop() {
+    for (size_t i = 0; i < m_textureIds.size(); i += 2) {
+        TextureManager::GetInstance()->Drop(m_textureIds[i]);
+        if (m_textureIds[i + 1] != m_textureIds[i]) TextureManager::GetInstance()->Drop(m_textureIds[i + 1]);
+    }
+}
+
+int WidgetPanel::HitTest(SDL_Point point) const {
+    if (!SDL_PointInRect(&point, &m_bounds)) return -1;
+    int cell = ((point.y - m_bounds.y) / CELL_SIZE) * m_columns + (point.x - m_bounds.x) / CELL_SIZE;
+    for (int i = m_cellStart[cell]; i < m_cellStart[cell + 1]; ++i) {
+        int widget = m_cellWidgets[i];
+        if (SDL_PointInRect(&point, &m_rects[widget])) return widget;
+    }
+    return -1;
+}
+
+int WidgetPanel::SetPointer(SDL_Point point) {
+    int hovered = HitTest(point);
+    if (hovered == m_hovered) return hovered;
+    if (m_hovered >= 0) {
+        m_targets[m_hovered] = DEFAULT_SCALE;
+        Animate(m_hovered);
+    }
+    if (hovered >= 0) {
+        m_targets[hovered] = HOVER_SCALE;
+        Animate(hovered);
+    }
+    m_hovered = hovered;
+    ++m_version; // Texture de survol
+    return hovered;
+}
+
+void WidgetPanel::Animate(int widget) {
+    if (std::find(m_animating.begin(), m_animating.end(), widget) == m_animating.end()) m_animating.push_back(widget);
+}
+
+void WidgetPanel::SetSkin(int widget, int skin) {
+    if (m_skins[widget] == skin) return;
+    m_skins[widget] = static_cast<Uint8>(skin);
+    ++m_version;
+}
+
+void WidgetPanel::Update(float deltaTime) {
+    if (m_animating.empty()) return;
+    float step = SCALE_SPEED * deltaTime;
+    for (size_t i = 0; i < m_animating.size();) {
+        int widget = m_animating[i];
+        float& scale = m_scales[widget];
+        float target = m_targets[widget];
+        // Évite les micro-changements : cible atteinte à 0,01 près
+        if (std::abs(target - scale) <= std::max(step, 0.01f)) {
+            scale = target;
+        } else {
+            scale += (scale < target) ? step : -step;
+        }
+        if (scale == target) {
+            m_animating[i] = m_animating.back();
+            m_animating.pop_back();
+        } else {
+            ++i;
+        }
+    }
+    ++m_version;
+}
+
+WidgetPanelView WidgetPanel::GetView() const {
+    WidgetPanelView view;
+    view.version = m_version;
+    view.count = static_cast<int>(m_rects.size());
+    view.hovered = m_hovered;
+    view.animating = !m_animating.empty();
+    std::copy(m_skins.begin(), m_skins.end(), view.skins);
+    std::copy(m_scales.begin(), m_scales.end(), view.scales);
+    return view;
+}
+
+void WidgetPanel::InvalidateChanges(const WidgetPanelView& previous, const WidgetPanelView& current) const {
+    if (previous == current) return;
+    int count = std::min(current.count, static_cast<int>(m_rects.size()));
+    for (int widget = 0; widget < count; ++widget) {
+        // Survol (texture), apparence ou animation d'échelle : zone du widget à redessiner
+        bool hoverChanged = (previous.hovered == widget) != (current.hovered == widget);
+        if (hoverChanged || widget >= previous.count || previous.skins[widget] != current.skins[widget] ||
+            previous.scales[widget] != current.scales[widget]) {
+            InvalidateWidget(widget);
+        }
+    }
+}
+
+void WidgetPanel::InvalidateWidget(int widget) const {
+    // Zone maximale occupée par le widget agrandi au survol (+1 px pour les arrondis)
+    const SDL_Rect& rect = m_rects[widget];
+    int maxWidth = static_cast<int>(rect.w * HOVER_SCALE) + 2;
+    int maxHeight = static_cast<int>(rect.h * HOVER_SCALE) + 2;
+    SDL_Rect dirty = { rect.x + (rect.w - maxWidth) / 2, rect.y + (rect.h - maxHeight) / 2, maxWidth, maxHeight };
+    LayerCache::GetInstance()->InvalidateRect(LAYER_SCREEN, dirty);
+}
+
+void WidgetPanel::Render(const WidgetPanelView& view) const {
+    int count = std::min(view.count, static_cast<int>(m_rects.size()));
+    for (int widget = 0; widget < count; ++widget) {
+        const SDL_Rect& rect = m_rects[widget];
+        float scale = view.scales[widget];
+        int scaledWidth = static_cast<int>(rect.w * scale);
+        int scaledHeight = static_cast<int>(rect.h * scale);
+        int posX = rect.x + (rect.w - scaledWidth) / 2;   // Centrer le widget mis à l'échelle
+        int posY = rect.y + (rect.h - scaledHeight) / 2;
+        TextureManager::GetInstance()->Draw(TextureId(widget, view.skins[widget], view.hovered == widget), posX, posY, scaledWidth, scaledHeight);
+    }
+}
@@ -0,0 +1,101 @@
+#ifndef WIDGETPANEL_H
+#define WIDGETPANEL_H
+
+#include <string>
+#include <vector>
+#include "SDL.h"
+
+const int WIDGET_SKINS = 2; // Apparences d'un widget (ex: Mute / Unmute), voir WidgetPanel::SetSkin
+
+// Définition d'un bouton, en données (tableau statique de l'écran qui l'utilise)
+struct WidgetDef
+{
+    const char* name; // Logs
+    SDL_Rect rect;    // Zone cliquable, à l'échelle 1
+    // Texture par apparence : identifiant TextureManager (celui de survol en ajoute "_hover"),
+    // fichier et fichier de survol (nullptr : même texture). id nullptr : apparence absente.
+    struct Skin
+    {
+        const char* id;
+        const char* file;
+        const char* hoverFile;
+    } skins[WIDGET_SKINS];
+};
+
+// État affiché d'un panneau, copié dans l'instantané de rendu (voir RenderSnapshot)
+struct WidgetPanelView
+{
+    static const int MAX_WIDGETS = 16;
+
+    Uint32 version = 0;     // Change à chaque modification visible : instantanés comparés sans parcours
+    int count = 0;
+    int hovered = -1;
+    bool animating = false; // Un widget n'a pas encore atteint son échelle cible
+    Uint8 skins[MAX_WIDGETS] = {};
+    float scales[MAX_WIDGETS] = {};
+
+    bool operator==(const WidgetPanelView& other) const { return version == other.version; }
+    bool operator!=(const WidgetPanelView& other) const { return !(*this == other); }
+};
+
+// Couche d'interface retenue : les boutons d'un écran sont décrits par un tableau de WidgetDef
+// au lieu d'un rectangle, d'un booléen et d'une échelle par bouton.
+// - Textures chargées en un seul LoadBatch, identifiants calculés une fois (pas de chaînes
+//   construites au rendu).
+// - Survol : grille de cases de CELL_SIZE pixels, chaque case listant les widgets qui la
+//   touchent ; un point ne teste que les widgets de sa case.
+// - Échelles, cibles et apparences dans des tableaux contigus ; Update ne parcourt que la liste
+//   des widgets en cours d'animation (vide au repos).
+// - Version incrémentée à chaque changement visible : le rendu compare les instantanés sur ce
+//   seul entier et n'invalide, sinon, que les widgets modifiés.
+// Load, SetPointer, SetSkin, Update, GetView : thread de simulation. Render, InvalidateChanges :
+// thread de rendu, ne lisent que la vue et les données figées par Load.
+class WidgetPanel
+{
+public:
+    WidgetPanel();
+
+    bool Load(const WidgetDef* defs, int count);
+    void Drop(); // Textures du panneau
+
+    // Survol du point (événement souris) ; renvoie le widget survolé, -1 si aucun
+    int SetPointer(SDL_Point point);
+    int HitTest(SDL_Point point) const;
+    void SetSkin(int widget, int skin);
+    void Update(float deltaTime);
+    WidgetPanelView GetView() const;
+
+    void Render(const WidgetPanelView& view) const;
+    void InvalidateChanges(const WidgetPanelView& previous, const WidgetPanelView& current) const;
+
+    static const float DEFAULT_SCALE;
+    static const float HOVER_SCALE;  // Facteur d'agrandissement au survol
+    static const float SCALE_SPEED;  // Par seconde
+    static const int CELL_SIZE = 64;
+
+private:
+    void Animate(int widget);
+    void InvalidateWidget(int widget) const;
+    inline const std::string& TextureId(int widget, int skin, bool hovered) const
+    {
+        return m_textureIds[(widget * WIDGET_SKINS + skin) * 2 + (hovered ? 1 : 0)];
+    }
+
+    // Figés par Load
+    std::vector<SDL_Rect> m_rects;
+    std::vector<std::string> m_textureIds; // Par widget, apparence, survol (voir TextureId)
+    SDL_Rect m_bounds;                     // Zone couverte par la grille
+    int m_columns, m_rows;
+    std::vector<int> m_cellStart;          // Case c : m_cellWidgets[m_cellStart[c], m_cellStart[c + 1])
+    std::vector<int> m_cellWidgets;
+
+    // Thread de simulation
+    std::vector<float> m_scales;
+    std::vector<float> m_targets;
+    std::vector<Uint8> m_skins;
+    std::vector<int> m_animating;
+    int m_hovered;
+    Uint32 m_version;
+};
+
+#endif // WIDGETPANEL_H
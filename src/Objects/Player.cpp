@@ -1,6 +1,7 @@
 #include "Player.h"
 #include "../Graphics/TextureManager.h"
 #include "../Core/Engine.h"
+#include "../Core/GameClock.h"
 #include <SDL.h>
 #include <cmath>
 #include <algorithm>
@@ -21,21 +22,24 @@ Player::Player() :
     m_textureId(""),
     m_width(0),
     m_height(0),
+    m_brakeHeld(false),
     m_isSlowed(false),
-    m_slowedStartTime(0),
+    m_slowedStartTime(0.0),
     m_initialMaxSpeed(380.0f)
 {}
 
-bool Player::load(std::string textureId, float startX, const std::vector<float>& laneYPositions) {
+bool Player::load(std::string textureId, int width, int height, float startX, const std::vector<float>& laneYPositions) {
     if (textureId.empty()) {
         SDL_Log("Player::load - Error: Empty texture ID provided.");
         return false;
     }
-    if (!TextureManager::GetInstance()->QueryTexture(textureId, &m_width, &m_height)) {
-        SDL_Log("Player::load - Failed to query texture ID '%s'", textureId.c_str());
+    if (width <= 0 || height <= 0) {
+        SDL_Log("Player::load - Invalid size %dx%d for texture ID '%s'", width, height, textureId.c_str());
         m_width = m_height = 0;
         return false;
     }
+    m_width = width;
+    m_height = height;
     m_textureId = textureId;
     m_initialMaxSpeed = m_maxSpeed;
     reset(startX, laneYPositions);
@@ -49,8 +53,9 @@ void Player::reset(float startX, const std::vector<float>& laneYPositions) {
      m_speed = 0.0f;
      m_laneYPositions = laneYPositions;
      m_numLanes = static_cast<int>(m_laneYPositions.size());
+     m_brakeHeld = false;
      m_isSlowed = false;
-     m_slowedStartTime = 0;
+     m_slowedStartTime = 0.0;
      m_maxSpeed = m_initialMaxSpeed;
 
      if (m_numLanes > 0) {
@@ -79,7 +84,7 @@ void Player::ApplySpeedPenalty() {
     if (!m_isSlowed) {
         SDL_Log("Applying speed penalty!");
         m_isSlowed = true;
-        m_slowedStartTime = SDL_GetTicks();
+        m_slowedStartTime = GameClock::GetInstance()->Now();
         m_speed = m_penaltySpeed;
     }
 }
@@ -95,6 +100,10 @@ SDL_Rect Player::GetCollider() const {
 
 
 void Player::handleEvent(const SDL_Event& event) {
+    if ((event.type == SDL_KEYDOWN || event.type == SDL_KEYUP) && event.key.keysym.sym == SDLK_LEFT) {
+        m_brakeHeld = event.type == SDL_KEYDOWN;
+        return;
+    }
     if (event.type == SDL_KEYDOWN && event.key.repeat == 0) {
         switch (event.key.keysym.sym) {
             case SDLK_UP:
@@ -115,16 +124,14 @@ void Player::handleEvent(const SDL_Event& event) {
 
 void Player::update(float deltaTime) {
     if (m_isSlowed) {
-        Uint32 currentTime = SDL_GetTicks();
-        if (currentTime - m_slowedStartTime >= m_penaltyDuration) {
+        if (GameClock::GetInstance()->Since(m_slowedStartTime) >= m_penaltyDuration) {
             SDL_Log("Speed penalty ended.");
             m_isSlowed = false;
         }
     }
 
     if (!m_isSlowed) {
-        const Uint8* keyState = SDL_GetKeyboardState(NULL);
-        bool braking = keyState[SDL_SCANCODE_LEFT];
+        bool braking = m_brakeHeld;
 
         if (braking) {
             m_speed -= m_braking * deltaTime;
@@ -165,12 +172,10 @@ void Player::update(float deltaTime) {
     }
 }
 
-void Player::draw() {
-    if (m_width > 0 && m_height > 0 && !m_textureId.empty()) {
-        int drawX = static_cast<int>(m_x - m_width / 2.0f);
-        int drawY = static_cast<int>(m_currentY - m_height / 2.0f);
-        TextureManager::GetInstance()->Draw(m_textureId, drawX, drawY, m_width, m_height);
-    }
+SDL_Rect Player::GetDrawRect() const {
+    int drawX = static_cast<int>(m_x - m_width / 2.0f);
+    int drawY = static_cast<int>(m_currentY - m_height / 2.0f);
+    return { drawX, drawY, m_width, m_height };
 }
 
 float Player::getSpeed() const {
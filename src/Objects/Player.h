@@ -9,11 +9,18 @@ class Player {
 public:
     Player();
 
-    bool load(std::string textureId, float startX, const std::vector<float>& laneYPositions);
+    // Taille de la texture fournie par l'appelant (TexturePreloader) : chargeable hors du thread de rendu
+    bool load(std::string textureId, int width, int height, float startX, const std::vector<float>& laneYPositions);
     void handleEvent(const SDL_Event& event);
     void update(float deltaTime);
-    void draw();
+    // Rectangle d'affichage (centré sur la position) et texture, copiés dans l'instantané de rendu
+    SDL_Rect GetDrawRect() const;
+    inline const std::string& GetTextureId() const { return m_textureId; }
+    // Texture rechargée avec une autre taille (voir AssetWatcher)
+    inline void SetSize(int width, int height) { m_width = width; m_height = height; }
+    inline bool IsDrawable() const { return m_width > 0 && m_height > 0 && !m_textureId.empty(); }
     float getSpeed() const;
+    inline bool IsBraking() const { return m_brakeHeld; }
     void reset(float startX, const std::vector<float>& laneYPositions);
     void ApplySpeedPenalty();
     SDL_Rect GetCollider() const;
@@ -39,10 +46,11 @@ private:
     int m_width;
     int m_height;
 
+    bool m_brakeHeld; // Flèche gauche, suivie par événements (horodatés, voir LatencyTracker)
     bool m_isSlowed;
-    Uint32 m_slowedStartTime;
+    double m_slowedStartTime; // Instant GameClock
     const float m_penaltySpeed = 50.0f;
-    const Uint32 m_penaltyDuration = 2500;
+    const double m_penaltyDuration = 2.5;
 
     float m_initialMaxSpeed;
 
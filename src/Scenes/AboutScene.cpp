@@ -0,0 +1,41 @@
+#include "AboutScene.h"
+#include "../Audio/AudioManager.h"
+#include "../Core/Engine.h"
+#include "../Graphics/TextureManager.h"
+
+TextureList AboutScene::GetResources() const {
+    TextureList textures;
+    textures.push_back({ "about_screen", "assets/Menu/about_background.png" });
+    return textures;
+}
+
+void AboutScene::OnEnter(GameState previous) {
+    // Si on vient du jeu, arrêter la musique du jeu et jouer celle du menu
+    if (previous == STATE_PLAYING || previous == STATE_START_SCREEN) {
+        AudioManager::GetInstance()->StopMusic();
+        AudioManager::GetInstance()->PlayMusic("menu_music", -1);
+    } else if (!AudioManager::GetInstance()->IsMusicPlaying()) { // Si on vient d'un autre état (ex: menu principal) et que rien ne joue
+        AudioManager::GetInstance()->PlayMusic("menu_music", -1);
+    }
+}
+
+void AboutScene::HandleEvent(SDL_Event& event) {
+    if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_ESCAPE) {
+        SDL_Log("AboutScene::HandleEvent - Echap appuye, retour au menu principal.");
+        Engine::GetInstance()->PopScene();
+    }
+}
+
+void AboutScene::Render(const RenderSnapshot& /*snapshot*/) {
+    Engine* engine = Engine::GetInstance();
+    engine->FillScreen(20, 20, 50);
+    if (TextureManager::GetInstance()->QueryTexture("about_screen", nullptr, nullptr)) {
+        TextureManager::GetInstance()->Draw("about_screen", 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+    } else {
+        SDL_Log("AboutScene::Render - Texture 'about_screen' non trouvee.");
+    }
+    if (TextureManager::GetInstance()->IsTextureLoaded(RETURN_PROMPT_TEXTURE)) {
+        const SDL_Rect& prompt = engine->m_aboutPromptRect;
+        TextureManager::GetInstance()->Draw(RETURN_PROMPT_TEXTURE, prompt.x, prompt.y, prompt.w, prompt.h);
+    }
+}
@@ -0,0 +1,22 @@
+#ifndef ABOUTSCENE_H
+#define ABOUTSCENE_H
+
+#include "Scene.h"
+
+// Écran "à propos", empilé sur le menu principal et retiré avec Echap.
+class AboutScene : public Scene
+{
+public:
+    GameState GetState() const override { return STATE_ABOUT; }
+    const char* GetName() const override { return "about"; }
+    TextureList GetResources() const override;
+    std::vector<GameState> GetLikelyNext() const override { return { STATE_MAIN_MENU }; }
+
+    void OnEnter(GameState previous) override;
+    void HandleEvent(SDL_Event& event) override;
+
+    bool IsStatic(const ScreenView& /*screen*/) const override { return true; }
+    void Render(const RenderSnapshot& snapshot) override;
+};
+
+#endif // ABOUTSCENE_H
@@ -0,0 +1,72 @@
+#include "EndScene.h"
+#include "../Audio/AudioManager.h"
+#include "../Core/Engine.h"
+#include "../Graphics/TextureManager.h"
+
+TextureList EndScene::GetResources() const {
+    if (m_state == STATE_WIN) {
+        TextureList textures;
+        textures.push_back({ "win", "assets/win.png" });
+        return textures;
+    }
+    TextureList textures = Engine::GetInstance()->GetRunTextures();
+    textures.push_back({ "gameover", "assets/game_over.png" });
+    return textures;
+}
+
+void EndScene::OnEnter(GameState /*previous*/) {
+    Engine* engine = Engine::GetInstance();
+    AudioManager::GetInstance()->StopMusic();
+    AudioManager::GetInstance()->PrefetchMusic("menu_music"); // Début décodé pendant l'écran de fin
+    if (m_state == STATE_GAME_OVER) {
+        AudioManager::GetInstance()->PlaySound("lose", 0);
+        engine->m_timeline.After(engine->GAME_OVER_SCREEN_DELAY, [engine] {
+            SDL_Log("EndScene - Affichage de l'ecran Game Over.");
+            engine->m_showGameOverScreen = true;
+            // Le message "Retour" suit l'écran, au plus tôt RETURN_PROMPT_DELAY après la défaite
+            engine->m_timeline.After(engine->RETURN_PROMPT_DELAY - engine->GAME_OVER_SCREEN_DELAY, [engine] { engine->m_showReturnPrompt = true; });
+        });
+    } else {
+        AudioManager::GetInstance()->PlaySound("win", 0);
+        engine->m_timeline.After(engine->RETURN_PROMPT_DELAY, [engine] { engine->m_showReturnPrompt = true; });
+    }
+    SDL_Log("EndScene::OnEnter - Passage a STATE_%s.", m_state == STATE_WIN ? "WIN" : "GAME_OVER");
+}
+
+void EndScene::HandleEvent(SDL_Event& event) {
+    if (event.type != SDL_KEYDOWN) return;
+    SDL_Keycode key = event.key.keysym.sym;
+    if (key == SDLK_r || key == SDLK_RETURN || key == SDLK_SPACE) {
+        SDL_Log("EndScene::HandleEvent - Touche 'R' (ou Entree/Espace) appuyee, redemarrage.");
+        Engine::GetInstance()->SetGameState(STATE_START_SCREEN);
+    } else if (key == SDLK_ESCAPE) {
+        SDL_Log("EndScene::HandleEvent - Echap appuye, retour au menu principal.");
+        Engine::GetInstance()->SetGameState(STATE_MAIN_MENU);
+    }
+}
+
+bool EndScene::IsStatic(const ScreenView& screen) const {
+    return m_state == STATE_WIN || screen.showGameOverScreen;
+}
+
+void EndScene::Render(const RenderSnapshot& snapshot) {
+    Engine* engine = Engine::GetInstance();
+    if (!IsStatic(snapshot.screen)) {
+        engine->RenderScene(snapshot); // Scène figée avant l'écran Game Over
+        return;
+    }
+
+    const char* textureId = m_state == STATE_WIN ? "win" : "gameover";
+    if (m_state == STATE_WIN) engine->FillScreen(100, 180, 255);
+    else engine->FillScreen(0, 0, 0);
+    int imgW = 0, imgH = 0;
+    if (TextureManager::GetInstance()->QueryTexture(textureId, &imgW, &imgH)) {
+        TextureManager::GetInstance()->Draw(textureId, (SCREEN_WIDTH - imgW) / 2, (SCREEN_HEIGHT - imgH) / 2, imgW, imgH);
+    } else {
+        SDL_Log("EndScene::Render - Attention: Texture '%s' introuvable.", textureId);
+    }
+    if (snapshot.screen.showReturnPrompt && TextureManager::GetInstance()->IsTextureLoaded(RETURN_PROMPT_TEXTURE)) {
+        const SDL_Rect& prompt = engine->m_returnPromptRect;
+        TextureManager::GetInstance()->Draw(RETURN_PROMPT_TEXTURE, prompt.x, prompt.y, prompt.w, prompt.h);
+    }
+}
@@ -0,0 +1,28 @@
+#ifndef ENDSCENE_H
+#define ENDSCENE_H
+
+#include "Scene.h"
+
+// Fin de course, STATE_GAME_OVER ou STATE_WIN : écran fixe et message "Retour" programmés sur
+// la Timeline. Le game over montre d'abord la scène figée, d'où les textures de la course.
+class EndScene : public Scene
+{
+public:
+    explicit EndScene(GameState state) : m_state(state) {}
+
+    GameState GetState() const override { return m_state; }
+    const char* GetName() const override { return m_state == STATE_WIN ? "win" : "game_over"; }
+    TextureList GetResources() const override;
+    std::vector<GameState> GetLikelyNext() const override { return { STATE_START_SCREEN, STATE_MAIN_MENU }; }
+
+    void OnEnter(GameState previous) override;
+    void HandleEvent(SDL_Event& event) override;
+
+    bool IsStatic(const ScreenView& screen) const override;
+    void Render(const RenderSnapshot& snapshot) override;
+
+private:
+    const GameState m_state;
+};
+
+#endif // ENDSCENE_H
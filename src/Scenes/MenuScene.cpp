@@ -0,0 +1,38 @@
+#include "MenuScene.h"
+#include "../Audio/AudioManager.h"
+#include "../Core/Engine.h"
+#include "../Menu/MainMenu.h"
+
+void MenuScene::OnEnter(GameState previous) {
+    if (previous == STATE_GAME_OVER || previous == STATE_WIN || previous == STATE_PLAYING || previous == STATE_START_SCREEN) {
+        AudioManager::GetInstance()->StopMusic(); // S'assurer que la musique du jeu est arrêtée
+        AudioManager::GetInstance()->PlayMusic("menu_music", -1); // Puis jouer celle du menu
+        Engine* engine = Engine::GetInstance();
+        engine->SelectLevel(engine->GetConfig().startLevel); // La campagne reprend au premier niveau
+        engine->ResetRun();
+    } else if (!AudioManager::GetInstance()->IsMusicPlaying()) {
+        AudioManager::GetInstance()->PlayMusic("menu_music", -1);
+    }
+}
+
+void MenuScene::OnResume(GameState /*covering*/) {
+    if (!AudioManager::GetInstance()->IsMusicPlaying()) AudioManager::GetInstance()->PlayMusic("menu_music", -1);
+}
+
+void MenuScene::HandleEvent(SDL_Event& event) {
+    MainMenu::GetInstance()->HandleEvent(event);
+}
+
+void MenuScene::Update(float deltaTime) {
+    MainMenu::GetInstance()->Update(deltaTime);
+    AudioManager::GetInstance()->ApplyPendingBuffer(); // Menu au repos : seule la musique joue
+}
+
+bool MenuScene::IsAnimating(const ScreenView& screen) const {
+    return MainMenu::GetInstance()->IsAnimating(screen.menu);
+}
+
+void MenuScene::Render(const RenderSnapshot& snapshot) {
+    Engine::GetInstance()->FillScreen(0, 0, 0);
+    MainMenu::GetInstance()->Render(snapshot.screen.menu);
+}
@@ -0,0 +1,26 @@
+#ifndef MENUSCENE_H
+#define MENUSCENE_H
+
+#include "Scene.h"
+
+// Menu principal : délègue à MainMenu, dont les textures sont chargées au lancement.
+// Pendant qu'il tourne, les textures de la course, du premier niveau et de l'écran "à propos"
+// se préchargent.
+class MenuScene : public Scene
+{
+public:
+    GameState GetState() const override { return STATE_MAIN_MENU; }
+    const char* GetName() const override { return "main_menu"; }
+    std::vector<GameState> GetLikelyNext() const override { return { STATE_START_SCREEN, STATE_ABOUT }; }
+
+    void OnEnter(GameState previous) override;
+    void OnResume(GameState covering) override;
+    void HandleEvent(SDL_Event& event) override;
+    void Update(float deltaTime) override;
+
+    bool IsStatic(const ScreenView& /*screen*/) const override { return true; }
+    bool IsAnimating(const ScreenView& screen) const override;
+    void Render(const RenderSnapshot& snapshot) override;
+};
+
+#endif // MENUSCENE_H
@@ -0,0 +1,45 @@
+#include "PlayingScene.h"
+#include "../Audio/AudioManager.h"
+#include "../Core/Engine.h"
+#include "../Objects/Player.h"
+
+TextureList PlayingScene::GetResources() const {
+    return Engine::GetInstance()->GetRunTextures(); // Mêmes textures que l'écran de départ
+}
+
+bool PlayingScene::IsReady() {
+    return Engine::GetInstance()->IsLevelReady();
+}
+
+void PlayingScene::OnEnter(GameState /*previous*/) {
+    Engine* engine = Engine::GetInstance();
+    AudioManager::GetInstance()->StopMusic(); // S'assurer que toute musique précédente est arrêtée
+    AudioManager::GetInstance()->PlayMusic("game_music", -1);
+    AudioManager::GetInstance()->StartEngineSound();
+    engine->m_lastCountdownSecondPlayed = -1;
+    engine->StartPlayingTimers();
+    SDL_Log("PlayingScene::OnEnter - Passage a STATE_PLAYING, musique de jeu lancee.");
+}
+
+void PlayingScene::OnExit(GameState /*next*/) {
+    AudioManager::GetInstance()->StopEngineSound();
+}
+
+void PlayingScene::HandleEvent(SDL_Event& event) {
+    Engine* engine = Engine::GetInstance();
+    if (engine->m_Player && (event.type == SDL_KEYDOWN || event.type == SDL_KEYUP) && event.key.repeat == 0) {
+        engine->m_Player->handleEvent(event);
+    }
+    if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_ESCAPE) {
+        SDL_Log("PlayingScene::HandleEvent - Echap appuye, retour au menu principal.");
+        engine->SetGameState(STATE_MAIN_MENU);
+    }
+}
+
+void PlayingScene::Update(float deltaTime) {
+    Engine::GetInstance()->UpdateRun(deltaTime);
+}
+
+void PlayingScene::Render(const RenderSnapshot& snapshot) {
+    Engine::GetInstance()->RenderScene(snapshot);
+}
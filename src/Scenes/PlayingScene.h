@@ -0,0 +1,23 @@
+#ifndef PLAYINGSCENE_H
+#define PLAYINGSCENE_H
+
+#include "Scene.h"
+
+// Course : joueur, obstacles, compte à rebours (minuteurs de la Timeline du moteur).
+class PlayingScene : public Scene
+{
+public:
+    GameState GetState() const override { return STATE_PLAYING; }
+    const char* GetName() const override { return "playing"; }
+    TextureList GetResources() const override;
+    std::vector<GameState> GetLikelyNext() const override { return { STATE_GAME_OVER, STATE_WIN, STATE_MAIN_MENU }; }
+
+    bool IsReady() override;
+    void OnEnter(GameState previous) override;
+    void OnExit(GameState next) override;
+    void HandleEvent(SDL_Event& event) override;
+    void Update(float deltaTime) override;
+    void Render(const RenderSnapshot& snapshot) override;
+};
+
+#endif // PLAYINGSCENE_H
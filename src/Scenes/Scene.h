@@ -0,0 +1,41 @@
+#ifndef SCENE_H
+#define SCENE_H
+
+#include <vector>
+#include "SDL.h"
+#include "../Core/RenderSnapshot.h"
+#include "../Graphics/TexturePreloader.h"
+
+// Un état du jeu (menu, départ, course, écrans de fin...) géré par SceneStack.
+// Chaque scène déclare ses textures : elles sont préchargées pendant que la scène précédente
+// tourne, et on n'entre dans la scène qu'une fois toutes créées.
+// OnEnter/OnExit/OnResume/HandleEvent/Update : thread de simulation.
+// IsStatic/IsAnimating/Render : thread de rendu, à partir de l'instantané seulement.
+class Scene
+{
+public:
+    virtual ~Scene() {}
+
+    virtual GameState GetState() const = 0;
+    virtual const char* GetName() const = 0; // Aussi le nom de son groupe de préchargement
+    virtual TextureList GetResources() const { return TextureList(); }
+    // Scènes atteignables depuis celle-ci : leur préchargement démarre dès l'entrée
+    virtual std::vector<GameState> GetLikelyNext() const { return std::vector<GameState>(); }
+
+    // Condition d'entrée en plus de ses textures (ex: niveau courant chargé), vérifiée avant la transition
+    virtual bool IsReady() { return true; }
+
+    virtual void OnEnter(GameState /*previous*/) {}
+    virtual void OnExit(GameState /*next*/) {}
+    virtual void OnResume(GameState /*covering*/) {} // La scène empilée par-dessus vient d'être retirée
+    virtual void HandleEvent(SDL_Event& /*event*/) {}
+    virtual void Update(float /*deltaTime*/) {}
+
+    // Écran fixe : composé dans le calque LAYER_SCREEN et présenté seulement s'il change
+    virtual bool IsStatic(const ScreenView& /*screen*/) const { return false; }
+    // Écran fixe qui change encore sans événement (animation du menu)
+    virtual bool IsAnimating(const ScreenView& /*screen*/) const { return false; }
+    virtual void Render(const RenderSnapshot& snapshot) = 0;
+};
+
+#endif // SCENE_H
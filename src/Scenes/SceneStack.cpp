@@ -0,0 +1,127 @@
+#include "SceneStack.h"
+
+void SceneStack::Register(std::unique_ptr<Scene> scene) {
+    GameState state = scene->GetState();
+    m_scenes[state] = std::move(scene);
+}
+
+Scene* SceneStack::Get(GameState state) const {
+    auto it = m_scenes.find(state);
+    return it != m_scenes.end() ? it->second.get() : nullptr;
+}
+
+void SceneStack::Change(GameState state) {
+    Scene* active = GetActive();
+    if (active != nullptr && active->GetState() == state && m_stack.size() == 1) {
+        m_pending = Transition(); // Déjà dans cette scène : annule une demande plus ancienne
+        return;
+    }
+    Request(OP_CHANGE, state);
+}
+
+void SceneStack::Push(GameState state) {
+    Request(OP_PUSH, state);
+}
+
+void SceneStack::Pop() {
+    if (m_stack.size() < 2) {
+        SDL_Log("SceneStack::Pop - Attention: aucune scene sous la scene active.");
+        return;
+    }
+    Request(OP_POP, m_stack[m_stack.size() - 2]->GetState());
+}
+
+void SceneStack::Update() {
+    if (IsTransitionPending()) TryCommit();
+}
+
+void SceneStack::PreloadAll() {
+    TexturePreloader* preloader = TexturePreloader::GetInstance();
+    for (const auto& entry : m_scenes) {
+        if (preloader->LoadNow(entry.second->GetName(), entry.second->GetResources()) == TexturePreloader::GROUP_FAILED) {
+            SDL_Log("SceneStack::PreloadAll - Attention: textures de '%s' incompletes.", entry.second->GetName());
+        }
+    }
+}
+
+void SceneStack::Clean() {
+    m_stack.clear();
+    m_pending = Transition();
+    m_scenes.clear();
+}
+
+void SceneStack::Request(Operation operation, GameState target) {
+    if (Get(target) == nullptr) {
+        SDL_Log("SceneStack::Request - ERREUR: aucune scene pour l'etat %d.", target);
+        return;
+    }
+    m_pending.operation = operation;
+    m_pending.target = target;
+    // Textures en échec à la demande précédente (échec peut-être passager) : nouvelle tentative,
+    // une seule par transition demandée
+    TexturePreloader* preloader = TexturePreloader::GetInstance();
+    Scene* scene = Get(target);
+    if (preloader->GetState(scene->GetName()) == TexturePreloader::GROUP_FAILED) {
+        preloader->Request(scene->GetName(), scene->GetResources());
+    }
+    if (m_committing) return;
+    TryCommit();
+    if (IsTransitionPending()) {
+        SDL_Log("SceneStack::Request - Transition vers '%s' en attente du prechargement.", Get(target)->GetName());
+    }
+}
+
+void SceneStack::TryCommit() {
+    Scene* target = Get(m_pending.target);
+    TexturePreloader* preloader = TexturePreloader::GetInstance();
+    TexturePreloader::GroupState state = preloader->GetState(target->GetName());
+    if (state == TexturePreloader::GROUP_UNKNOWN) {
+        preloader->Request(target->GetName(), target->GetResources()); // Pas anticipé : chargé maintenant
+        state = preloader->GetState(target->GetName());
+    }
+    if (state == TexturePreloader::GROUP_LOADING) return;
+    if (state == TexturePreloader::GROUP_FAILED) {
+        SDL_Log("SceneStack::TryCommit - ECHEC: textures de '%s' manquantes, transition annulee.", target->GetName());
+        m_pending = Transition();
+        return;
+    }
+    if (!target->IsReady()) return;
+
+    Transition transition = m_pending;
+    m_pending = Transition();
+    m_committing = true;
+    Commit(transition, target);
+    m_committing = false;
+    PreloadLikelyNext();
+}
+
+void SceneStack::Commit(const Transition& transition, Scene* target) {
+    Scene* active = GetActive();
+    GameState previous = active != nullptr ? active->GetState() : target->GetState();
+
+    if (transition.operation == OP_POP) {
+        active->OnExit(target->GetState());
+        m_stack.pop_back();
+        if (m_onTransition) m_onTransition(previous, target->GetState());
+        target->OnResume(previous);
+        return;
+    }
+
+    if (transition.operation == OP_CHANGE) {
+        for (auto it = m_stack.rbegin(); it != m_stack.rend(); ++it) (*it)->OnExit(target->GetState());
+        m_stack.clear();
+    }
+    m_stack.push_back(target);
+    if (m_onTransition) m_onTransition(previous, target->GetState());
+    target->OnEnter(previous);
+}
+
+void SceneStack::PreloadLikelyNext() {
+    TexturePreloader* preloader = TexturePreloader::GetInstance();
+    for (GameState state : GetActive()->GetLikelyNext()) {
+        Scene* next = Get(state);
+        if (next != nullptr && preloader->GetState(next->GetName()) == TexturePreloader::GROUP_UNKNOWN) {
+            preloader->Request(next->GetName(), next->GetResources());
+        }
+    }
+}
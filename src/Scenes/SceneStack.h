@@ -0,0 +1,58 @@
+#ifndef SCENESTACK_H
+#define SCENESTACK_H
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+#include "Scene.h"
+
+// Pile des scènes actives (la dernière reçoit les événements et les mises à jour) et
+// transitions différées : une transition demandée n'est appliquée qu'une fois le groupe de
+// préchargement de la scène visée prêt, pour que sa première image ne charge rien.
+// Les transitions sont demandées et appliquées sur le thread de simulation ; Get() peut être
+// appelé de n'importe quel thread, la table des scènes ne changeant plus après Init.
+class SceneStack
+{
+public:
+    // Appelé à chaque transition, avant OnEnter/OnResume de la nouvelle scène active
+    typedef std::function<void(GameState previous, GameState next)> TransitionFn;
+
+    void Register(std::unique_ptr<Scene> scene);
+    inline void SetTransitionHook(TransitionFn hook) { m_onTransition = std::move(hook); }
+    Scene* Get(GameState state) const;
+    inline Scene* GetActive() const { return m_stack.empty() ? nullptr : m_stack.back(); }
+
+    // Appliquées tout de suite si les textures de la scène visée sont prêtes, sinon par Update()
+    // dès qu'elles le sont. Une nouvelle demande remplace celle en attente.
+    void Change(GameState state); // Remplace toute la pile
+    void Push(GameState state);   // Par-dessus la scène active, qui reste en mémoire
+    void Pop();
+    void Update();
+    inline bool IsTransitionPending() const { return m_pending.operation != OP_NONE; }
+
+    // Précharge toutes les scènes et attend (thread de rendu : --golden, images reproductibles)
+    void PreloadAll();
+    void Clean();
+
+private:
+    enum Operation { OP_NONE, OP_CHANGE, OP_PUSH, OP_POP };
+    struct Transition
+    {
+        Operation operation = OP_NONE;
+        GameState target = STATE_MAIN_MENU;
+    };
+
+    void Request(Operation operation, GameState target);
+    void TryCommit();
+    void Commit(const Transition& transition, Scene* target);
+    void PreloadLikelyNext();
+
+    std::map<GameState, std::unique_ptr<Scene>> m_scenes;
+    std::vector<Scene*> m_stack;
+    Transition m_pending;
+    bool m_committing = false; // Une transition demandée pendant OnEnter/OnExit attend Update()
+    TransitionFn m_onTransition;
+};
+
+#endif // SCENESTACK_H
@@ -0,0 +1,40 @@
+#include "StartScene.h"
+#include "../Audio/AudioManager.h"
+#include "../Core/Engine.h"
+
+TextureList StartScene::GetResources() const {
+    return Engine::GetInstance()->GetRunTextures();
+}
+
+bool StartScene::IsReady() {
+    return Engine::GetInstance()->IsLevelReady(); // Textures du niveau en plus de celles de la course
+}
+
+void StartScene::OnEnter(GameState /*previous*/) {
+    Engine* engine = Engine::GetInstance();
+    AudioManager::GetInstance()->StopMusic();
+    AudioManager::GetInstance()->PrefetchMusic("game_music"); // Début décodé pendant l'écran de départ
+    if (!engine->PrepareRunAssets() || !engine->PrepareLevel()) {
+        SDL_Log("StartScene::OnEnter - ERREUR CRITIQUE: joueur ou obstacles indisponibles, fermeture.");
+        engine->Quit();
+        return;
+    }
+    engine->ResetRun();
+    SDL_Log("StartScene::OnEnter - Etat du jeu reinitialise pour STATE_START_SCREEN.");
+}
+
+void StartScene::HandleEvent(SDL_Event& event) {
+    if (event.type != SDL_KEYDOWN) return;
+    SDL_Keycode key = event.key.keysym.sym;
+    if (key == SDLK_RIGHT || key == SDLK_SPACE || key == SDLK_RETURN) {
+        SDL_Log("StartScene::HandleEvent - Touche de demarrage appuyee, passage a STATE_PLAYING.");
+        Engine::GetInstance()->SetGameState(STATE_PLAYING);
+    } else if (key == SDLK_ESCAPE) {
+        SDL_Log("StartScene::HandleEvent - Echap appuye, retour au menu principal.");
+        Engine::GetInstance()->SetGameState(STATE_MAIN_MENU);
+    }
+}
+
+void StartScene::Render(const RenderSnapshot& snapshot) {
+    Engine::GetInstance()->RenderScene(snapshot);
+}
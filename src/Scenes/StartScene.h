@@ -0,0 +1,23 @@
+#ifndef STARTSCENE_H
+#define STARTSCENE_H
+
+#include "Scene.h"
+
+// Écran de départ : piste et joueur à l'arrêt jusqu'à la touche de démarrage. Il déclare les
+// textures de la course et attend celles du niveau courant : la première image de STATE_PLAYING
+// les trouve toutes chargées et ses calques déjà composés.
+class StartScene : public Scene
+{
+public:
+    GameState GetState() const override { return STATE_START_SCREEN; }
+    const char* GetName() const override { return "start_screen"; }
+    TextureList GetResources() const override;
+    std::vector<GameState> GetLikelyNext() const override { return { STATE_PLAYING, STATE_MAIN_MENU }; }
+
+    bool IsReady() override;
+    void OnEnter(GameState previous) override;
+    void HandleEvent(SDL_Event& event) override;
+    void Render(const RenderSnapshot& snapshot) override;
+};
+
+#endif // STARTSCENE_H
@@ -0,0 +1,96 @@
+// Générateur pour le build "binaire unique" (voir src/Core/AssetPack.h).
+// Parcourt le dossier d'assets hors ligne et écrit un fichier assembleur qui inclut
+// chaque fichier tel quel (.incbin) en lecture seule, suivi d'une table triée
+// { chemin, données, taille } lue par AssetPack. Le .S est ensuite assemblé en .o
+// et lié avec le jeu.
+//
+// Usage : AssetEmbedder <dossier_assets> <sortie.S> [--exclude <prefixe>]...
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+static bool IsEmbeddable(const fs::path& file) {
+    std::string ext = file.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return ext == ".png" || ext == ".jpg" || ext == ".wav" || ext == ".ogg" || ext == ".ttf" ||
+           ext == ".txt" || ext == ".lvl"; // Campagne (voir Campaign)
+}
+
+static bool IsExcluded(const std::string& path, const std::vector<std::string>& excludes) {
+    for (const auto& prefix : excludes) {
+        if (path.compare(0, prefix.size(), prefix) == 0) return true;
+    }
+    return false;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::fprintf(stderr, "Usage: %s <dossier_assets> <sortie.S> [--exclude <prefixe>]...\n", argv[0]);
+        return 1;
+    }
+    const fs::path root = argv[1];
+    const std::string output = argv[2];
+    std::vector<std::string> excludes;
+    for (int i = 3; i + 1 < argc; i += 2) {
+        if (std::string(argv[i]) == "--exclude") excludes.push_back(fs::path(argv[i + 1]).generic_string());
+    }
+
+    std::error_code ec;
+    if (!fs::is_directory(root, ec)) {
+        std::fprintf(stderr, "AssetEmbedder - ECHEC: '%s' n'est pas un dossier\n", root.string().c_str());
+        return 1;
+    }
+
+    struct Entry { std::string path; unsigned long long size; };
+    std::vector<Entry> entries;
+    for (const auto& item : fs::recursive_directory_iterator(root)) {
+        if (!item.is_regular_file() || !IsEmbeddable(item.path())) continue;
+        // Le jeu référence les assets par chemin relatif au dossier de travail ("assets/Menu/...").
+        std::string path = item.path().generic_string();
+        if (IsExcluded(path, excludes)) continue;
+        entries.push_back({ path, static_cast<unsigned long long>(item.file_size()) });
+    }
+    // AssetPack cherche par dichotomie avec strcmp : même ordre octet par octet ici.
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.path < b.path; });
+
+    std::ofstream out(output, std::ios::trunc);
+    if (!out) {
+        std::fprintf(stderr, "AssetEmbedder - ECHEC: impossible d'ecrire '%s'\n", output.c_str());
+        return 1;
+    }
+
+    out << "/* Fichier genere par tools/AssetEmbedder.cpp - ne pas modifier. */\n";
+    out << "#if defined(_WIN32)\n    .section .rdata,\"dr\"\n#else\n    .section .rodata\n#endif\n";
+    for (size_t i = 0; i < entries.size(); ++i) {
+        out << "    .balign 16\n";
+        out << "game_asset_data_" << i << ":\n";
+        out << "    .incbin \"" << entries[i].path << "\"\n";
+        out << "game_asset_path_" << i << ":\n";
+        out << "    .asciz \"" << entries[i].path << "\"\n";
+    }
+
+    // La table contient des pointeurs absolus : en ELF elle va dans .data.rel.ro pour rester compatible PIE.
+    out << "#if defined(_WIN32)\n    .section .rdata,\"dr\"\n#else\n    .section .data.rel.ro,\"aw\"\n#endif\n";
+    out << "    .balign 8\n";
+    out << "    .globl g_EmbeddedAssets\n";
+    out << "g_EmbeddedAssets:\n";
+    for (size_t i = 0; i < entries.size(); ++i) {
+        out << "    .quad game_asset_path_" << i << ", game_asset_data_" << i << ", " << entries[i].size << "\n";
+    }
+    out << "    .globl g_EmbeddedAssetCount\n";
+    out << "g_EmbeddedAssetCount:\n";
+    out << "    .quad " << entries.size() << "\n";
+    out << "#if defined(__ELF__)\n    .section .note.GNU-stack,\"\",@progbits\n#endif\n";
+
+    unsigned long long total = 0;
+    for (const auto& e : entries) total += e.size;
+    std::printf("AssetEmbedder - %zu assets (%llu octets) ecrits dans %s\n", entries.size(), total, output.c_str());
+    return 0;
+}